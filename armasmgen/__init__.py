@@ -18,11 +18,13 @@ armasmgen ── AArch64 (Arm v8-A) assembly generator DSL.
 """
 
 from .core import Instruction, BaseAsm, RegArg
-from .builder import ASMCode, Block, DataBlock, BackgroundCode
+from .builder import ASMCode, Block, DataBlock, BackgroundCode, Loop, PredicatedLoop, ColdBlock
+from .machine import MachineModel, OpTiming
 from .register import (
     Register, RegisterType, RegisterWidth, RegisterPool,
     AArch64RegisterPools, aarch64_pools,
-    x_reg, w_reg, v_reg, q_reg, d_reg, virtual_x, virtual_v
+    x_reg, w_reg, v_reg, q_reg, d_reg, z_reg, p_reg, virtual_x, virtual_v, VReg, VElem,
+    ZReg, ZElem, PReg
 )
 
 # Import mixins for direct access
@@ -45,6 +47,11 @@ __all__ = [
     "Block",
     "DataBlock",
     "BackgroundCode",
+    "Loop",
+    "PredicatedLoop",
+    "ColdBlock",
+    "MachineModel",
+    "OpTiming",
     "AsmFunc",
     "RegArg",
     # Register system
@@ -59,8 +66,15 @@ __all__ = [
     "v_reg",
     "q_reg",
     "d_reg",
+    "z_reg",
+    "p_reg",
     "virtual_x",
     "virtual_v",
+    "VReg",
+    "VElem",
+    "ZReg",
+    "ZElem",
+    "PReg",
     # Mixins
     "ArithmeticMixin",
     "MemoryMixin", 
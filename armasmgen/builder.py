@@ -1,7 +1,15 @@
 # armasmgen/builder.py
 from contextvars import ContextVar
+from typing import List, Optional, Union
 from .core import BaseAsm, Instruction
-from .mixins import arithmetic, memory, logic, control, vector_arithmetic
+from .mixins import arithmetic, memory, logic, control, vector_arithmetic, simd, sve
+from .passes.analysis import canonical, defs, uses
+from .passes.unroll import unroll_body
+from .passes.modulo import ModuloSchedule
+from .passes.prefetch import PrefetchPolicy, insert_prefetches, line_period
+from .passes.fusion import fuse_pairs
+from .passes.renaming import rename_registers, DEFAULT_POOL
+from .layout import AlignPolicy, UNLIKELY, section_directive
 
 _current: ContextVar["Block"] = ContextVar("_current")
 
@@ -10,11 +18,15 @@ class Block(BaseAsm,
             memory.MemoryMixin,
             logic.LogicMixin,
             control.ControlFlowMixin,
-            vector_arithmetic.VectorArithmeticMixin):
-    def __init__(self, label: str | None = None):
+            vector_arithmetic.VectorArithmeticMixin,
+            simd.SIMDMixin,
+            sve.SVEMixin):
+    def __init__(self, label: Optional[str] = None):
         super().__init__()
         self.label = label
         self.depth = _current.get().depth + 1 if _current.get(None) else 0
+        # 對齊策略由外層區塊繼承
+        self.align_policy: Optional[AlignPolicy] = getattr(_current.get(None), "align_policy", None)
 
     # ---------- context ----------
     def __enter__(self):
@@ -30,6 +42,13 @@ class Block(BaseAsm,
             ))
         return self
     
+    def directive(self, text: str):
+        self.emit(Instruction(
+            template=text,
+            dsts=[], srcs=[], kwargs={},
+            depth=self.depth, block=self.label
+        ))
+
     def emitline(self):
         self.emit(Instruction(
             template="",
@@ -47,16 +66,50 @@ class Block(BaseAsm,
             parent._inst.extend(self._inst)
         # 如果 parent 為 None → 代表這是 ASMCode，本身已在頂層
 
+
+def record(emit) -> List[Instruction]:
+    """
+    Instructions emit(block) appends to a scratch block, kept out of the
+    enclosing one: a loop body to analyse, schedule or replicate first.
+
+        body = record(lambda s: s.LDR_post("x4", "x1", 8))
+    """
+    with Block() as s:
+        emit(s)
+        body, s._inst = s._inst, []
+    return body
+
 # --------------------------------------------------------------------
 class ASMCode(Block):
-    def __init__(self, label: str | None = None):
+    """
+    align   : AlignPolicy for the function entry and the loops inside it
+    section : emit the function into this section (e.g. layout.HOT), ELF only
+    fusion  : MachineModel; keep its fusible pairs adjacent (moving independent
+              instructions out of the way) and leave the count of kept /
+              broken pairs in self.fusion_report and as a comment
+    rename  : True (caller-saved pool) or a list of registers; move temporaries
+              to free registers to remove WAR/WAW hazards, see passes/renaming.py.
+              The count removed is left in self.rename_report and as a comment
+    """
+
+    def __init__(self, label: Optional[str] = None, *, align: Optional[AlignPolicy] = None,
+                 section: Optional[str] = None, fusion=None, rename=None):
         super().__init__(label=label)
+        if align is not None:
+            self.align_policy = align
+        self.section = section
+        self.fusion = fusion
+        self.fusion_report = None
+        self.rename = rename
+        self.rename_report = None
 
     # ---------- context ----------
     def __enter__(self):
         # 進入區塊前把自己推進 context
         self._token = _current.set(self)
 
+        if self.section:
+            self.directive(section_directive(self.section))
         # 若有 label，先 emit 1 行 label 指令（附層級）
         if self.label:
             self.emit(Instruction(
@@ -69,6 +122,8 @@ class ASMCode(Block):
                 dsts=[], srcs=[], kwargs={},
                 depth=self.depth, block=self.label
             ))
+            if self.align_policy and self.align_policy.function_directive():
+                self.directive(self.align_policy.function_directive())
             self.emit(Instruction(
                 template=f"{self.label}:",
                 dsts=[], srcs=[], kwargs={},
@@ -87,6 +142,12 @@ class ASMCode(Block):
             dsts=[], srcs=[], kwargs={},
             depth=self.depth, block=self.label
         ))
+        if self.rename:
+            self._apply_rename()
+        if self.fusion is not None:
+            self._apply_fusion()
+        if self.section:
+            self.directive(".popsection")
         _current.reset(self._token)
         parent = _current.get(None)
         if parent is not None:
@@ -94,8 +155,32 @@ class ASMCode(Block):
 
 
 
+    def _apply_rename(self):
+        pool = DEFAULT_POOL if self.rename is True else [self._reg_to_str(r) for r in self.rename]
+        body, report = rename_registers(self._inst, pool, function=self.label or "")
+        self.rename_report = report
+        self._inst = body
+        self._insert_report(report)
+
+    def _apply_fusion(self):
+        body, report = fuse_pairs(self._inst, self.fusion, function=self.label or "")
+        self.fusion_report = report
+        self._inst = body
+        self._insert_report(report)
+
+    def _insert_report(self, report):
+        # 報告放在函式標籤之後
+        head = next((i + 1 for i, inst in enumerate(self._inst)
+                     if inst.template == f"_{self.label}:"), 0)
+        self._inst.insert(head, Instruction(
+            template=f"// {report}",
+            dsts=[], srcs=[], kwargs={},
+            depth=self.depth, block=self.label
+        ))
+
+
 class BackgroundCode(Block):
-    def __init__(self, label: str | None = None):
+    def __init__(self, label: Optional[str] = None):
         super().__init__(label=label)
         self.depth = -1
 
@@ -131,11 +216,11 @@ class BackgroundCode(Block):
 
 
 class DataBlock(Block):
-    def __init__(self, label: str | None = None, align: int = 4):
+    def __init__(self, label: Optional[str] = None, align: int = 4):
         super().__init__(label=label)
         self.align = align
 
-    def add_data(self, size : str, data: int | str):
+    def add_data(self, size : str, data: Union[int, str]):
         if size not in ["byte", "hword", "half", "word", "xword"]:
             raise ValueError("size must be one of 'byte', 'hword', 'half', 'word', 'xword'")
         self.emit(Instruction(
@@ -170,4 +255,364 @@ class DataBlock(Block):
 
         # 把自己累積的 inst 串接到父層
         if parent is not None:
-            parent._inst.extend(self._inst)
\ No newline at end of file
+            parent._inst.extend(self._inst)
+
+
+class ColdBlock(Block):
+    """
+    Out-of-line code for rarely taken paths, placed in another section
+    (.text.unlikely by default) so it stays out of the hot fetch stream.
+
+        f.CBZ("x2", "f_empty")
+        ...
+        with ColdBlock(label="f_empty") as c:
+            c.MOV("x0", "xzr")
+            c.RET()
+
+    The block must end in a branch or return; it does not fall through.
+    """
+
+    def __init__(self, label: str, section: str = UNLIKELY):
+        super().__init__(label=label)
+        self.section = section
+
+    def __enter__(self):
+        self._token = _current.set(self)
+        self.directive(section_directive(self.section))
+        self.directive(f"{self.label}:")
+        return self
+
+    def __exit__(self, exc_type, exc, tb):
+        self.directive(".popsection")
+        _current.reset(self._token)
+        parent = _current.get(None)
+        if parent is not None:
+            parent._inst.extend(self._inst)
+
+
+class Loop(Block):
+    """
+    Counted loop. The body is recorded inside the with-block and lowered on exit.
+
+        with Loop("x3", label="row", unroll=4) as lp:   # x3 holds the trip count
+            lp.LDR_post("x4", "x1", 8)
+            ...
+
+    counter : register holding the trip count (decremented to zero; clobbered);
+              a W counter limits a runtime count to 2^31 - 1 when unrolled or pipelined
+    count   : compile-time trip count; when given, the counter is initialised here
+    unroll  : replicate the body k times per iteration. Post-indexed pointer
+              increments are folded into one update per unrolled iteration and
+              trip counts not divisible by k run through a remainder loop
+              (or straight-line peeled copies when count is known).
+    pipeline: MachineModel; software-pipeline the body with a modulo schedule
+              (prologue / kernel / epilogue, see passes/modulo.py). The achieved
+              II and its lower bounds are left in lp.report. Registers that the
+              body writes before reading are undefined after the loop.
+    scratch : free registers for modulo variable expansion of long lifetimes
+    noalias : loads and stores through different base registers never overlap
+    prefetch: PrefetchPolicy; PRFM every strided pointer stream `distance`
+              iterations ahead in the loop that runs the bulk of the trip
+              count (not in remainder loops or peeled copies), see
+              passes/prefetch.py. That loop's pass is repeated until every
+              stream advances by whole cache lines, so no line is prefetched
+              twice. The streams found are left in lp.prefetch_report.
+    align   : AlignPolicy for the loop head (inherited from the enclosing ASMCode)
+
+    Loop control uses SUB/CBNZ/TBZ only, so carry flags survive across iterations.
+    """
+
+    def __init__(self, counter, count: Optional[int] = None, *, label: str, unroll: int = 1,
+                 pipeline=None, scratch=(), noalias: bool = False,
+                 prefetch: Optional[PrefetchPolicy] = None, align: Optional[AlignPolicy] = None):
+        super().__init__(label=label)
+        if align is not None:
+            self.align_policy = align
+        if unroll < 1 or unroll > 4095:
+            raise ValueError("unroll factor must be in range 1-4095")
+        if pipeline is not None and unroll > 1:
+            raise ValueError("pipeline and unroll are exclusive (modulo expansion picks the unroll)")
+        if count is not None and count < 0:
+            raise ValueError("trip count must be non-negative")
+        self.counter = self._reg_to_str(counter)
+        if self.counter[:1].lower() not in ("x", "w"):
+            raise ValueError(f"loop counter must be a general-purpose register, got {self.counter}")
+        # Bit tested by TBZ/TBNZ for a negative biased count
+        self.sign_bit = 31 if self.counter[0].lower() == "w" else 63
+        self.count = count
+        self.unroll = unroll
+        self.pipeline = pipeline
+        self.scratch = [self._reg_to_str(r) for r in scratch]
+        self.noalias = noalias
+        self.prefetch = prefetch
+        self.report = None
+        self.prefetch_report = None
+
+    # ---------- context ----------
+    def __enter__(self):
+        self._token = _current.set(self)
+        return self
+
+    def __exit__(self, exc_type, exc, tb):
+        _current.reset(self._token)
+        body, self._inst = self._inst, []
+        if exc_type is None:
+            self._check_body(body)
+            self._lower(body)
+        parent = _current.get(None)
+        if parent is not None:
+            parent._inst.extend(self._inst)
+
+    # ---------- lowering ----------
+    def _emit_label(self, name: str):
+        self.emit(Instruction(
+            template=f"{name}:",
+            dsts=[], srcs=[], kwargs={},
+            depth=self.depth, block=self.label
+        ))
+
+    def _emit_head(self, name: str):
+        """Loop-head label, aligned as the policy asks."""
+        if self.align_policy and self.align_policy.loop_directive():
+            self.directive(self.align_policy.loop_directive())
+        self._emit_label(name)
+
+    def _check_body(self, body):
+        ctr = canonical(self.counter)
+        for inst in body:
+            if ctr in defs(inst):
+                raise ValueError(f"Loop body must not write the counter {self.counter}")
+            if (self.unroll > 1 or self.pipeline) and ctr in uses(inst):
+                raise ValueError(f"Unrolled or pipelined loop body must not read the counter {self.counter}")
+
+    def _load_count(self, value: int):
+        if value <= 0xFFFF:
+            self.MOV_imm(self.counter, value)
+            return
+        self.MOVZ(self.counter, value & 0xFFFF)
+        for shift in (16, 32, 48):
+            if (value >> shift) & 0xFFFF:
+                self.MOVK(self.counter, (value >> shift) & 0xFFFF, shift)
+
+    def _line_period(self, insts, iterations: int) -> int:
+        """Copies of the main loop's pass that advance every prefetched stream by whole cache lines."""
+        return 1 if self.prefetch is None else line_period(insts, self.prefetch, iterations)
+
+    def _prefetched(self, insts, iterations: int):
+        """The loop's main body with PRFMs for its pointer streams, when a policy is set."""
+        if self.prefetch is None:
+            return insts
+        insts, self.prefetch_report = insert_prefetches(insts, self.prefetch, iterations)
+        self.comment(str(self.prefetch_report))
+        return insts
+
+    def _lower(self, body):
+        if self.pipeline is not None:
+            self._lower_pipelined(body)
+            return
+        k, ctr, name = self.unroll, self.counter, self.label
+        k *= self._line_period(unroll_body(body, k), k)
+        if self.count is not None:
+            # Known trip count: peel the remainder, loop over whole unrolled iterations
+            trips, rem = divmod(self.count, k)
+            if rem:
+                self._inst.extend(unroll_body(body, rem))
+            if trips == 1:
+                self._inst.extend(unroll_body(body, k))
+            elif trips > 1:
+                main = self._prefetched(unroll_body(body, k), k)
+                self._load_count(trips)
+                self._emit_head(name)
+                self._inst.extend(main)
+                self.SUB_imm(ctr, ctr, 1)
+                self.CBNZ(ctr, name)
+            return
+
+        main = self._prefetched(unroll_body(body, k), k)
+        if k == 1:
+            self.CBZ(ctr, f"{name}_done")
+            self._emit_head(name)
+            self._inst.extend(main)
+            self.SUB_imm(ctr, ctr, 1)
+            self.CBNZ(ctr, name)
+            self._emit_label(f"{name}_done")
+            return
+
+        # Runtime trip count: bias the counter by -k and test its sign bit,
+        # then finish the 0..k-1 leftover iterations in a single-copy loop.
+        self.SUB_imm(ctr, ctr, k)
+        self.TBNZ(ctr, self.sign_bit, f"{name}_rem")
+        self._emit_head(name)
+        self._inst.extend(main)
+        self.SUB_imm(ctr, ctr, k)
+        self.TBZ(ctr, self.sign_bit, name)
+        self._emit_label(f"{name}_rem")
+        self.ADD_imm(ctr, ctr, k)
+        self.CBZ(ctr, f"{name}_done")
+        self._emit_label(f"{name}_rem_loop")
+        self._inst.extend(unroll_body(body, 1))
+        self.SUB_imm(ctr, ctr, 1)
+        self.CBNZ(ctr, f"{name}_rem_loop")
+        self._emit_label(f"{name}_done")
+
+    def _lower_pipelined(self, body):
+        ctr, name = self.counter, self.label
+        sched = ModuloSchedule(body, self.pipeline, scratch=self.scratch, noalias=self.noalias)
+        self.report = sched.report
+        self.comment(str(sched.report))
+        copies = self._line_period(sched.kernel(), sched.unroll)
+        s, u = sched.stages, sched.unroll * copies
+        fill = s - 1 + u    # iterations started by prologue + one kernel pass
+
+        def kernel_pass():
+            return [inst for _ in range(copies) for inst in sched.kernel()]
+
+        if self.count is not None:
+            passes = (self.count - (s - 1)) // u
+            if passes < 1:
+                self.comment(f"trip count {self.count} too short to pipeline")
+                self.pipeline = None
+                self._lower(body)
+                return
+            self._inst.extend(sched.prologue())
+            if passes == 1:
+                self._inst.extend(kernel_pass())
+            else:
+                kernel = self._prefetched(kernel_pass(), u)
+                self._load_count(passes)
+                self._emit_head(name)
+                self._inst.extend(kernel)
+                self.SUB_imm(ctr, ctr, 1)
+                self.CBNZ(ctr, name)
+            self._inst.extend(sched.epilogue())
+            self._inst.extend(sched.fixups())
+            rem = self.count - (s - 1) - passes * u
+            if rem:
+                self._inst.extend(unroll_body(body, rem))
+            return
+
+        # Runtime trip count: pipeline when at least `fill` iterations remain,
+        # the 0..u-1 leftovers (or a short count) run through a single-copy loop.
+        kernel = self._prefetched(kernel_pass(), u)
+        self.SUB_imm(ctr, ctr, fill)
+        self.TBNZ(ctr, self.sign_bit, f"{name}_short")
+        self._inst.extend(sched.prologue())
+        self._emit_head(name)
+        self._inst.extend(kernel)
+        self.SUB_imm(ctr, ctr, u)
+        self.TBZ(ctr, self.sign_bit, name)
+        self._inst.extend(sched.epilogue())
+        self._inst.extend(sched.fixups())
+        self.ADD_imm(ctr, ctr, u)
+        self.B(f"{name}_rem")
+        self._emit_label(f"{name}_short")
+        self.ADD_imm(ctr, ctr, fill)
+        self._emit_label(f"{name}_rem")
+        self.CBZ(ctr, f"{name}_done")
+        self._emit_label(f"{name}_rem_loop")
+        self._inst.extend(unroll_body(body, 1))
+        self.SUB_imm(ctr, ctr, 1)
+        self.CBNZ(ctr, f"{name}_rem_loop")
+        self._emit_label(f"{name}_done")
+
+
+class PredicatedLoop(Block):
+    """
+    Vector-length-agnostic SVE loop over n elements, driven by WHILELT.
+
+        with PredicatedLoop("x9", "x3", p_reg(0).s, label="vadd") as lp:
+            lp.LD1W(z_reg(0).s, p_reg(0), "x1", "x9")
+            lp.LD1W(z_reg(1).s, p_reg(0), "x2", "x9")
+            lp.ZFADD(z_reg(0).s, z_reg(0).s, z_reg(1).s)
+            lp.ST1W(z_reg(0).s, p_reg(0), "x0", "x9")
+
+    lowers to
+
+            mov     x9, #0
+            whilelt p0.s, x9, x3
+            b.none  vadd_done
+        vadd:
+            <body>
+            incw    x9
+            whilelt p0.s, x9, x3
+            b.first vadd
+        vadd_done:
+
+    index   : x register holding the element index, set to `start` (None: the
+              caller has set it) and advanced by `vectors` vectors of pred's elements
+    limit   : x register holding the element count n (read only)
+    pred    : sized predicate register; its element size picks the INC and the
+              WHILELT lanes. The last pass runs with only the lanes below n
+              active, so there is no remainder loop: loads through pred/z
+              zero the inactive lanes and stores through pred skip them.
+    unsigned: compare with WHILELO (index and limit as unsigned)
+    vectors : vectors the body covers per pass (1-16); pred is the predicate
+              of the first, the body builds those of the others (WHILELT from
+              index + k vectors) and the index advances by all of them
+    align   : AlignPolicy for the loop head (inherited from the enclosing ASMCode)
+
+    The body must not write index, limit or pred; it may use the flags,
+    the loop control sets them again at the end of each pass.
+    """
+
+    _INC = {8: "INCB", 16: "INCH", 32: "INCW", 64: "INCD"}
+
+    def __init__(self, index, limit, pred, *, label: str, start: Optional[int] = 0,
+                 unsigned: bool = False, vectors: int = 1, align: Optional[AlignPolicy] = None):
+        super().__init__(label=label)
+        if align is not None:
+            self.align_policy = align
+        if not 1 <= vectors <= 16:
+            raise ValueError("vectors per pass must be in range 1-16")
+        if getattr(pred, "esize", None) is None:
+            raise TypeError(f"PredicatedLoop needs a sized predicate such as p_reg(0).s, got {pred!r}")
+        if start is not None and not 0 <= start <= 0xFFFF:
+            raise ValueError("start index must be in range 0-65535")
+        self.index = self._reg_to_str(index)
+        self.limit = self._reg_to_str(limit)
+        self.pred = pred
+        self.start = start
+        self.unsigned = unsigned
+        self.vectors = vectors
+
+    # ---------- context ----------
+    def __enter__(self):
+        self._token = _current.set(self)
+        return self
+
+    def __exit__(self, exc_type, exc, tb):
+        _current.reset(self._token)
+        body, self._inst = self._inst, []
+        if exc_type is None:
+            self._check_body(body)
+            self._lower(body)
+        parent = _current.get(None)
+        if parent is not None:
+            parent._inst.extend(self._inst)
+
+    def _check_body(self, body):
+        fixed = {canonical(self.index): self.index, canonical(self.limit): self.limit,
+                 canonical(str(self.pred)): str(self.pred)}
+        for inst in body:
+            for reg in defs(inst) & fixed.keys():
+                raise ValueError(f"PredicatedLoop body must not write {fixed[reg]}")
+
+    def _while(self):
+        (self.WHILELO if self.unsigned else self.WHILELT)(self.pred, self.index, self.limit)
+
+    def _lower(self, body):
+        name = self.label
+        if self.start is not None:
+            self.MOV_imm(self.index, self.start)
+        self._while()
+        self.B_cond("none", f"{name}_done")
+        if self.align_policy and self.align_policy.loop_directive():
+            self.directive(self.align_policy.loop_directive())
+        self.emit(Instruction(template=f"{name}:", dsts=[], srcs=[], kwargs={},
+                              depth=self.depth, block=self.label))
+        self._inst.extend(body)
+        getattr(self, self._INC[self.pred.esize])(self.index, self.vectors)
+        self._while()
+        self.B_cond("first", name)
+        self.emit(Instruction(template=f"{name}_done:", dsts=[], srcs=[], kwargs={},
+                              depth=self.depth, block=self.label))
@@ -1,6 +1,6 @@
 # armasmgen/core.py
 from dataclasses import dataclass
-from typing import List, Dict, Any, Union, TYPE_CHECKING
+from typing import List, Dict, Any, Optional, Union, TYPE_CHECKING
 
 # Avoid circular imports
 if TYPE_CHECKING:
@@ -17,7 +17,7 @@ class Instruction:
     srcs: List[str]
     kwargs: Dict[str, Any]
     depth: int = 0              # 新增 → 代表縮排層級
-    block: str | None = None    # 新增 → 產生指令的 block label
+    block: Optional[str] = None    # 新增 → 產生指令的 block label
 
     def render(self, indent: bool = False) -> str:
         def _fmt(k, v): 
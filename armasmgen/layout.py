@@ -0,0 +1,56 @@
+# armasmgen/layout.py
+"""
+Code placement policies: alignment of function entries and loop heads,
+and the sections hot and cold code are emitted into.
+
+    ASMCode(label="f", align=FETCH32, section=HOT)   # .p2align 5 + .text.hot
+    Loop("x2", label="row", align=FETCH16)           # .p2align 4,,8 before the head
+    ColdBlock(label="f_slow")                        # body goes to .text.unlikely
+
+Alignments are log2 byte counts, as for .p2align. A loop head is padded
+only when at most loop_max_skip bytes (nops on the fall-through path) are
+needed; otherwise the directive is a no-op.
+
+Sections use .pushsection/.popsection and therefore target ELF.
+"""
+
+from dataclasses import dataclass
+from typing import Optional
+
+HOT = ".text.hot"
+UNLIKELY = ".text.unlikely"
+
+
+@dataclass(frozen=True)
+class AlignPolicy:
+    function: int = 0                     # log2 alignment of function entries (0 = none)
+    loop: int = 0                         # log2 alignment of loop heads (0 = none)
+    loop_max_skip: Optional[int] = None   # most padding bytes worth spending on a loop head
+
+    def __post_init__(self):
+        for name in ("function", "loop"):
+            if not 0 <= getattr(self, name) <= 12:
+                raise ValueError(f"{name} alignment must be a log2 value in range 0-12")
+        if self.loop_max_skip is not None and not 0 <= self.loop_max_skip < (1 << self.loop):
+            raise ValueError("loop_max_skip must be smaller than the loop alignment")
+
+    def function_directive(self) -> Optional[str]:
+        return f".p2align {self.function}" if self.function else None
+
+    def loop_directive(self) -> Optional[str]:
+        if not self.loop:
+            return None
+        if self.loop_max_skip is None:
+            return f".p2align {self.loop}"
+        return f".p2align {self.loop},,{self.loop_max_skip}"
+
+
+# Presets by fetch-block size; loop heads accept up to two to three nops of padding
+NO_ALIGN = AlignPolicy()
+FETCH16 = AlignPolicy(function=4, loop=4, loop_max_skip=8)
+FETCH32 = AlignPolicy(function=5, loop=5, loop_max_skip=12)
+FETCH64 = AlignPolicy(function=6, loop=5, loop_max_skip=12)
+
+
+def section_directive(name: str) -> str:
+    return f'.pushsection {name},"ax",%progbits'
@@ -0,0 +1,242 @@
+# armasmgen/machine.py
+"""
+Machine models for instruction scheduling.
+
+A MachineModel describes an AArch64 core as
+    - an issue width (instructions per cycle),
+    - a set of functional-unit classes with a count each,
+    - per-mnemonic latency, unit class and occupancy (cycles the unit stays busy),
+    - the same for SIMD&FP instructions (operands in v/q/d/s/h/b registers),
+      which share mnemonics such as add and mul with the integer ones.
+
+Loads and stores move at most 16 bytes through a load/store unit per
+cycle: an LDP of two q registers or a four-register LD1 occupies its unit
+for one cycle per 16 bytes of SIMD&FP registers it transfers. SVE
+instructions on a core with vector_bits > 128 likewise occupy
+vector_bits / 128 of the 128-bit SIMD pipes or load/store cycles.
+
+The figures in the presets are approximations taken from the public
+Software Optimization Guides; they are meant to rank schedules, not to
+predict cycle counts exactly. Use MachineModel.with_overrides() to tune
+a preset for a specific core.
+"""
+
+import re
+from dataclasses import dataclass, field, replace
+from typing import Dict, Tuple, FrozenSet, Optional
+
+from .core import Instruction
+
+
+@dataclass(frozen=True)
+class OpTiming:
+    latency: int        # cycles until the result can be consumed
+    unit: str           # functional-unit class
+    occupancy: int = 1  # cycles the unit is blocked (1 = fully pipelined)
+
+
+# Mnemonic groups shared by every model
+_ALU = ("add", "adds", "adc", "adcs", "sub", "subs", "sbc", "sbcs", "neg", "negs", "ngc", "ngcs",
+        "and", "ands", "orr", "eor", "bic", "bics", "orn", "eon", "mvn", "mov", "movz", "movk", "movn",
+        "lsl", "lsr", "asr", "ror", "extr", "rev", "cmp", "cmn", "ccmp", "tst", "csel", "csinc", "csinv",
+        "csneg", "cset", "csetm", "cinc", "cinv", "cneg", "adr", "adrp", "ubfx", "sbfx", "ubfm", "sbfm", "nop")
+_MUL = ("mul", "madd", "msub", "mneg")
+_MULH = ("umulh", "smulh")
+_LOAD = ("ldr", "ldp", "ldur", "ldnp", "ldrb", "ldrh", "ldrsw", "prfm", "prfum",
+         "ld1", "ld2", "ld3", "ld4", "ld1r", "ld2r", "ld3r", "ld4r")
+_STORE = ("str", "stp", "stur", "stnp", "strb", "strh", "st1", "st2", "st3", "st4", "dc")
+_BRANCH = ("b", "bl", "br", "blr", "ret", "cbz", "cbnz", "tbz", "tbnz")
+
+# SVE contiguous loads/stores and the scalar side of predicated loops; only SVE models time them
+_SVE_LOAD = ("ld1b", "ld1h", "ld1w", "ld1d", "ld1sb", "ld1sh", "ld1sw")
+_SVE_STORE = ("st1b", "st1h", "st1w", "st1d")
+_SVE_PRED = ("whilelt", "whilelo", "ptrue", "pfalse")
+_SVE_COUNT = ("cntb", "cnth", "cntw", "cntd", "incb", "inch", "incw", "incd", "rdvl", "addvl")
+
+# SIMD&FP groups; any other instruction on vector registers takes the vector ALU timing
+_VMUL = ("mul", "mla", "mls") + tuple(op + half for op in ("umull", "umlal", "umlsl", "smull", "smlal", "smlsl")
+                                     for half in ("", "2"))
+_VFMA = ("fmul", "fmla", "fmls", "fadd", "fsub")
+_VDOT = ("sdot", "udot")
+_VREG_RE = re.compile(r"[vqdshbz]\d+(?:\..*)?")
+_ARRANGED_RE = re.compile(r"v\d+\.(\d*)([bhsd])")
+_ZREG_RE = re.compile(r"z\d+(?:\..*)?")
+_ELEMENT_BYTES = {"b": 1, "h": 2, "s": 4, "d": 8, "q": 16}
+_PIPE_BYTES = 16    # data path of one load/store unit
+_NOT_VECTOR = frozenset(_LOAD + _STORE + _BRANCH + _SVE_LOAD + _SVE_STORE)
+
+
+def _transfer_bytes(reg: str, vector_bits: int) -> int:
+    """Bytes a load/store moves for one register: q0 16, d0 8, v0.8B 8, lane v5.S 4, z0.s vector_bits / 8, x0 0"""
+    reg = reg.strip().lower()
+    if _ZREG_RE.fullmatch(reg):
+        return vector_bits // 8
+    m = _ARRANGED_RE.fullmatch(reg)
+    if m:
+        return int(m.group(1) or 1) * _ELEMENT_BYTES[m.group(2)]
+    if _VREG_RE.fullmatch(reg) and reg[0] in _ELEMENT_BYTES:
+        return _ELEMENT_BYTES[reg[0]]
+    return 0
+
+
+def _fusion_key(inst: Instruction) -> str:
+    op = inst.template.split(" ", 1)[0].lower()
+    return "b.cond" if op.startswith("b.") else op
+
+
+# Fusible pairs; each core fuses a subset
+_FUSE_AES = {("aese", "aesmc"), ("aesd", "aesimc")}
+_FUSE_CMP_BRANCH = {(op, "b.cond") for op in ("cmp", "cmn", "tst")}
+_FUSE_FLAGS_BRANCH = {(op, "b.cond") for op in ("adds", "subs", "ands")}
+_FUSE_ADDR = {("adrp", "add")}
+_FUSE_MOVE_WIDE = {("movz", "movk")}
+
+
+def _table(alu, mul, mulh, load, store, branch, predicate=None) -> Dict[str, OpTiming]:
+    """Scalar timings by group; predicate is None on cores without SVE, else the WHILELT/PTRUE timing."""
+    groups = [(_ALU, alu), (_MUL, mul), (_MULH, mulh), (_LOAD, load), (_STORE, store), (_BRANCH, branch)]
+    if predicate is not None:
+        groups += [(_SVE_LOAD, load), (_SVE_STORE, store), (_SVE_PRED, predicate), (_SVE_COUNT, alu)]
+    table = {}
+    for names, timing in groups:
+        for name in names:
+            table[name] = timing
+    return table
+
+
+def _vector_table(mul, fma, dot=None) -> Dict[str, OpTiming]:
+    """Vector timings by group; dot is None on cores without the dot-product extension."""
+    table = {name: mul for name in _VMUL}
+    table.update({name: fma for name in _VFMA})
+    if dot is not None:
+        table.update({name: dot for name in _VDOT})
+    return table
+
+
+@dataclass(frozen=True)
+class MachineModel:
+    name: str
+    issue_width: int
+    units: Dict[str, int]
+    timings: Dict[str, OpTiming]
+    default: OpTiming = OpTiming(1, "alu")
+    # Pairs of mnemonics the decoder fuses when adjacent (used by the fusion pass)
+    fusion_pairs: FrozenSet[Tuple[str, str]] = field(default_factory=frozenset)
+    # SIMD&FP data processing; None models vector instructions like integer ones
+    vector_timings: Dict[str, OpTiming] = field(default_factory=dict)
+    vector_default: Optional[OpTiming] = None
+    # SVE vector length; wider than 128 bits, a Z-register instruction takes several 128-bit pipes
+    vector_bits: int = 128
+
+    def timing(self, inst: Instruction) -> OpTiming:
+        op = inst.template.split(" ", 1)[0].lower()
+        if op.startswith("b."):
+            op = "b"
+        if self.vector_default is not None and op not in _NOT_VECTOR and self._on_vectors(inst):
+            timing = self.vector_timings.get(op, self.vector_default)
+            pipes = self.vector_bits // 128
+            if pipes > 1 and any(_ZREG_RE.fullmatch(r.strip().lower()) for r in inst.dsts + inst.srcs):
+                timing = replace(timing, occupancy=timing.occupancy * pipes)
+            return timing
+        timing = self.timings.get(op, self.default)
+        if timing.unit in ("load", "store"):
+            slots = self._pipe_slots(inst, timing.unit == "load", self.vector_bits)
+            if slots > 1:
+                timing = replace(timing, occupancy=timing.occupancy * slots)
+        return timing
+
+    @staticmethod
+    def _pipe_slots(inst: Instruction, is_load: bool, vector_bits: int) -> int:
+        """Cycles of one load/store unit: the SIMD&FP bytes loaded (dsts) or stored (srcs), 16 per cycle"""
+        data = sum(_transfer_bytes(r, vector_bits) for r in (inst.dsts if is_load else inst.srcs))
+        return max(1, -(-data // _PIPE_BYTES))
+
+    @staticmethod
+    def _on_vectors(inst: Instruction) -> bool:
+        return any(_VREG_RE.fullmatch(r.strip().lower()) for r in inst.dsts + inst.srcs)
+
+    def supports(self, mnemonic: str) -> bool:
+        """
+        Whether the model times this mnemonic: sdot is absent on cores without
+        DotProd, whilelt (and the other SVE-only ones) on cores without SVE.
+        """
+        return mnemonic in self.vector_timings or mnemonic in self.timings
+
+    def latency(self, inst: Instruction) -> int:
+        return self.timing(inst).latency
+
+    def fuses(self, first: Instruction, second: Instruction) -> bool:
+        """Whether the decoder fuses this mnemonic pair (b.<cond> is written "b.cond")."""
+        return (_fusion_key(first), _fusion_key(second)) in self.fusion_pairs
+
+    def with_overrides(self, name: Optional[str] = None, vector: Optional[Dict[str, OpTiming]] = None,
+                       **timings: OpTiming) -> "MachineModel":
+        """Copy of the model with some mnemonic timings replaced (vector= for SIMD&FP ones, e.g. {"fmla": ...})."""
+        merged = dict(self.timings)
+        merged.update(timings)
+        merged_vector = dict(self.vector_timings)
+        merged_vector.update(vector or {})
+        return replace(self, name=name or self.name, timings=merged, vector_timings=merged_vector)
+
+
+CORTEX_A55 = MachineModel(
+    name="cortex-a55",
+    issue_width=2,
+    units={"alu": 2, "mul": 1, "load": 1, "store": 1, "branch": 1, "simd": 1},
+    timings=_table(alu=OpTiming(1, "alu"), mul=OpTiming(4, "mul", 2), mulh=OpTiming(5, "mul", 3),
+                   load=OpTiming(3, "load"), store=OpTiming(1, "store"), branch=OpTiming(1, "branch")),
+    fusion_pairs=frozenset(_FUSE_AES),
+    vector_timings=_vector_table(mul=OpTiming(4, "simd"), fma=OpTiming(4, "simd"), dot=OpTiming(4, "simd")),
+    vector_default=OpTiming(2, "simd"),
+)
+
+CORTEX_A72 = MachineModel(
+    name="cortex-a72",
+    issue_width=3,
+    units={"alu": 2, "mul": 1, "load": 1, "store": 1, "branch": 1, "simd": 2},
+    timings=_table(alu=OpTiming(1, "alu"), mul=OpTiming(5, "mul", 3), mulh=OpTiming(6, "mul", 4),
+                   load=OpTiming(4, "load"), store=OpTiming(1, "store"), branch=OpTiming(1, "branch")),
+    fusion_pairs=frozenset(_FUSE_AES | _FUSE_MOVE_WIDE),
+    vector_timings=_vector_table(mul=OpTiming(5, "simd", 2), fma=OpTiming(7, "simd")),
+    vector_default=OpTiming(3, "simd"),
+)
+
+NEOVERSE_N1 = MachineModel(
+    name="neoverse-n1",
+    issue_width=4,
+    units={"alu": 3, "mul": 1, "load": 2, "store": 1, "branch": 1, "simd": 2},
+    timings=_table(alu=OpTiming(1, "alu"), mul=OpTiming(4, "mul"), mulh=OpTiming(5, "mul", 2),
+                   load=OpTiming(4, "load"), store=OpTiming(1, "store"), branch=OpTiming(1, "branch")),
+    fusion_pairs=frozenset(_FUSE_AES | _FUSE_CMP_BRANCH | _FUSE_ADDR | _FUSE_MOVE_WIDE),
+    vector_timings=_vector_table(mul=OpTiming(4, "simd", 2), fma=OpTiming(4, "simd"), dot=OpTiming(2, "simd")),
+    vector_default=OpTiming(2, "simd"),
+)
+
+APPLE_M1 = MachineModel(
+    name="apple-m1",
+    issue_width=8,
+    units={"alu": 6, "mul": 2, "load": 3, "store": 2, "branch": 2, "simd": 4},
+    timings=_table(alu=OpTiming(1, "alu"), mul=OpTiming(3, "mul"), mulh=OpTiming(3, "mul"),
+                   load=OpTiming(4, "load"), store=OpTiming(1, "store"), branch=OpTiming(1, "branch")),
+    fusion_pairs=frozenset(_FUSE_AES | _FUSE_CMP_BRANCH | _FUSE_FLAGS_BRANCH | _FUSE_ADDR
+                           | _FUSE_MOVE_WIDE),
+    vector_timings=_vector_table(mul=OpTiming(3, "simd"), fma=OpTiming(4, "simd"), dot=OpTiming(3, "simd")),
+    vector_default=OpTiming(2, "simd"),
+)
+
+# 256-bit SVE: four 128-bit SIMD pipes, which an SVE instruction uses in pairs
+NEOVERSE_V1 = MachineModel(
+    name="neoverse-v1",
+    issue_width=8,
+    units={"alu": 4, "mul": 2, "load": 3, "store": 2, "branch": 2, "simd": 4},
+    timings=_table(alu=OpTiming(1, "alu"), mul=OpTiming(2, "mul"), mulh=OpTiming(3, "mul"),
+                   load=OpTiming(4, "load"), store=OpTiming(1, "store"), branch=OpTiming(1, "branch"),
+                   predicate=OpTiming(3, "alu")),
+    fusion_pairs=frozenset(_FUSE_AES | _FUSE_CMP_BRANCH | _FUSE_FLAGS_BRANCH | _FUSE_ADDR
+                           | _FUSE_MOVE_WIDE),
+    vector_timings=_vector_table(mul=OpTiming(4, "simd", 2), fma=OpTiming(4, "simd"), dot=OpTiming(3, "simd")),
+    vector_default=OpTiming(2, "simd"),
+    vector_bits=256,
+)
+
+MODELS = {m.name: m for m in (CORTEX_A55, CORTEX_A72, NEOVERSE_N1, APPLE_M1, NEOVERSE_V1)}
@@ -3,5 +3,7 @@ from .memory import MemoryMixin
 from .logic import LogicMixin
 from .control import ControlFlowMixin
 from .vector_arithmetic import VectorArithmeticMixin
+from .simd import SIMDMixin
+from .sve import SVEMixin
 
-__all__ = ["ArithmeticMixin", "MemoryMixin", "LogicMixin", "ControlFlowMixin", "VectorArithmeticMixin"]
\ No newline at end of file
+__all__ = ["ArithmeticMixin", "MemoryMixin", "LogicMixin", "ControlFlowMixin", "VectorArithmeticMixin", "SIMDMixin", "SVEMixin"]
\ No newline at end of file
@@ -1,5 +1,6 @@
 # asm_printer/mixins/arithmetic.py
 from ..core import Instruction, RegArg
+from .control import check_condition
 from typing import TYPE_CHECKING
 
 if TYPE_CHECKING:
@@ -235,6 +236,25 @@ class ArithmeticMixin:
             kwargs=dict(dst=dst_str, src0=src0_str, imm=imm)
         ))
 
+    def ADC(self, dst: RegArg, src0: RegArg, src1: RegArg):
+        """
+        Add with carry (register):
+        This instruction adds two register values and the carry flag, and writes
+        the result to the destination register. The flags are not changed.
+
+            dst = src0 + src1 + carry_flag
+
+        Closes a carry chain: the final carry lands in a register.
+        Reference: A-profile: section C6.2.1, page C6-1793
+        """
+        dst_str, src0_str, src1_str = self._reg_to_str(dst), self._reg_to_str(src0), self._reg_to_str(src1)
+        self.emit(Instruction(
+            template="adc {dst}, {src0}, {src1}",
+            dsts=[dst_str],
+            srcs=[src0_str, src1_str],
+            kwargs=dict(dst=dst_str, src0=src0_str, src1=src1_str)
+        ))
+
     def SUBS(self, dst: RegArg, src0: RegArg, src1: RegArg):
         """
         Subtract and set flags (register):
@@ -292,4 +312,137 @@ class ArithmeticMixin:
             dsts=[dst_str],
             srcs=[src0_str, src1_str],
             kwargs=dict(dst=dst_str, src0=src0_str, src1=src1_str)
-        ))
\ No newline at end of file
+        ))
+
+    def SBC(self, dst: RegArg, src0: RegArg, src1: RegArg):
+        """
+        Subtract with carry (register):
+        This instruction subtracts one register value and the NOT of the carry flag
+        from another register value. The flags are not changed.
+
+            dst = src0 - src1 - ~carry_flag
+
+        Reference: A-profile: section C6.2.250, page C6-2130
+        """
+        dst_str, src0_str, src1_str = self._reg_to_str(dst), self._reg_to_str(src0), self._reg_to_str(src1)
+        self.emit(Instruction(
+            template="sbc {dst}, {src0}, {src1}",
+            dsts=[dst_str],
+            srcs=[src0_str, src1_str],
+            kwargs=dict(dst=dst_str, src0=src0_str, src1=src1_str)
+        ))
+
+    def CMP(self, src0: RegArg, src1: RegArg):
+        """
+        Compare (register):
+        This instruction subtracts a register value from another register value,
+        discards the result and updates the condition flags. Alias of SUBS with XZR destination.
+
+            flags = src0 - src1
+
+        Reference: A-profile: section C6.2.62, page C6-1889
+        """
+        src0_str, src1_str = self._reg_to_str(src0), self._reg_to_str(src1)
+        self.emit(Instruction(
+            template="cmp {src0}, {src1}",
+            dsts=[],
+            srcs=[src0_str, src1_str],
+            kwargs=dict(src0=src0_str, src1=src1_str)
+        ))
+
+    def CMP_imm(self, src0: RegArg, imm: int):
+        """
+        Compare (immediate):
+        This instruction subtracts an immediate value from a register value,
+        discards the result and updates the condition flags.
+
+            flags = src0 - imm
+
+        Reference: A-profile: section C6.2.61, page C6-1887
+        """
+        if not (0 <= imm <= 4095):
+            raise ValueError("CMP immediate out of range (0-4095)")
+        src0_str = self._reg_to_str(src0)
+        self.emit(Instruction(
+            template="cmp {src0}, #{imm}",
+            dsts=[],
+            srcs=[src0_str],
+            kwargs=dict(src0=src0_str, imm=imm)
+        ))
+
+    def CMN(self, src0: RegArg, src1: RegArg):
+        """
+        Compare negative (register):
+        This instruction adds two register values, discards the result and
+        updates the condition flags. Alias of ADDS with XZR destination.
+
+            flags = src0 + src1
+
+        Reference: A-profile: section C6.2.59, page C6-1883
+        """
+        src0_str, src1_str = self._reg_to_str(src0), self._reg_to_str(src1)
+        self.emit(Instruction(
+            template="cmn {src0}, {src1}",
+            dsts=[],
+            srcs=[src0_str, src1_str],
+            kwargs=dict(src0=src0_str, src1=src1_str)
+        ))
+
+    def CCMP(self, src0: RegArg, src1: RegArg, nzcv: int, cond: str):
+        """
+        Conditional compare (register):
+        If the condition holds, this instruction compares two register values
+        like CMP; otherwise it sets the flags to the immediate nzcv.
+
+            flags = cond ? src0 - src1 : nzcv
+
+        Chains comparisons without branches: cmp x0, x1; ccmp x2, x3, #0, eq
+        leaves eq only when both pairs are equal.
+
+        Reference: A-profile: section C6.2.52, page C6-1876
+        """
+        if not (0 <= nzcv <= 15):
+            raise ValueError("CCMP nzcv immediate must be 0-15")
+        cond = check_condition("ccmp", cond)
+        src0_str, src1_str = self._reg_to_str(src0), self._reg_to_str(src1)
+        self.emit(Instruction(
+            template="ccmp {src0}, {src1}, #{nzcv}, {cond}",
+            dsts=[],
+            srcs=[src0_str, src1_str],
+            kwargs=dict(src0=src0_str, src1=src1_str, nzcv=nzcv, cond=cond)
+        ))
+
+    def ADRP(self, dst: RegArg, symbol: str):
+        """
+        Form PC-relative address to 4KB page:
+        This instruction writes the address of the 4KB page containing symbol.
+        Pair with ADD_lo12 (the decoder fuses the two when adjacent).
+
+            dst = symbol & ~0xFFF
+
+        Reference: A-profile: section C6.2.10, page C6-1814
+        """
+        dst_str = self._reg_to_str(dst)
+        self.emit(Instruction(
+            template="adrp {dst}, {symbol}",
+            dsts=[dst_str],
+            srcs=[],
+            kwargs=dict(dst=dst_str, symbol=symbol)
+        ))
+
+    def ADD_lo12(self, dst: RegArg, src0: RegArg, symbol: str):
+        """
+        Add the low 12 bits of a symbol address (ELF :lo12: relocation):
+        Completes the address formed by ADRP.
+
+            dst = src0 + (symbol & 0xFFF)
+
+        Reference: A-profile: section C6.2.4, page C6-1799
+        """
+        dst_str, src0_str = self._reg_to_str(dst), self._reg_to_str(src0)
+        self.emit(Instruction(
+            template="add {dst}, {src0}, :lo12:{symbol}",
+            dsts=[dst_str],
+            srcs=[src0_str],
+            kwargs=dict(dst=dst_str, src0=src0_str, symbol=symbol)
+        ))
@@ -1,10 +1,29 @@
 # armasmgen/mixins/control.py
 from ..core import Instruction, RegArg
 
+# Condition codes of conditional select and compare (CSEL, CCMP, ...); al and nv both mean "always"
+CONDITIONS = frozenset({"eq", "ne", "cs", "hs", "cc", "lo", "mi", "pl",
+                        "vs", "vc", "hi", "ls", "ge", "lt", "gt", "le", "al", "nv"})
+
+
+def check_condition(mnemonic: str, cond: str, *, always: bool = True) -> str:
+    """cond, validated for mnemonic; always=False for the aliases that invert it (CSET, CINC, ...) and reject al/nv"""
+    if cond not in CONDITIONS:
+        raise ValueError(f"Unknown condition code '{cond}' for {mnemonic}")
+    if not always and cond in ("al", "nv"):
+        raise ValueError(f"condition codes al and nv are invalid for {mnemonic}")
+    return cond
+
+
 class ControlFlowMixin:
     def emit(self, inst: Instruction): ...  # Type hint
     def _reg_to_str(self, reg: RegArg) -> str: ...  # Type hint
 
+    _CONDITIONS = {"eq", "ne", "cs", "hs", "cc", "lo", "mi", "pl",
+                   "vs", "vc", "hi", "ls", "ge", "lt", "gt", "le", "al",
+                   # SVE names for the flags WHILELT sets (the assembler needs SVE enabled)
+                   "none", "any", "first", "nfrst", "last", "nlast", "pmore", "plast", "tcont", "tstop"}
+
     def RET(self, reg: RegArg = "x30"):
         """
         Return from subroutine:
@@ -115,3 +134,123 @@ class ControlFlowMixin:
             srcs=[],
             kwargs={}
         ))
+
+    # System registers user code may read
+    _SYSREGS = {"dczid_el0", "ctr_el0", "midr_el1", "cntvct_el0", "cntfrq_el0", "tpidr_el0", "fpcr", "fpsr"}
+
+    def MRS(self, dst: RegArg, sysreg: str):
+        """
+        Move from system register:
+        This instruction reads a system register into a general-purpose register.
+
+            dst = sysreg
+
+        Used to query the cache geometry at run time (dczid_el0: DC ZVA block
+        size, ctr_el0: cache line sizes).
+
+        Reference: A-profile: section C6.2.172, page C6-2017
+        """
+        if sysreg not in self._SYSREGS:
+            raise ValueError(f"MRS system register must be one of {', '.join(sorted(self._SYSREGS))}, got '{sysreg}'")
+        dst_str = self._reg_to_str(dst)
+        self.emit(Instruction(
+            template="mrs {dst}, {sysreg}",
+            dsts=[dst_str],
+            srcs=[],
+            kwargs=dict(dst=dst_str, sysreg=sysreg)
+        ))
+
+    def B_cond(self, cond: str, label: str):
+        """
+        Branch conditionally:
+        This instruction branches to the label if the condition holds for the current NZCV flags.
+
+            if cond(NZCV): PC = label
+
+        cond is one of eq, ne, cs/hs, cc/lo, mi, pl, vs, vc, hi, ls, ge, lt, gt, le,
+        or an SVE alias after WHILELT: none (= eq), any (= ne), first (= mi), last (= cc), ...
+        Reference: A-profile: section C6.2.26, page C6-1836
+        """
+        cond = cond.lower()
+        if cond not in self._CONDITIONS:
+            raise ValueError(f"Unknown condition code '{cond}'")
+        self.emit(Instruction(
+            template="b.{cond} {label}",
+            dsts=[],
+            srcs=[],
+            kwargs=dict(cond=cond, label=label)
+        ))
+
+    def CBZ(self, reg: RegArg, label: str):
+        """
+        Compare and branch on zero:
+        This instruction branches to the label if the register is zero. Flags are not affected.
+
+            if reg == 0: PC = label
+
+        Reference: A-profile: section C6.2.48, page C6-1870
+        """
+        reg_str = self._reg_to_str(reg)
+        self.emit(Instruction(
+            template="cbz {reg}, {label}",
+            dsts=[],
+            srcs=[reg_str],
+            kwargs=dict(reg=reg_str, label=label)
+        ))
+
+    def CBNZ(self, reg: RegArg, label: str):
+        """
+        Compare and branch on nonzero:
+        This instruction branches to the label if the register is not zero. Flags are not affected.
+
+            if reg != 0: PC = label
+
+        Reference: A-profile: section C6.2.47, page C6-1869
+        """
+        reg_str = self._reg_to_str(reg)
+        self.emit(Instruction(
+            template="cbnz {reg}, {label}",
+            dsts=[],
+            srcs=[reg_str],
+            kwargs=dict(reg=reg_str, label=label)
+        ))
+
+    def TBZ(self, reg: RegArg, bit: int, label: str):
+        """
+        Test bit and branch if zero:
+        This instruction branches to the label if the selected bit of the register is zero.
+        Flags are not affected, which makes it usable inside carry chains.
+
+            if reg[bit] == 0: PC = label
+
+        Reference: A-profile: section C6.2.378, page C6-2286
+        """
+        if not (0 <= bit <= 63):
+            raise ValueError("TBZ bit number must be 0-63")
+        reg_str = self._reg_to_str(reg)
+        self.emit(Instruction(
+            template="tbz {reg}, #{bit}, {label}",
+            dsts=[],
+            srcs=[reg_str],
+            kwargs=dict(reg=reg_str, bit=bit, label=label)
+        ))
+
+    def TBNZ(self, reg: RegArg, bit: int, label: str):
+        """
+        Test bit and branch if nonzero:
+        This instruction branches to the label if the selected bit of the register is one.
+        Flags are not affected.
+
+            if reg[bit] == 1: PC = label
+
+        Reference: A-profile: section C6.2.377, page C6-2285
+        """
+        if not (0 <= bit <= 63):
+            raise ValueError("TBNZ bit number must be 0-63")
+        reg_str = self._reg_to_str(reg)
+        self.emit(Instruction(
+            template="tbnz {reg}, #{bit}, {label}",
+            dsts=[],
+            srcs=[reg_str],
+            kwargs=dict(reg=reg_str, bit=bit, label=label)
+        ))
@@ -1,5 +1,6 @@
 # asm_printer/mixins/logic.py
 from ..core import Instruction, RegArg
+from .control import check_condition
 from typing import TYPE_CHECKING
 
 if TYPE_CHECKING:
@@ -256,6 +257,49 @@ class LogicMixin:
             kwargs=dict(dst=dst_str, src=src_str, shift=shift)
         ))
 
+    # Extract and byte-reverse operations
+    def EXTR(self, dst: RegArg, src0: RegArg, src1: RegArg, lsb: int):
+        """
+        Extract register:
+        Extracts a register from the 128-bit concatenation src0:src1, starting
+        at bit position lsb of src1.
+
+            dst = (src0:src1 >> lsb)[63:0]
+
+        A one-instruction funnel shift for multi-limb shifts.
+        Reference: A-profile: section C6.2.113, page C6-1940
+        """
+        if not (0 <= lsb <= 63):
+            raise ValueError("EXTR lsb must be 0-63")
+        dst_str, src0_str, src1_str = self._reg_to_str(dst), self._reg_to_str(src0), self._reg_to_str(src1)
+        self.emit(Instruction(
+            template="extr {dst}, {src0}, {src1}, #{lsb}",
+            dsts=[dst_str],
+            srcs=[src0_str, src1_str],
+            kwargs=dict(dst=dst_str, src0=src0_str, src1=src1_str, lsb=lsb)
+        ))
+
+    def REV(self, dst: RegArg, src: RegArg):
+        """
+        Reverse bytes:
+        Reverses the byte order of a register (32 or 64 bits, from the
+        register width).
+
+            dst = bswap(src)
+
+        Turns little-endian loaded words into values that compare like
+        the bytes in memory order (memcmp).
+
+        Reference: A-profile: section C6.2.247, page C6-2125
+        """
+        dst_str, src_str = self._reg_to_str(dst), self._reg_to_str(src)
+        self.emit(Instruction(
+            template="rev {dst}, {src}",
+            dsts=[dst_str],
+            srcs=[src_str],
+            kwargs=dict(dst=dst_str, src=src_str)
+        ))
+
     # MOV instructions - data movement operations (logically related to bit manipulation)
     def MOV(self, dst: RegArg, src: RegArg):
         """
@@ -345,3 +389,117 @@ class LogicMixin:
             srcs=[dst_str],  # dst is also a source (keeping some bits)
             kwargs=dict(dst=dst_str, imm=imm, shift=shift)
         ))
+
+    def TST(self, src0: RegArg, src1: RegArg):
+        """
+        Test bits (register):
+        This instruction ANDs two register values, discards the result and
+        updates the condition flags. Alias of ANDS with XZR destination.
+
+            flags = src0 & src1
+
+        Reference: A-profile: section C6.2.372, page C6-2279
+        """
+        src0_str, src1_str = self._reg_to_str(src0), self._reg_to_str(src1)
+        self.emit(Instruction(
+            template="tst {src0}, {src1}",
+            dsts=[],
+            srcs=[src0_str, src1_str],
+            kwargs=dict(src0=src0_str, src1=src1_str)
+        ))
+
+    def CSET(self, dst: RegArg, cond: str):
+        """
+        Conditional set:
+        This instruction writes one to the destination register if the
+        condition holds and zero otherwise. Alias of CSINC with XZR sources.
+
+            dst = cond ? 1 : 0
+
+        Reference: A-profile: section C6.2.76, page C6-1903
+        """
+        cond = check_condition("cset", cond, always=False)
+        dst_str = self._reg_to_str(dst)
+        self.emit(Instruction(
+            template="cset {dst}, {cond}",
+            dsts=[dst_str],
+            srcs=[],
+            kwargs=dict(dst=dst_str, cond=cond)
+        ))
+
+    def CSETM(self, dst: RegArg, cond: str):
+        """
+        Conditional set mask:
+        This instruction sets every bit of the destination register if the
+        condition holds and clears it otherwise. Alias of CSINV with XZR sources.
+
+            dst = cond ? ~0 : 0
+
+        Turns a borrow into an all-ones mask for branchless selection.
+        Reference: A-profile: section C6.2.77, page C6-1904
+        """
+        cond = check_condition("csetm", cond, always=False)
+        dst_str = self._reg_to_str(dst)
+        self.emit(Instruction(
+            template="csetm {dst}, {cond}",
+            dsts=[dst_str],
+            srcs=[],
+            kwargs=dict(dst=dst_str, cond=cond)
+        ))
+
+    def CSEL(self, dst: RegArg, src0: RegArg, src1: RegArg, cond: str):
+        """
+        Conditional select:
+        This instruction writes the first source register if the condition
+        holds and the second source register otherwise.
+
+            dst = cond ? src0 : src1
+
+        Reference: A-profile: section C6.2.74, page C6-1901
+        """
+        cond = check_condition("csel", cond)
+        dst_str, src0_str, src1_str = self._reg_to_str(dst), self._reg_to_str(src0), self._reg_to_str(src1)
+        self.emit(Instruction(
+            template="csel {dst}, {src0}, {src1}, {cond}",
+            dsts=[dst_str],
+            srcs=[src0_str, src1_str],
+            kwargs=dict(dst=dst_str, src0=src0_str, src1=src1_str, cond=cond)
+        ))
+
+    def CINC(self, dst: RegArg, src: RegArg, cond: str):
+        """
+        Conditional increment:
+        This instruction writes the source register plus one if the condition
+        holds and the source register otherwise. Alias of CSINC.
+
+            dst = cond ? src + 1 : src
+
+        Reference: A-profile: section C6.2.69, page C6-1896
+        """
+        cond = check_condition("cinc", cond, always=False)
+        dst_str, src_str = self._reg_to_str(dst), self._reg_to_str(src)
+        self.emit(Instruction(
+            template="cinc {dst}, {src}, {cond}",
+            dsts=[dst_str],
+            srcs=[src_str],
+            kwargs=dict(dst=dst_str, src=src_str, cond=cond)
+        ))
+
+    def CNEG(self, dst: RegArg, src: RegArg, cond: str):
+        """
+        Conditional negate:
+        This instruction writes the negated source register if the condition
+        holds and the source register otherwise. Alias of CSNEG.
+
+            dst = cond ? -src : src
+
+        Reference: A-profile: section C6.2.63, page C6-1891
+        """
+        cond = check_condition("cneg", cond, always=False)
+        dst_str, src_str = self._reg_to_str(dst), self._reg_to_str(src)
+        self.emit(Instruction(
+            template="cneg {dst}, {src}, {cond}",
+            dsts=[dst_str],
+            srcs=[src_str],
+            kwargs=dict(dst=dst_str, src=src_str, cond=cond)
+        ))
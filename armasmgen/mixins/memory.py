@@ -1,11 +1,31 @@
 # asm_printer/mixins/memory.py
 from ..core import Instruction, RegArg
-from ..register import Register, RegisterType, RegisterWidth
+from ..register import Register, RegisterType, RegisterWidth, VReg, VElem
 from typing import TYPE_CHECKING
 
 if TYPE_CHECKING:
     from ..register import Register
 
+# Prefetch operations PRFM accepts (the prefetch pass checks its hints against the same set)
+PREFETCH_OPS = {f"{kind}l{level}{policy}" for kind in ("pld", "pli", "pst")
+                for level in (1, 2, 3) for policy in ("keep", "strm")}
+
+
+def prefetch_instruction(op: str, base: str, offset: int = 0) -> Instruction:
+    """prfm op, [base, #offset], or prfum when the offset is negative or not a multiple of 8"""
+    if op not in PREFETCH_OPS:
+        raise ValueError(f"PRFM operation must be (pld|pli|pst)l(1|2|3)(keep|strm), got '{op}'")
+    if not (-256 <= offset <= 255 or (offset % 8 == 0 and 0 <= offset <= 32760)):
+        raise ValueError("PRFM offset must be in range [-256, 255] or 8-byte aligned in [0, 32760]")
+    scaled = offset % 8 == 0 and offset >= 0
+    return Instruction(
+        template=f"{'prfm' if scaled else 'prfum'} {{op}}, [{{base}}, #{{offset}}]",
+        dsts=[],
+        srcs=[base],
+        kwargs=dict(op=op, base=base, offset=offset)
+    )
+
+
 class MemoryMixin:
     def emit(self, inst: Instruction): ...
     def _reg_to_str(self, reg: RegArg) -> str: ...  # 型別提示
@@ -173,6 +193,18 @@ class MemoryMixin:
             kwargs=dict(src1=src1_str, src2=src2_str, base=base_str, offset=offset)
         ))
 
+    def STP_post(self, src1: RegArg, src2: RegArg, base: RegArg, offset: int):
+        """Store pair with post-increment: stp src1, src2, [base], #offset"""
+        if offset % 8 != 0 or not (-512 <= offset <= 504):
+            raise ValueError("STP post-increment offset must be 8-byte aligned and in range [-512, 504]")
+        src1_str, src2_str, base_str = self._reg_to_str(src1), self._reg_to_str(src2), self._reg_to_str(base)
+        self.emit(Instruction(
+            template="stp {src1}, {src2}, [{base}], #{offset}",
+            dsts=[base_str],
+            srcs=[src1_str, src2_str, base_str],
+            kwargs=dict(src1=src1_str, src2=src2_str, base=base_str, offset=offset)
+        ))
+
     def LDP_post(self, dst1: RegArg, dst2: RegArg, base: RegArg, offset: int):
         """Load pair with post-increment: ldp dst1, dst2, [base], #offset"""
         if offset % 8 != 0 or not (-512 <= offset <= 504):
@@ -185,6 +217,70 @@ class MemoryMixin:
             kwargs=dict(dst1=dst1_str, dst2=dst2_str, base=base_str, offset=offset)
         ))
 
+    def LDRB(self, dst: RegArg, addr: RegArg):
+        """Load byte, zero-extended: ldrb wN, [addr]"""
+        dst_str, addr_str = self._reg_to_str(dst), self._reg_to_str(addr)
+        self.emit(Instruction(
+            template="ldrb {dst}, [{addr}]",
+            dsts=[dst_str],
+            srcs=[addr_str],
+            kwargs=dict(dst=dst_str, addr=addr_str)
+        ))
+
+    def LDRB_offset(self, dst: RegArg, base: RegArg, offset: int):
+        """Load byte with immediate offset: ldrb wN, [base, #offset]"""
+        if not (-256 <= offset <= 4095):
+            raise ValueError("LDRB offset must be in range [-256, 4095]")
+        dst_str, base_str = self._reg_to_str(dst), self._reg_to_str(base)
+        self.emit(Instruction(
+            template="ldrb {dst}, [{base}, #{offset}]",
+            dsts=[dst_str],
+            srcs=[base_str],
+            kwargs=dict(dst=dst_str, base=base_str, offset=offset)
+        ))
+
+    def STRB(self, src: RegArg, addr: RegArg):
+        """Store the low byte: strb wN, [addr]"""
+        src_str, addr_str = self._reg_to_str(src), self._reg_to_str(addr)
+        self.emit(Instruction(
+            template="strb {src}, [{addr}]",
+            dsts=[],
+            srcs=[src_str, addr_str],
+            kwargs=dict(src=src_str, addr=addr_str)
+        ))
+
+    def STRB_offset(self, src: RegArg, base: RegArg, offset: int):
+        """Store the low byte with immediate offset: strb wN, [base, #offset]"""
+        if not (-256 <= offset <= 4095):
+            raise ValueError("STRB offset must be in range [-256, 4095]")
+        src_str, base_str = self._reg_to_str(src), self._reg_to_str(base)
+        self.emit(Instruction(
+            template="strb {src}, [{base}, #{offset}]",
+            dsts=[],
+            srcs=[src_str, base_str],
+            kwargs=dict(src=src_str, base=base_str, offset=offset)
+        ))
+
+    def PRFM(self, op: str, base: RegArg, offset: int = 0):
+        """Prefetch hint: prfm op, [base, #offset] (op: pldl1keep, pstl2strm, ...); PRFUM when the offset is unscaled"""
+        self.emit(prefetch_instruction(op, self._reg_to_str(base), offset))
+
+    def DC_ZVA(self, addr: RegArg):
+        """
+        Zero a whole block of memory: dc zva, addr
+
+        The block is 4 << DCZID_EL0[3:0] bytes (64 on most cores) and must be
+        aligned; bit 4 of DCZID_EL0 set means the instruction is prohibited.
+        Zeroing without a read for ownership makes it the fastest memset(0).
+        """
+        addr_str = self._validate_general_register(addr, "addr")
+        self.emit(Instruction(
+            template="dc zva, {addr}",
+            dsts=[],
+            srcs=[addr_str],
+            kwargs=dict(addr=addr_str)
+        ))
+
     # Vector Memory Operations with Register Validation
     def _validate_vector_register(self, reg: RegArg, param_name: str) -> str:
         """Validate vector register and return string representation"""
@@ -339,6 +435,43 @@ class MemoryMixin:
             kwargs=dict(src1=src1_str, src2=src2_str, base=base_str, offset=offset)
         ))
 
+    def LDNP_vector(self, dst1: RegArg, dst2: RegArg, base: RegArg, offset: int = 0):
+        """Load pair of vectors, non-temporal hint: ldnp qN1, qN2, [base, #offset]"""
+        if offset % 16 != 0 or not (-1024 <= offset <= 1008):
+            raise ValueError("LDNP vector offset must be 16-byte aligned and in range [-1024, 1008]")
+        dst1_str = self._validate_vector_register(dst1, "dst1")
+        dst2_str = self._validate_vector_register(dst2, "dst2")
+        base_str = self._validate_general_register(base, "base")
+        dst1_str = self._convert_to_q_register(dst1_str)
+        dst2_str = self._convert_to_q_register(dst2_str)
+        self.emit(Instruction(
+            template="ldnp {dst1}, {dst2}, [{base}, #{offset}]",
+            dsts=[dst1_str, dst2_str],
+            srcs=[base_str],
+            kwargs=dict(dst1=dst1_str, dst2=dst2_str, base=base_str, offset=offset)
+        ))
+
+    def STNP_vector(self, src1: RegArg, src2: RegArg, base: RegArg, offset: int = 0):
+        """
+        Store pair of vectors, non-temporal hint: stnp qN1, qN2, [base, #offset]
+
+        The data is not expected to be read again soon, so the core may stream
+        it to memory instead of filling the caches with it (large copies).
+        """
+        if offset % 16 != 0 or not (-1024 <= offset <= 1008):
+            raise ValueError("STNP vector offset must be 16-byte aligned and in range [-1024, 1008]")
+        src1_str = self._validate_vector_register(src1, "src1")
+        src2_str = self._validate_vector_register(src2, "src2")
+        base_str = self._validate_general_register(base, "base")
+        src1_str = self._convert_to_q_register(src1_str)
+        src2_str = self._convert_to_q_register(src2_str)
+        self.emit(Instruction(
+            template="stnp {src1}, {src2}, [{base}, #{offset}]",
+            dsts=[],
+            srcs=[src1_str, src2_str, base_str],
+            kwargs=dict(src1=src1_str, src2=src2_str, base=base_str, offset=offset)
+        ))
+
     def LDR_Q(self, dst: RegArg, addr: RegArg):
         """Load Q register (explicit 128-bit): ldr qN, [addr]"""
         dst_str = self._validate_vector_register(dst, "dst")
@@ -363,4 +496,116 @@ class MemoryMixin:
             dsts=[],
             srcs=[src_str, addr_str],
             kwargs=dict(src=src_str, addr=addr_str)
-        ))
\ No newline at end of file
+        ))
+
+    # LD1-LD4/ST1-ST4 structured load and store instructions
+    # The register list is spelled out in the template: it must stay consecutive,
+    # so the renaming passes leave its registers alone.
+    def _structured(self, mnemonic: str, n: int, regs, base: RegArg, post, load: bool, replicate: bool = False):
+        regs = list(regs) if isinstance(regs, (list, tuple)) else [regs]
+        count = len(regs)
+        if not (1 <= count <= 4 if n == 1 and not replicate else count == n):
+            raise ValueError(f"{mnemonic} takes {'1-4' if n == 1 and not replicate else n} registers, got {count}")
+        lanes = all(isinstance(r, VElem) for r in regs)
+        if lanes and replicate:
+            raise TypeError(f"{mnemonic} replicates into whole registers; pass VReg operands, not elements")
+        if not lanes and not all(isinstance(r, VReg) for r in regs):
+            raise TypeError(f"{mnemonic} registers must be all VReg (v_reg(0).s4) or all VElem (v_reg(0).s4[1]), "
+                            f"got {', '.join(map(repr, regs))}")
+        if any((regs[i].number - regs[0].number) % 32 != i for i in range(count)):
+            raise ValueError(f"{mnemonic} register list must be consecutive: {', '.join(map(str, regs))}")
+
+        if lanes:
+            esize, index = regs[0].esize, regs[0].index
+            if any(r.esize != esize or r.index != index for r in regs):
+                raise ValueError(f"{mnemonic} lanes must share one element size and index: {', '.join(map(str, regs))}")
+            names = [str(r).split("[")[0] for r in regs]
+            reg_list = "{{" + ", ".join(names) + "}}" + f"[{index}]"
+            size = esize // 8
+        else:
+            arrangement = regs[0].arrangement
+            if any(r.arrangement != arrangement for r in regs):
+                raise ValueError(f"{mnemonic} registers must share one arrangement: {', '.join(map(str, regs))}")
+            if arrangement == "1D" and n > 1 and not replicate:
+                raise ValueError(f"{mnemonic} has no 1D form")
+            names = [str(r) for r in regs]
+            reg_list = "{{" + ", ".join(names) + "}}"
+            size = regs[0].esize // 8 if replicate else regs[0].bits // 8
+
+        base_str = self._validate_general_register(base, "base")
+        template = f"{mnemonic} {reg_list}, [{{base}}]"
+        kwargs = dict(base=base_str)
+        dsts = list(names) if load else []
+        srcs = [base_str] + (names if not load or lanes else [])
+        if post is not None:
+            if isinstance(post, int):
+                if post != size * count:
+                    raise ValueError(f"{mnemonic} post-increment immediate must be the transfer size {size * count}, got {post}")
+                template += ", #{offset}"
+                kwargs["offset"] = post
+            else:
+                step_str = self._validate_general_register(post, "post")
+                if not step_str.startswith("x") or step_str == "xzr":
+                    raise ValueError(f"{mnemonic} post-increment register must be x0-x30, got '{step_str}'")
+                template += ", {step}"
+                kwargs["step"] = step_str
+                srcs.append(step_str)
+            dsts.append(base_str)
+        self.emit(Instruction(template=template, dsts=dsts, srcs=srcs, kwargs=kwargs))
+
+    def LD1(self, regs, base: RegArg, post=None):
+        """
+        Load 1-4 consecutive registers from consecutive memory, or one lane:
+
+            LD1([v_reg(0).b16, v_reg(1).b16, v_reg(2).b16, v_reg(3).b16], "x0", 64)
+                ld1 {v0.16B, v1.16B, v2.16B, v3.16B}, [x0], #64
+            LD1(v_reg(0).s4[1], "x1")
+                ld1 {v0.S}[1], [x1]              (other lanes kept)
+
+        post is None, the transfer size in bytes, or an x register added to base.
+        """
+        self._structured("ld1", 1, regs, base, post, load=True)
+
+    def LD2(self, regs, base: RegArg, post=None):
+        """De-interleave pairs: element 2i goes to regs[0][i], element 2i+1 to regs[1][i] (or one lane of each)"""
+        self._structured("ld2", 2, regs, base, post, load=True)
+
+    def LD3(self, regs, base: RegArg, post=None):
+        """De-interleave triples (array of 3-element structures to 3 registers), or one lane of each"""
+        self._structured("ld3", 3, regs, base, post, load=True)
+
+    def LD4(self, regs, base: RegArg, post=None):
+        """De-interleave quadruples (array of 4-element structures to 4 registers), or one lane of each"""
+        self._structured("ld4", 4, regs, base, post, load=True)
+
+    def LD1R(self, regs, base: RegArg, post=None):
+        """Load one element and replicate it to every lane: ld1r {v0.4S}, [x0]"""
+        self._structured("ld1r", 1, regs, base, post, load=True, replicate=True)
+
+    def LD2R(self, regs, base: RegArg, post=None):
+        """Load one 2-element structure, each element replicated across one register"""
+        self._structured("ld2r", 2, regs, base, post, load=True, replicate=True)
+
+    def LD3R(self, regs, base: RegArg, post=None):
+        """Load one 3-element structure, each element replicated across one register"""
+        self._structured("ld3r", 3, regs, base, post, load=True, replicate=True)
+
+    def LD4R(self, regs, base: RegArg, post=None):
+        """Load one 4-element structure, each element replicated across one register"""
+        self._structured("ld4r", 4, regs, base, post, load=True, replicate=True)
+
+    def ST1(self, regs, base: RegArg, post=None):
+        """Store 1-4 consecutive registers to consecutive memory, or one lane (see LD1)"""
+        self._structured("st1", 1, regs, base, post, load=False)
+
+    def ST2(self, regs, base: RegArg, post=None):
+        """Interleave two registers into pairs in memory, or store one lane of each"""
+        self._structured("st2", 2, regs, base, post, load=False)
+
+    def ST3(self, regs, base: RegArg, post=None):
+        """Interleave three registers into 3-element structures, or store one lane of each"""
+        self._structured("st3", 3, regs, base, post, load=False)
+
+    def ST4(self, regs, base: RegArg, post=None):
+        """Interleave four registers into 4-element structures, or store one lane of each"""
+        self._structured("st4", 4, regs, base, post, load=False)
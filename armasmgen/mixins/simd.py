@@ -0,0 +1,596 @@
+# armasmgen/mixins/simd.py
+from ..core import Instruction, RegArg
+from ..register import Register, RegisterType, VReg, VElem
+from typing import Optional
+
+# Arrangements by group; the vector forms have no 1D except where noted
+_ALL = ("8B", "16B", "4H", "8H", "2S", "4S", "2D")
+_NO_D = ("8B", "16B", "4H", "8H", "2S", "4S")
+_FP = ("2S", "4S", "2D")
+_BYTES = {64: "8B", 128: "16B"}
+
+
+class SIMDMixin:
+    """
+    Arrangement-generic NEON instructions on VReg operands.
+
+        f.VADD(v_reg(0).s4, v_reg(1).s4, v_reg(2).s4)      # add v0.4S, v1.4S, v2.4S
+        f.VUMLAL(v_reg(4).d2, v_reg(0).s4, v_reg(1).s4)    # umlal2 v4.2D, v0.4S, v1.4S
+        f.VFMLA(v_reg(8).s4, v_reg(9).s4, v_reg(3).s4[1])  # fmla v8.4S, v9.4S, v3.S[1]
+
+    The arrangement travels with the operand, so an instruction checks only
+    that its operands agree and that the arrangement exists for it. Operands
+    that are not VReg raise TypeError, arrangements the instruction lacks
+    raise ValueError. Widening and narrowing instructions pick the "2" form
+    (upper half) from the operand that is 128 bits wide.
+    """
+
+    def emit(self, inst: Instruction): ...  # Type hint
+    def _reg_to_str(self, reg: RegArg) -> str: ...  # Type hint
+
+    def _simd(self, mnemonic: str, dst: str, *srcs: str, imm: Optional[int] = None, reads_dst: bool = False):
+        """Emit `mnemonic dst, srcs...[, #imm]` on rendered operands; reads_dst for accumulating forms."""
+        names = [f"src{i}" for i in range(len(srcs))]
+        operands = ", ".join(["{dst}"] + ["{" + n + "}" for n in names])
+        kwargs = dict(dst=dst, **dict(zip(names, srcs)))
+        if imm is not None:
+            operands += ", #{imm}"
+            kwargs["imm"] = imm
+        self.emit(Instruction(
+            template=f"{mnemonic} {operands}",
+            dsts=[dst],
+            srcs=([dst] if reads_dst else []) + list(srcs),
+            kwargs=kwargs
+        ))
+
+    # ---------- operand checks ----------
+    @staticmethod
+    def _vregs(mnemonic: str, **regs) -> None:
+        for name, reg in regs.items():
+            if not isinstance(reg, VReg):
+                raise TypeError(f"{mnemonic} parameter '{name}' must be an arranged vector register "
+                                f"such as v_reg(0).s4, got {reg!r}")
+
+    def _same(self, mnemonic: str, allowed: tuple, **regs) -> VReg:
+        """All operands VReg with one arrangement from allowed; returns the first."""
+        self._vregs(mnemonic, **regs)
+        first = next(iter(regs.values()))
+        for reg in regs.values():
+            if reg.arrangement != first.arrangement:
+                raise ValueError(f"{mnemonic} operands must share one arrangement: "
+                                 f"{', '.join(f'{n}={r}' for n, r in regs.items())}")
+        if first.arrangement not in allowed:
+            raise ValueError(f"{mnemonic} has no {first.arrangement} form, expected one of {', '.join(allowed)}")
+        return first
+
+    @staticmethod
+    def _element(mnemonic: str, vec: VReg, elem) -> None:
+        """By-element operand: same element size, H, S or D, and v0-v15 for 16-bit elements."""
+        if not isinstance(elem, VElem):
+            raise TypeError(f"{mnemonic} by-element operand must be a VElem such as v_reg(2).s4[1], got {elem!r}")
+        if elem.esize == 8:
+            raise ValueError(f"{mnemonic} has no by-element form for 8-bit lanes")
+        if elem.esize != vec.esize:
+            raise ValueError(f"{mnemonic} element {elem} does not match {vec.esize}-bit lanes of {vec}")
+        if elem.esize == 16 and elem.number > 15:
+            raise ValueError(f"{mnemonic} with 16-bit elements takes the element from v0-v15, not {elem}")
+
+    @staticmethod
+    def _shift(mnemonic: str, shift: int, low: int, high: int) -> None:
+        if not low <= shift <= high:
+            raise ValueError(f"{mnemonic} shift must be in range [{low}, {high}], got {shift}")
+
+    def _scalar_d(self, mnemonic: str, d: VReg, *srcs: VReg, imm: Optional[int] = None, reads_dst: bool = False):
+        """1D has no vector form; the same operation is the scalar one on d registers."""
+        self._simd(mnemonic, f"d{d.number}", *[f"d{r.number}" for r in srcs], imm=imm, reads_dst=reads_dst)
+
+    def _three(self, mnemonic: str, allowed: tuple, d: VReg, n: VReg, m, accumulate: bool = False,
+               by_element: bool = False):
+        """Same-arrangement d, n, m; m may be a VElem where the instruction has a by-element form."""
+        if by_element and isinstance(m, VElem):
+            self._same(mnemonic, allowed, d=d, n=n)
+            self._element(mnemonic, n, m)
+        else:
+            self._same(mnemonic, allowed, d=d, n=n, m=m)
+        self._simd(mnemonic, str(d), str(n), str(m), reads_dst=accumulate)
+
+    def _widening(self, mnemonic: str, d: VReg, n: VReg, m=None, imm: Optional[int] = None,
+                  accumulate: bool = False, by_element: bool = False):
+        """d has twice the element size of n (and m); a 128-bit n selects the upper-half "2" form."""
+        regs = dict(d=d, n=n) if m is None or isinstance(m, VElem) else dict(d=d, n=n, m=m)
+        self._vregs(mnemonic, **regs)
+        if n.esize == 64 or d.bits != 128 or d.esize != 2 * n.esize:
+            raise ValueError(f"{mnemonic} widens {n.esize}-bit lanes into a 128-bit register of "
+                             f"{2 * n.esize}-bit lanes, got {d} from {n}")
+        if isinstance(m, VElem) and by_element:
+            self._element(mnemonic, n, m)
+        elif m is not None and (not isinstance(m, VReg) or m.esize != n.esize):
+            raise ValueError(f"{mnemonic} operands {n} and {m} must have the same element size")
+        name = mnemonic + ("2" if n.bits == 128 else "")
+        srcs = (str(n),) if m is None else (str(n), str(m))
+        self._simd(name, str(d), *srcs, imm=imm, reads_dst=accumulate)
+
+    def _narrowing(self, mnemonic: str, d: VReg, n: VReg, imm: Optional[int] = None):
+        """n has twice the element size of d; a 128-bit d fills its upper half ("2" form, keeps the lower)."""
+        self._vregs(mnemonic, d=d, n=n)
+        if d.esize == 64 or n.bits != 128 or n.esize != 2 * d.esize:
+            raise ValueError(f"{mnemonic} narrows a 128-bit register of {2 * d.esize}-bit lanes "
+                             f"into {d.esize}-bit lanes, got {d} from {n}")
+        upper = d.bits == 128
+        self._simd(mnemonic + ("2" if upper else ""), str(d), str(n), imm=imm, reads_dst=upper)
+
+    # ---------- integer arithmetic ----------
+    def VADD(self, d: VReg, n: VReg, m: VReg):
+        """Vd[i] = Vn[i] + Vm[i]; 1D is emitted as the scalar add d, d, d"""
+        if self._same("add", _ALL + ("1D",), d=d, n=n, m=m).arrangement == "1D":
+            return self._scalar_d("add", d, n, m)
+        self._simd("add", str(d), str(n), str(m))
+
+    def VSUB(self, d: VReg, n: VReg, m: VReg):
+        """Vd[i] = Vn[i] - Vm[i]; 1D is emitted as the scalar sub d, d, d"""
+        if self._same("sub", _ALL + ("1D",), d=d, n=n, m=m).arrangement == "1D":
+            return self._scalar_d("sub", d, n, m)
+        self._simd("sub", str(d), str(n), str(m))
+
+    def VNEG(self, d: VReg, n: VReg):
+        """Vd[i] = -Vn[i]"""
+        self._same("neg", _ALL, d=d, n=n)
+        self._simd("neg", str(d), str(n))
+
+    def VMUL(self, d: VReg, n: VReg, m):
+        """Vd[i] = Vn[i] * Vm[i] (low half of the product); m may be an element, v_reg(2).h8[3]"""
+        self._three("mul", _NO_D, d, n, m, by_element=True)
+
+    def VMLA(self, d: VReg, n: VReg, m):
+        """Vd[i] += Vn[i] * Vm[i]; m may be an element"""
+        self._three("mla", _NO_D, d, n, m, accumulate=True, by_element=True)
+
+    def VMLS(self, d: VReg, n: VReg, m):
+        """Vd[i] -= Vn[i] * Vm[i]; m may be an element"""
+        self._three("mls", _NO_D, d, n, m, accumulate=True, by_element=True)
+
+    def VUMIN(self, d: VReg, n: VReg, m: VReg):
+        """Unsigned minimum: Vd[i] = min(Vn[i], Vm[i])"""
+        self._three("umin", _NO_D, d, n, m)
+
+    def VUMAX(self, d: VReg, n: VReg, m: VReg):
+        """Unsigned maximum: Vd[i] = max(Vn[i], Vm[i])"""
+        self._three("umax", _NO_D, d, n, m)
+
+    def VSMIN(self, d: VReg, n: VReg, m: VReg):
+        """Signed minimum: Vd[i] = min(Vn[i], Vm[i])"""
+        self._three("smin", _NO_D, d, n, m)
+
+    def VSMAX(self, d: VReg, n: VReg, m: VReg):
+        """Signed maximum: Vd[i] = max(Vn[i], Vm[i])"""
+        self._three("smax", _NO_D, d, n, m)
+
+    # ---------- compares: all-ones lanes where true ----------
+    def _compare(self, mnemonic: str, d: VReg, n: VReg, m, zero_form: bool):
+        if isinstance(m, int) and not isinstance(m, bool):
+            if not zero_form or m != 0:
+                raise ValueError(f"{mnemonic} compares against a register" + (" or #0" if zero_form else ""))
+            self._same(mnemonic, _ALL, d=d, n=n)
+            return self._simd(mnemonic, str(d), str(n), imm=0)
+        self._three(mnemonic, _ALL, d, n, m)
+
+    def VCMEQ(self, d: VReg, n: VReg, m):
+        """Vd[i] = Vn[i] == Vm[i] ? ~0 : 0; m may be 0"""
+        self._compare("cmeq", d, n, m, zero_form=True)
+
+    def VCMGT(self, d: VReg, n: VReg, m):
+        """Signed Vn[i] > Vm[i]; m may be 0"""
+        self._compare("cmgt", d, n, m, zero_form=True)
+
+    def VCMGE(self, d: VReg, n: VReg, m):
+        """Signed Vn[i] >= Vm[i]; m may be 0"""
+        self._compare("cmge", d, n, m, zero_form=True)
+
+    def VCMHI(self, d: VReg, n: VReg, m: VReg):
+        """Unsigned Vn[i] > Vm[i]"""
+        self._compare("cmhi", d, n, m, zero_form=False)
+
+    def VCMHS(self, d: VReg, n: VReg, m: VReg):
+        """Unsigned Vn[i] >= Vm[i]"""
+        self._compare("cmhs", d, n, m, zero_form=False)
+
+    # ---------- bitwise: any arrangement, emitted as 8B/16B ----------
+    def _bitwise(self, mnemonic: str, *regs: VReg, reads_dst: bool = False):
+        names = ("d", "n", "m")[:len(regs)]
+        self._vregs(mnemonic, **dict(zip(names, regs)))
+        if len({r.bits for r in regs}) != 1:
+            raise ValueError(f"{mnemonic} operands must all be 64 or all 128 bits: {', '.join(map(str, regs))}")
+        arrangement = _BYTES[regs[0].bits]
+        self._simd(mnemonic, *[str(r.arranged(arrangement)) for r in regs], reads_dst=reads_dst)
+
+    def VAND(self, d: VReg, n: VReg, m: VReg):
+        """Vd = Vn & Vm"""
+        self._bitwise("and", d, n, m)
+
+    def VORR(self, d: VReg, n: VReg, m: VReg):
+        """Vd = Vn | Vm"""
+        self._bitwise("orr", d, n, m)
+
+    def VEOR(self, d: VReg, n: VReg, m: VReg):
+        """Vd = Vn ^ Vm"""
+        self._bitwise("eor", d, n, m)
+
+    def VBIC(self, d: VReg, n: VReg, m: VReg):
+        """Vd = Vn & ~Vm"""
+        self._bitwise("bic", d, n, m)
+
+    def VORN(self, d: VReg, n: VReg, m: VReg):
+        """Vd = Vn | ~Vm"""
+        self._bitwise("orn", d, n, m)
+
+    def VBSL(self, d: VReg, n: VReg, m: VReg):
+        """Bitwise select, Vd is the mask: Vd = (Vd & Vn) | (~Vd & Vm)"""
+        self._bitwise("bsl", d, n, m, reads_dst=True)
+
+    def VNOT(self, d: VReg, n: VReg):
+        """Vd = ~Vn"""
+        self._bitwise("not", d, n)
+
+    def VMOV(self, d: VReg, n: VReg):
+        """Register copy, Vd = Vn (orr of Vn with itself)"""
+        self._bitwise("mov", d, n)
+
+    # ---------- shifts ----------
+    def _shift_imm(self, mnemonic: str, d: VReg, n: VReg, shift: int, left: bool, accumulate: bool = False):
+        first = self._same(mnemonic, _ALL + ("1D",), d=d, n=n)
+        self._shift(mnemonic, shift, *((0, first.esize - 1) if left else (1, first.esize)))
+        if first.arrangement == "1D":
+            return self._scalar_d(mnemonic, d, n, imm=shift, reads_dst=accumulate)
+        self._simd(mnemonic, str(d), str(n), imm=shift, reads_dst=accumulate)
+
+    def VSHL(self, d: VReg, n: VReg, shift: int):
+        """Vd[i] = Vn[i] << shift, shift in [0, esize - 1]"""
+        self._shift_imm("shl", d, n, shift, left=True)
+
+    def VUSHR(self, d: VReg, n: VReg, shift: int):
+        """Logical Vd[i] = Vn[i] >> shift, shift in [1, esize]"""
+        self._shift_imm("ushr", d, n, shift, left=False)
+
+    def VSSHR(self, d: VReg, n: VReg, shift: int):
+        """Arithmetic Vd[i] = Vn[i] >> shift, shift in [1, esize]"""
+        self._shift_imm("sshr", d, n, shift, left=False)
+
+    def VUSRA(self, d: VReg, n: VReg, shift: int):
+        """Vd[i] += Vn[i] >> shift (logical)"""
+        self._shift_imm("usra", d, n, shift, left=False, accumulate=True)
+
+    def VSSRA(self, d: VReg, n: VReg, shift: int):
+        """Vd[i] += Vn[i] >> shift (arithmetic)"""
+        self._shift_imm("ssra", d, n, shift, left=False, accumulate=True)
+
+    def VUSHL(self, d: VReg, n: VReg, m: VReg):
+        """Vd[i] = Vn[i] shifted by the signed low byte of Vm[i]: left if positive, logical right if negative"""
+        self._three("ushl", _ALL, d, n, m)
+
+    def VSSHL(self, d: VReg, n: VReg, m: VReg):
+        """As VUSHL with arithmetic right shifts"""
+        self._three("sshl", _ALL, d, n, m)
+
+    # ---------- widening (d has double-width lanes) ----------
+    def VUMULL(self, d: VReg, n: VReg, m):
+        """Vd[i] = Vn[i] * Vm[i], full product; umull2 when n is 128-bit; m may be an element"""
+        self._widening("umull", d, n, m, by_element=True)
+
+    def VUMLAL(self, d: VReg, n: VReg, m):
+        """Vd[i] += Vn[i] * Vm[i]"""
+        self._widening("umlal", d, n, m, accumulate=True, by_element=True)
+
+    def VUMLSL(self, d: VReg, n: VReg, m):
+        """Vd[i] -= Vn[i] * Vm[i]"""
+        self._widening("umlsl", d, n, m, accumulate=True, by_element=True)
+
+    def VSMULL(self, d: VReg, n: VReg, m):
+        """Signed Vd[i] = Vn[i] * Vm[i]"""
+        self._widening("smull", d, n, m, by_element=True)
+
+    def VSMLAL(self, d: VReg, n: VReg, m):
+        """Signed Vd[i] += Vn[i] * Vm[i]"""
+        self._widening("smlal", d, n, m, accumulate=True, by_element=True)
+
+    def VSMLSL(self, d: VReg, n: VReg, m):
+        """Signed Vd[i] -= Vn[i] * Vm[i]"""
+        self._widening("smlsl", d, n, m, accumulate=True, by_element=True)
+
+    def VUADDL(self, d: VReg, n: VReg, m: VReg):
+        """Vd[i] = Vn[i] + Vm[i], zero-extended"""
+        self._widening("uaddl", d, n, m)
+
+    def VUSUBL(self, d: VReg, n: VReg, m: VReg):
+        """Vd[i] = Vn[i] - Vm[i], zero-extended"""
+        self._widening("usubl", d, n, m)
+
+    def VSADDL(self, d: VReg, n: VReg, m: VReg):
+        """Vd[i] = Vn[i] + Vm[i], sign-extended"""
+        self._widening("saddl", d, n, m)
+
+    def VSSUBL(self, d: VReg, n: VReg, m: VReg):
+        """Vd[i] = Vn[i] - Vm[i], sign-extended"""
+        self._widening("ssubl", d, n, m)
+
+    def VUSHLL(self, d: VReg, n: VReg, shift: int = 0):
+        """Vd[i] = Vn[i] << shift, zero-extended; shift 0 is UXTL"""
+        self._vregs("ushll", d=d, n=n)
+        self._shift("ushll", shift, 0, n.esize - 1)
+        self._widening("ushll", d, n, imm=shift)
+
+    def VSSHLL(self, d: VReg, n: VReg, shift: int = 0):
+        """Vd[i] = Vn[i] << shift, sign-extended; shift 0 is SXTL"""
+        self._vregs("sshll", d=d, n=n)
+        self._shift("sshll", shift, 0, n.esize - 1)
+        self._widening("sshll", d, n, imm=shift)
+
+    # ---------- narrowing (d has half-width lanes) ----------
+    def VXTN(self, d: VReg, n: VReg):
+        """Vd[i] = Vn[i] mod 2^esize(d); xtn2 into the upper half when d is 128-bit"""
+        self._narrowing("xtn", d, n)
+
+    def VUQXTN(self, d: VReg, n: VReg):
+        """Unsigned saturating narrow: Vd[i] = min(Vn[i], 2^esize(d) - 1)"""
+        self._narrowing("uqxtn", d, n)
+
+    def VSQXTN(self, d: VReg, n: VReg):
+        """Signed saturating narrow"""
+        self._narrowing("sqxtn", d, n)
+
+    def VSHRN(self, d: VReg, n: VReg, shift: int):
+        """Vd[i] = (Vn[i] >> shift) mod 2^esize(d), shift in [1, esize(d)]"""
+        self._vregs("shrn", d=d, n=n)
+        self._shift("shrn", shift, 1, d.esize)
+        self._narrowing("shrn", d, n, imm=shift)
+
+    # ---------- pairwise and across lanes ----------
+    def _pairwise_long(self, mnemonic: str, d: VReg, n: VReg, accumulate: bool):
+        """d has half the lanes of n at twice the width, same register size (8B -> 4H, ..., 4S -> 2D)"""
+        self._vregs(mnemonic, d=d, n=n)
+        if n.esize == 64 or d.bits != n.bits or d.esize != 2 * n.esize:
+            raise ValueError(f"{mnemonic} adds pairs of {n.esize}-bit lanes into {2 * n.esize}-bit lanes "
+                             f"of the same register size, got {d} from {n}")
+        self._simd(mnemonic, str(d), str(n), reads_dst=accumulate)
+
+    def _across(self, mnemonic: str, d: VReg, n: VReg, allowed: tuple, widen: bool = False):
+        """Scalar result in the b/h/s/d register numbered like d (twice n's lane width when widening)"""
+        self._vregs(mnemonic, d=d, n=n)
+        if n.arrangement not in allowed:
+            raise ValueError(f"{mnemonic} has no {n.arrangement} form, expected one of {', '.join(allowed)}")
+        esize = 2 * n.esize if widen else n.esize
+        self._simd(mnemonic, f"{'bhsd'[esize.bit_length() - 4]}{d.number}", str(n))
+
+    def VADDP(self, d: VReg, n: VReg, m: Optional[VReg] = None):
+        """
+        Pairwise add: Vd = n0+n1, n2+n3, ..., m0+m1, ...; without m, n is 2D
+        and the scalar addp dD, Vn.2D adds its two lanes.
+        """
+        if m is None:
+            self._same("addp", ("2D",), n=n)
+            self._vregs("addp", d=d)
+            return self._simd("addp", f"d{d.number}", str(n))
+        self._three("addp", _ALL, d, n, m)
+
+    def VUADDLP(self, d: VReg, n: VReg):
+        """Vd[i] = Vn[2i] + Vn[2i+1], zero-extended"""
+        self._pairwise_long("uaddlp", d, n, accumulate=False)
+
+    def VSADDLP(self, d: VReg, n: VReg):
+        """Vd[i] = Vn[2i] + Vn[2i+1], sign-extended"""
+        self._pairwise_long("saddlp", d, n, accumulate=False)
+
+    def VUADALP(self, d: VReg, n: VReg):
+        """Vd[i] += Vn[2i] + Vn[2i+1], zero-extended"""
+        self._pairwise_long("uadalp", d, n, accumulate=True)
+
+    def VSADALP(self, d: VReg, n: VReg):
+        """Vd[i] += Vn[2i] + Vn[2i+1], sign-extended"""
+        self._pairwise_long("sadalp", d, n, accumulate=True)
+
+    def VADDV(self, d: VReg, n: VReg):
+        """Sum of the lanes of n (modulo the lane width) into the scalar bD/hD/sD"""
+        self._across("addv", d, n, ("8B", "16B", "4H", "8H", "4S"))
+
+    def VUADDLV(self, d: VReg, n: VReg):
+        """Sum of the lanes of n, zero-extended, into the scalar of twice the lane width"""
+        self._across("uaddlv", d, n, ("8B", "16B", "4H", "8H", "4S"), widen=True)
+
+    def VSADDLV(self, d: VReg, n: VReg):
+        """Sum of the lanes of n, sign-extended, into the scalar of twice the lane width"""
+        self._across("saddlv", d, n, ("8B", "16B", "4H", "8H", "4S"), widen=True)
+
+    def VUMINV(self, d: VReg, n: VReg):
+        """Unsigned minimum of the lanes of n"""
+        self._across("uminv", d, n, ("8B", "16B", "4H", "8H", "4S"))
+
+    def VUMAXV(self, d: VReg, n: VReg):
+        """Unsigned maximum of the lanes of n"""
+        self._across("umaxv", d, n, ("8B", "16B", "4H", "8H", "4S"))
+
+    def VSMINV(self, d: VReg, n: VReg):
+        """Signed minimum of the lanes of n"""
+        self._across("sminv", d, n, ("8B", "16B", "4H", "8H", "4S"))
+
+    def VSMAXV(self, d: VReg, n: VReg):
+        """Signed maximum of the lanes of n"""
+        self._across("smaxv", d, n, ("8B", "16B", "4H", "8H", "4S"))
+
+    # ---------- dot product (Armv8.2 DotProd) ----------
+    def _dot(self, mnemonic: str, d: VReg, n: VReg, m):
+        """d is 2S/4S, n the same width in bytes; m likewise, or a 32-bit VElem (one group of four bytes)"""
+        self._vregs(mnemonic, d=d, n=n)
+        if d.arrangement not in ("2S", "4S") or n.arrangement != _BYTES[d.bits]:
+            raise ValueError(f"{mnemonic} accumulates groups of four bytes into 32-bit lanes: "
+                             f"2S from 8B or 4S from 16B, got {d} from {n}")
+        if isinstance(m, VElem):
+            if m.esize != 32:
+                raise ValueError(f"{mnemonic} by-element operand selects a 4-byte group, "
+                                 f"write it as a 32-bit element such as v_reg(2).s4[1], got {m}")
+            src = f"v{m.number}.4B[{m.index}]"
+        else:
+            self._same(mnemonic, ("8B", "16B"), n=n, m=m)
+            src = str(m)
+        self._simd(mnemonic, str(d), str(n), src, reads_dst=True)
+
+    def VSDOT(self, d: VReg, n: VReg, m):
+        """Vd[i] += sum of the four signed byte products of group i of Vn and Vm (or of the group Vm.4B[j])"""
+        self._dot("sdot", d, n, m)
+
+    def VUDOT(self, d: VReg, n: VReg, m):
+        """Vd[i] += sum of the four unsigned byte products of group i of Vn and Vm (or of the group Vm.4B[j])"""
+        self._dot("udot", d, n, m)
+
+    # ---------- floating point (2S, 4S, 2D) ----------
+    def VFADD(self, d: VReg, n: VReg, m: VReg):
+        """Vd[i] = Vn[i] + Vm[i]"""
+        self._three("fadd", _FP, d, n, m)
+
+    def VFSUB(self, d: VReg, n: VReg, m: VReg):
+        """Vd[i] = Vn[i] - Vm[i]"""
+        self._three("fsub", _FP, d, n, m)
+
+    def VFMUL(self, d: VReg, n: VReg, m):
+        """Vd[i] = Vn[i] * Vm[i]; m may be an element"""
+        self._three("fmul", _FP, d, n, m, by_element=True)
+
+    def VFDIV(self, d: VReg, n: VReg, m: VReg):
+        """Vd[i] = Vn[i] / Vm[i]"""
+        self._three("fdiv", _FP, d, n, m)
+
+    def VFMAX(self, d: VReg, n: VReg, m: VReg):
+        """Vd[i] = max(Vn[i], Vm[i])"""
+        self._three("fmax", _FP, d, n, m)
+
+    def VFMIN(self, d: VReg, n: VReg, m: VReg):
+        """Vd[i] = min(Vn[i], Vm[i])"""
+        self._three("fmin", _FP, d, n, m)
+
+    def VFMLA(self, d: VReg, n: VReg, m):
+        """Fused Vd[i] += Vn[i] * Vm[i], one rounding; m may be an element"""
+        self._three("fmla", _FP, d, n, m, accumulate=True, by_element=True)
+
+    def VFMLS(self, d: VReg, n: VReg, m):
+        """Fused Vd[i] -= Vn[i] * Vm[i]; m may be an element"""
+        self._three("fmls", _FP, d, n, m, accumulate=True, by_element=True)
+
+    def VFNEG(self, d: VReg, n: VReg):
+        """Vd[i] = -Vn[i]"""
+        self._same("fneg", _FP, d=d, n=n)
+        self._simd("fneg", str(d), str(n))
+
+    def VFABS(self, d: VReg, n: VReg):
+        """Vd[i] = |Vn[i]|"""
+        self._same("fabs", _FP, d=d, n=n)
+        self._simd("fabs", str(d), str(n))
+
+    def VFSQRT(self, d: VReg, n: VReg):
+        """Vd[i] = sqrt(Vn[i])"""
+        self._same("fsqrt", _FP, d=d, n=n)
+        self._simd("fsqrt", str(d), str(n))
+
+    def VFCMEQ(self, d: VReg, n: VReg, m: VReg):
+        """Vd[i] = Vn[i] == Vm[i] ? ~0 : 0"""
+        self._three("fcmeq", _FP, d, n, m)
+
+    def VFCMGE(self, d: VReg, n: VReg, m: VReg):
+        """Vd[i] = Vn[i] >= Vm[i] ? ~0 : 0"""
+        self._three("fcmge", _FP, d, n, m)
+
+    def VFCMGT(self, d: VReg, n: VReg, m: VReg):
+        """Vd[i] = Vn[i] > Vm[i] ? ~0 : 0"""
+        self._three("fcmgt", _FP, d, n, m)
+
+    # ---------- moves and permutes ----------
+    def VDUP(self, d: VReg, src):
+        """
+        Broadcast into every lane of d: from a general register (w for 8-32-bit
+        lanes, x for 64-bit) or from an element, v_reg(1).s4[2].
+        """
+        self._same("dup", _ALL, d=d)
+        if isinstance(src, VElem):
+            if src.esize != d.esize:
+                raise ValueError(f"dup element {src} does not match the {d.esize}-bit lanes of {d}")
+            return self._simd("dup", str(d), str(src))
+        src_str = self._reg_to_str(src)
+        if isinstance(src, Register) and src.reg_type != RegisterType.GENERAL:
+            raise TypeError(f"dup source must be a general register or a VElem, got {src.reg_type.value} register '{src_str}'")
+        expected = "x" if d.esize == 64 else "w"
+        if not src_str.lower().startswith(expected):
+            raise ValueError(f"dup into {d.esize}-bit lanes takes a {expected} register, got '{src_str}'")
+        self._simd("dup", str(d), src_str)
+
+    def VUMOV(self, Rd: RegArg, src: VElem):
+        """Element to general register, zero-extended: w for 8-32-bit elements, x for 64-bit"""
+        if not isinstance(src, VElem):
+            raise TypeError(f"umov source must be a VElem such as v_reg(1).d2[1], got {src!r}")
+        dst_str = self._reg_to_str(Rd)
+        expected = "x" if src.esize == 64 else "w"
+        if not dst_str.lower().startswith(expected):
+            raise ValueError(f"umov of a {src.esize}-bit element writes a {expected} register, got '{dst_str}'")
+        self._simd("umov", dst_str, str(src))
+
+    def VSMOV(self, Rd: RegArg, src: VElem):
+        """Element to general register, sign-extended: w or x for 8- and 16-bit elements, x for 32-bit"""
+        if not isinstance(src, VElem):
+            raise TypeError(f"smov source must be a VElem such as v_reg(1).h8[1], got {src!r}")
+        if src.esize == 64:
+            raise ValueError(f"smov has no 64-bit form, use VUMOV for {src}")
+        dst_str = self._reg_to_str(Rd)
+        if dst_str.lower()[0] not in ("x" if src.esize == 32 else "wx"):
+            raise ValueError(f"smov of a {src.esize}-bit element writes "
+                             f"{'a w or x' if src.esize < 32 else 'an x'} register, got '{dst_str}'")
+        self._simd("smov", dst_str, str(src))
+
+    def VMOVI(self, d: VReg, imm: int):
+        """
+        Vd[i] = imm: an 8-bit value for B, H and S lanes; for 2D a 64-bit value
+        whose bytes are each 0x00 or 0xFF.
+        """
+        first = self._same("movi", _ALL, d=d)
+        if first.esize == 64:
+            if not 0 <= imm < 1 << 64 or any((imm >> s) & 0xFF not in (0, 0xFF) for s in range(0, 64, 8)):
+                raise ValueError(f"movi for 2D needs every byte 0x00 or 0xFF, got {imm:#x}")
+            self.emit(Instruction(
+                template="movi {dst}, #{imm}",
+                dsts=[str(d)],
+                srcs=[],
+                kwargs=dict(dst=str(d), imm=f"{imm:#x}")
+            ))
+            return
+        if not 0 <= imm <= 0xFF:
+            raise ValueError(f"movi immediate must be in range [0, 255], got {imm}")
+        self._simd("movi", str(d), imm=imm)
+
+    def VEXT(self, d: VReg, n: VReg, m: VReg, index: int):
+        """Bytes index.. of the pair Vm:Vn: Vd = (Vm:Vn) >> (8 * index), index in bytes"""
+        self._vregs("ext", d=d, n=n, m=m)
+        if len({d.bits, n.bits, m.bits}) != 1:
+            raise ValueError(f"ext operands must all be 64 or all 128 bits: {d}, {n}, {m}")
+        if not 0 <= index < d.bits // 8:
+            raise ValueError(f"ext index must be in range [0, {d.bits // 8 - 1}], got {index}")
+        arrangement = _BYTES[d.bits]
+        self._simd("ext", *[str(r.arranged(arrangement)) for r in (d, n, m)], imm=index)
+
+    def VZIP1(self, d: VReg, n: VReg, m: VReg):
+        """Interleave the lower halves: Vd = n0 m0 n1 m1 ..."""
+        self._three("zip1", _ALL, d, n, m)
+
+    def VZIP2(self, d: VReg, n: VReg, m: VReg):
+        """Interleave the upper halves"""
+        self._three("zip2", _ALL, d, n, m)
+
+    def VUZP1(self, d: VReg, n: VReg, m: VReg):
+        """Even lanes of the pair Vn:Vm"""
+        self._three("uzp1", _ALL, d, n, m)
+
+    def VUZP2(self, d: VReg, n: VReg, m: VReg):
+        """Odd lanes of the pair Vn:Vm"""
+        self._three("uzp2", _ALL, d, n, m)
+
+    def VTRN1(self, d: VReg, n: VReg, m: VReg):
+        """Even lanes of n and m, interleaved: n0 m0 n2 m2 ..."""
+        self._three("trn1", _ALL, d, n, m)
+
+    def VTRN2(self, d: VReg, n: VReg, m: VReg):
+        """Odd lanes of n and m, interleaved: n1 m1 n3 m3 ..."""
+        self._three("trn2", _ALL, d, n, m)
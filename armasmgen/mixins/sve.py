@@ -0,0 +1,536 @@
+# armasmgen/mixins/sve.py
+from ..core import Instruction, RegArg
+from ..register import ZReg, ZElem, PReg
+from typing import Optional
+
+_SUFFIX = {8: "b", 16: "h", 32: "s", 64: "d"}
+_INTEGER = (8, 16, 32, 64)
+_FP = (16, 32, 64)
+_PATTERNS = {"pow2", "vl1", "vl2", "vl3", "vl4", "vl5", "vl6", "vl7", "vl8", "vl16", "vl32", "vl64",
+             "vl128", "vl256", "mul4", "mul3", "all"}
+
+
+class SVEMixin:
+    """
+    Scalable Vector Extension instructions on ZReg / PReg operands.
+
+        f.WHILELT(p_reg(0).s, "x9", "x3")                     # whilelt p0.s, x9, x3
+        f.LD1W(z_reg(0).s, p_reg(0), "x1", "x9")              # ld1w {z0.s}, p0/z, [x1, x9, lsl #2]
+        f.ZFMLA(z_reg(2).s, p_reg(0), z_reg(0).s, z_reg(1).s) # fmla z2.s, p0/m, z0.s, z1.s
+        f.ST1W(z_reg(2).s, p_reg(0), "x0", "x9")              # st1w {z2.s}, p0, [x0, x9, lsl #2]
+
+    The vector length is not known when the code is generated: element
+    counts come from CNTB/CNTW/... and INCB/INCW/..., loop bounds from
+    WHILELT, so one kernel runs at every length from 128 to 2048 bits
+    (see PredicatedLoop in builder.py). Data-processing instructions carry
+    a Z prefix, like the V prefix of the NEON ones in simd.py.
+
+    Operands of the wrong class raise TypeError; element sizes the
+    instruction lacks, mismatched operands and out-of-range immediates
+    raise ValueError. Governing predicates of loads, stores and predicated
+    arithmetic must be p0-p7; a plain p_reg(n) is qualified (/z or /m) by
+    the instruction. ZUMULLB and the rest of the SVE2 section need SVE2
+    (Armv9), which Neoverse V1 does not have.
+    """
+
+    def emit(self, inst: Instruction): ...  # Type hint
+    def _reg_to_str(self, reg: RegArg) -> str: ...  # Type hint
+
+    def _sve(self, mnemonic: str, dst: str, *srcs: str, imm: Optional[int] = None, reads_dst: bool = False,
+             suffix: str = ""):
+        """Emit `mnemonic dst, srcs...[, #imm]<suffix>` on rendered operands."""
+        names = [f"src{i}" for i in range(len(srcs))]
+        operands = ", ".join(["{dst}"] + ["{" + n + "}" for n in names])
+        kwargs = dict(dst=dst, **dict(zip(names, srcs)))
+        if imm is not None:
+            operands += ", #{imm}"
+            kwargs["imm"] = imm
+        self.emit(Instruction(
+            template=f"{mnemonic} {operands}{suffix}",
+            dsts=[dst],
+            srcs=([dst] if reads_dst else []) + list(srcs),
+            kwargs=kwargs
+        ))
+
+    # ---------- operand checks ----------
+    @staticmethod
+    def _zregs(mnemonic: str, allowed: tuple, **regs) -> int:
+        """All operands sized ZRegs with one element size from allowed; returns it."""
+        for name, reg in regs.items():
+            if not isinstance(reg, ZReg) or reg.esize is None:
+                raise TypeError(f"{mnemonic} parameter '{name}' must be an SVE register with an element size "
+                                f"such as z_reg(0).s, got {reg!r}")
+        sizes = {reg.esize for reg in regs.values()}
+        if len(sizes) > 1:
+            raise ValueError(f"{mnemonic} operands must share one element size: "
+                             f"{', '.join(f'{n}={r}' for n, r in regs.items())}")
+        esize = sizes.pop()
+        if esize not in allowed:
+            raise ValueError(f"{mnemonic} has no .{_SUFFIX.get(esize, 'q')} form, expected one of "
+                             f"{', '.join('.' + _SUFFIX[e] for e in allowed)}")
+        return esize
+
+    @staticmethod
+    def _governing(mnemonic: str, pg, qualifier: Optional[str]) -> str:
+        """p0-p7, rendered with the qualifier the instruction takes (None for stores and reductions)."""
+        if not isinstance(pg, PReg):
+            raise TypeError(f"{mnemonic} governing predicate must be a PReg such as p_reg(0), got {pg!r}")
+        if pg.number > 7:
+            raise ValueError(f"{mnemonic} takes its governing predicate from p0-p7, not p{pg.number}")
+        if pg.qualifier not in (None, qualifier):
+            raise ValueError(f"{mnemonic} takes a {'/' + qualifier if qualifier else 'plain'} predicate, got {pg}")
+        return f"p{pg.number}/{qualifier}" if qualifier else f"p{pg.number}"
+
+    @staticmethod
+    def _sized_preg(mnemonic: str, pd) -> None:
+        if not isinstance(pd, PReg) or pd.esize is None:
+            raise TypeError(f"{mnemonic} destination must be a predicate with an element size "
+                            f"such as p_reg(0).s, got {pd!r}")
+
+    def _gpr(self, mnemonic: str, reg: RegArg, widths: str = "x") -> str:
+        name = self._reg_to_str(reg)
+        if name.lower()[0] not in widths:
+            raise ValueError(f"{mnemonic} takes {' or '.join(widths)} registers here, got '{name}'")
+        return name
+
+    # ---------- predicates and element counts ----------
+    def PTRUE(self, pd: PReg, pattern: str = "all"):
+        """pd = the first lanes given by pattern active (all, vl1-vl256, pow2, mul3, mul4), the rest inactive"""
+        self._sized_preg("ptrue", pd)
+        if pattern.lower() not in _PATTERNS:
+            raise ValueError(f"unknown predicate pattern '{pattern}'")
+        suffix = "" if pattern.lower() == "all" else f", {pattern.lower()}"
+        self.emit(Instruction(template=f"ptrue {{pd}}{suffix}", dsts=[str(pd)], srcs=[], kwargs=dict(pd=str(pd))))
+
+    def PFALSE(self, pd: PReg):
+        """pd = all lanes inactive"""
+        if not isinstance(pd, PReg):
+            raise TypeError(f"pfalse destination must be a PReg, got {pd!r}")
+        self.emit(Instruction(template="pfalse {pd}", dsts=[f"p{pd.number}.b"], srcs=[],
+                              kwargs=dict(pd=f"p{pd.number}.b")))
+
+    def _zwhile(self, mnemonic: str, pd: PReg, Rn: RegArg, Rm: RegArg):
+        self._sized_preg(mnemonic, pd)
+        n, m = self._gpr(mnemonic, Rn, "xw"), self._gpr(mnemonic, Rm, "xw")
+        if n[0].lower() != m[0].lower():
+            raise ValueError(f"{mnemonic} operands must be both x or both w registers, got '{n}' and '{m}'")
+        self._sve(mnemonic, str(pd), n, m)
+
+    def WHILELT(self, pd: PReg, Rn: RegArg, Rm: RegArg):
+        """
+        Lane i of pd active while Rn + i < Rm (signed); sets NZCV:
+        b.none (no lane active), b.first (lane 0 active), b.last.
+        """
+        self._zwhile("whilelt", pd, Rn, Rm)
+
+    def WHILELO(self, pd: PReg, Rn: RegArg, Rm: RegArg):
+        """As WHILELT with an unsigned comparison"""
+        self._zwhile("whilelo", pd, Rn, Rm)
+
+    def _count(self, mnemonic: str, Rd: RegArg, mul: int, increment: bool):
+        if not 1 <= mul <= 16:
+            raise ValueError(f"{mnemonic} multiplier must be in range [1, 16], got {mul}")
+        dst = self._gpr(mnemonic, Rd)
+        self._sve(mnemonic, dst, suffix="" if mul == 1 else f", all, mul #{mul}", reads_dst=increment)
+
+    def CNTB(self, Rd: RegArg, mul: int = 1):
+        """Rd = mul · (vector length in bytes)"""
+        self._count("cntb", Rd, mul, increment=False)
+
+    def CNTH(self, Rd: RegArg, mul: int = 1):
+        """Rd = mul · (16-bit elements per vector)"""
+        self._count("cnth", Rd, mul, increment=False)
+
+    def CNTW(self, Rd: RegArg, mul: int = 1):
+        """Rd = mul · (32-bit elements per vector)"""
+        self._count("cntw", Rd, mul, increment=False)
+
+    def CNTD(self, Rd: RegArg, mul: int = 1):
+        """Rd = mul · (64-bit elements per vector)"""
+        self._count("cntd", Rd, mul, increment=False)
+
+    def INCB(self, Rdn: RegArg, mul: int = 1):
+        """Rdn += mul · (vector length in bytes)"""
+        self._count("incb", Rdn, mul, increment=True)
+
+    def INCH(self, Rdn: RegArg, mul: int = 1):
+        """Rdn += mul · (16-bit elements per vector)"""
+        self._count("inch", Rdn, mul, increment=True)
+
+    def INCW(self, Rdn: RegArg, mul: int = 1):
+        """Rdn += mul · (32-bit elements per vector)"""
+        self._count("incw", Rdn, mul, increment=True)
+
+    def INCD(self, Rdn: RegArg, mul: int = 1):
+        """Rdn += mul · (64-bit elements per vector)"""
+        self._count("incd", Rdn, mul, increment=True)
+
+    def RDVL(self, Rd: RegArg, imm: int = 1):
+        """Rd = imm · (vector length in bytes), imm in [-32, 31]"""
+        if not -32 <= imm <= 31:
+            raise ValueError(f"rdvl multiplier must be in range [-32, 31], got {imm}")
+        self._sve("rdvl", self._gpr("rdvl", Rd), imm=imm)
+
+    def ADDVL(self, Rd: RegArg, Rn: RegArg, imm: int):
+        """Rd = Rn + imm · (vector length in bytes), imm in [-32, 31]; Rd/Rn may be sp"""
+        if not -32 <= imm <= 31:
+            raise ValueError(f"addvl multiplier must be in range [-32, 31], got {imm}")
+        self._sve("addvl", self._gpr("addvl", Rd, "xs"), self._gpr("addvl", Rn, "xs"), imm=imm)
+
+    # ---------- contiguous loads and stores ----------
+    def _access(self, mnemonic: str, msize: int, zt: ZReg, pg: PReg, base: RegArg, index, vl: int,
+                load: bool, signed: bool = False):
+        """
+        One contiguous access of msize-bit memory elements into (out of) the
+        lanes of zt: [base, index, lsl #log2(msize/8)] or [base, #vl, mul vl].
+        A wider zt extends on load (zero, or sign with signed) and truncates on store.
+        """
+        if not isinstance(zt, ZReg) or zt.esize is None:
+            raise TypeError(f"{mnemonic} transfers an SVE register with an element size such as "
+                            f"z_reg(0).s, got {zt!r}")
+        if zt.esize not in _INTEGER or zt.esize < msize or (signed and zt.esize == msize):
+            raise ValueError(f"{mnemonic} has no {zt} form")
+        pred = self._governing(mnemonic, pg, "z" if load else None)
+        base_str = self._gpr(mnemonic, base, "xs")
+        kwargs = dict(zt=str(zt), pg=pred, base=base_str)
+        srcs = [pred, base_str] if load else [str(zt), pred, base_str]
+        if index is not None:
+            if vl:
+                raise ValueError(f"{mnemonic} takes an index register or a vector offset, not both")
+            kwargs["index"] = self._gpr(mnemonic, index)
+            srcs.append(kwargs["index"])
+            shift = {8: "", 16: ", lsl #1", 32: ", lsl #2", 64: ", lsl #3"}[msize]
+            addr = f"[{{base}}, {{index}}{shift}]"
+        elif vl:
+            if not -8 <= vl <= 7:
+                raise ValueError(f"{mnemonic} vector offset must be in range [-8, 7], got {vl}")
+            kwargs["vl"] = vl
+            addr = "[{base}, #{vl}, mul vl]"
+        else:
+            addr = "[{base}]"
+        self.emit(Instruction(
+            template=f"{mnemonic} {{{{{{zt}}}}}}, {{pg}}, {addr}",
+            dsts=[str(zt)] if load else [],
+            srcs=srcs,
+            kwargs=kwargs
+        ))
+
+    def LD1B(self, zt: ZReg, pg: PReg, base: RegArg, index: Optional[RegArg] = None, vl: int = 0):
+        """
+        Load bytes into the active lanes of zt, zero-extended; inactive lanes are zeroed:
+
+            LD1B(z_reg(0).b, p_reg(0), "x1", "x9")    ld1b {z0.b}, p0/z, [x1, x9]
+            LD1B(z_reg(0).s, p_reg(0), "x1", vl=1)    ld1b {z0.s}, p0/z, [x1, #1, mul vl]
+
+        index is an x register counting elements; vl counts whole transfers
+        (vector length · msize / esize bytes) in [-8, 7].
+        """
+        self._access("ld1b", 8, zt, pg, base, index, vl, load=True)
+
+    def LD1H(self, zt: ZReg, pg: PReg, base: RegArg, index: Optional[RegArg] = None, vl: int = 0):
+        """Load 16-bit elements (zero-extended into .s/.d lanes); index scaled by 2"""
+        self._access("ld1h", 16, zt, pg, base, index, vl, load=True)
+
+    def LD1W(self, zt: ZReg, pg: PReg, base: RegArg, index: Optional[RegArg] = None, vl: int = 0):
+        """Load 32-bit elements (zero-extended into .d lanes); index scaled by 4"""
+        self._access("ld1w", 32, zt, pg, base, index, vl, load=True)
+
+    def LD1D(self, zt: ZReg, pg: PReg, base: RegArg, index: Optional[RegArg] = None, vl: int = 0):
+        """Load 64-bit elements; index scaled by 8"""
+        self._access("ld1d", 64, zt, pg, base, index, vl, load=True)
+
+    def LD1SB(self, zt: ZReg, pg: PReg, base: RegArg, index: Optional[RegArg] = None, vl: int = 0):
+        """Load bytes sign-extended into .h/.s/.d lanes"""
+        self._access("ld1sb", 8, zt, pg, base, index, vl, load=True, signed=True)
+
+    def LD1SH(self, zt: ZReg, pg: PReg, base: RegArg, index: Optional[RegArg] = None, vl: int = 0):
+        """Load 16-bit elements sign-extended into .s/.d lanes"""
+        self._access("ld1sh", 16, zt, pg, base, index, vl, load=True, signed=True)
+
+    def LD1SW(self, zt: ZReg, pg: PReg, base: RegArg, index: Optional[RegArg] = None, vl: int = 0):
+        """Load 32-bit elements sign-extended into .d lanes"""
+        self._access("ld1sw", 32, zt, pg, base, index, vl, load=True, signed=True)
+
+    def ST1B(self, zt: ZReg, pg: PReg, base: RegArg, index: Optional[RegArg] = None, vl: int = 0):
+        """Store the low byte of the active lanes of zt: st1b {z0.s}, p0, [x0, x9]"""
+        self._access("st1b", 8, zt, pg, base, index, vl, load=False)
+
+    def ST1H(self, zt: ZReg, pg: PReg, base: RegArg, index: Optional[RegArg] = None, vl: int = 0):
+        """Store the low 16 bits of the active lanes"""
+        self._access("st1h", 16, zt, pg, base, index, vl, load=False)
+
+    def ST1W(self, zt: ZReg, pg: PReg, base: RegArg, index: Optional[RegArg] = None, vl: int = 0):
+        """Store the low 32 bits of the active lanes"""
+        self._access("st1w", 32, zt, pg, base, index, vl, load=False)
+
+    def ST1D(self, zt: ZReg, pg: PReg, base: RegArg, index: Optional[RegArg] = None, vl: int = 0):
+        """Store the active 64-bit lanes"""
+        self._access("st1d", 64, zt, pg, base, index, vl, load=False)
+
+    # ---------- integer ----------
+    def ZADD(self, d: ZReg, n: ZReg, m: ZReg):
+        """Zd[i] = Zn[i] + Zm[i] (unpredicated)"""
+        self._zregs("add", _INTEGER, d=d, n=n, m=m)
+        self._sve("add", str(d), str(n), str(m))
+
+    def ZSUB(self, d: ZReg, n: ZReg, m: ZReg):
+        """Zd[i] = Zn[i] - Zm[i] (unpredicated)"""
+        self._zregs("sub", _INTEGER, d=d, n=n, m=m)
+        self._sve("sub", str(d), str(n), str(m))
+
+    def _destructive(self, mnemonic: str, allowed: tuple, d: ZReg, pg: PReg, m: ZReg):
+        """mnemonic zd, pg/m, zd, zm: active lanes of d become d op m, inactive ones are kept"""
+        self._zregs(mnemonic, allowed, d=d, m=m)
+        pred = self._governing(mnemonic, pg, "m")
+        self._sve(mnemonic, str(d), pred, str(d), str(m), reads_dst=True)
+
+    def ZMUL(self, d: ZReg, pg: PReg, m: ZReg):
+        """Zd[i] = Zd[i] · Zm[i] (low half) in the active lanes"""
+        self._destructive("mul", _INTEGER, d, pg, m)
+
+    def ZUMULH(self, d: ZReg, pg: PReg, m: ZReg):
+        """Zd[i] = high half of the unsigned product Zd[i] · Zm[i] in the active lanes"""
+        self._destructive("umulh", _INTEGER, d, pg, m)
+
+    def ZSMULH(self, d: ZReg, pg: PReg, m: ZReg):
+        """Zd[i] = high half of the signed product in the active lanes"""
+        self._destructive("smulh", _INTEGER, d, pg, m)
+
+    def ZUMIN(self, d: ZReg, pg: PReg, m: ZReg):
+        self._destructive("umin", _INTEGER, d, pg, m)
+
+    def ZUMAX(self, d: ZReg, pg: PReg, m: ZReg):
+        self._destructive("umax", _INTEGER, d, pg, m)
+
+    def ZSMIN(self, d: ZReg, pg: PReg, m: ZReg):
+        self._destructive("smin", _INTEGER, d, pg, m)
+
+    def ZSMAX(self, d: ZReg, pg: PReg, m: ZReg):
+        self._destructive("smax", _INTEGER, d, pg, m)
+
+    def ZMLA(self, d: ZReg, pg: PReg, n: ZReg, m: ZReg):
+        """Zd[i] += Zn[i] · Zm[i] in the active lanes"""
+        self._zregs("mla", _INTEGER, d=d, n=n, m=m)
+        self._sve("mla", str(d), self._governing("mla", pg, "m"), str(n), str(m), reads_dst=True)
+
+    def ZMLS(self, d: ZReg, pg: PReg, n: ZReg, m: ZReg):
+        """Zd[i] -= Zn[i] · Zm[i] in the active lanes"""
+        self._zregs("mls", _INTEGER, d=d, n=n, m=m)
+        self._sve("mls", str(d), self._governing("mls", pg, "m"), str(n), str(m), reads_dst=True)
+
+    def _extend(self, mnemonic: str, from_bits: int, d: ZReg, pg: PReg, n: ZReg):
+        esize = self._zregs(mnemonic, _INTEGER, d=d, n=n)
+        if esize <= from_bits:
+            raise ValueError(f"{mnemonic} extends {from_bits}-bit values within wider lanes, got {d}")
+        self._sve(mnemonic, str(d), self._governing(mnemonic, pg, "m"), str(n), reads_dst=True)
+
+    def ZUXTB(self, d: ZReg, pg: PReg, n: ZReg):
+        """Zd[i] = Zn[i] mod 2^8 in the active lanes (.h/.s/.d)"""
+        self._extend("uxtb", 8, d, pg, n)
+
+    def ZUXTH(self, d: ZReg, pg: PReg, n: ZReg):
+        """Zd[i] = Zn[i] mod 2^16 in the active lanes (.s/.d)"""
+        self._extend("uxth", 16, d, pg, n)
+
+    def ZUXTW(self, d: ZReg, pg: PReg, n: ZReg):
+        """Zd[i] = Zn[i] mod 2^32 in the active lanes (.d)"""
+        self._extend("uxtw", 32, d, pg, n)
+
+    def ZSXTB(self, d: ZReg, pg: PReg, n: ZReg):
+        self._extend("sxtb", 8, d, pg, n)
+
+    def ZSXTH(self, d: ZReg, pg: PReg, n: ZReg):
+        self._extend("sxth", 16, d, pg, n)
+
+    def ZSXTW(self, d: ZReg, pg: PReg, n: ZReg):
+        self._extend("sxtw", 32, d, pg, n)
+
+    def _zshift(self, mnemonic: str, d: ZReg, n: ZReg, shift: int, left: bool):
+        esize = self._zregs(mnemonic, _INTEGER, d=d, n=n)
+        low, high = (0, esize - 1) if left else (1, esize)
+        if not low <= shift <= high:
+            raise ValueError(f"{mnemonic} shift must be in range [{low}, {high}], got {shift}")
+        self._sve(mnemonic, str(d), str(n), imm=shift)
+
+    def ZLSL(self, d: ZReg, n: ZReg, shift: int):
+        """Zd[i] = Zn[i] << shift (unpredicated)"""
+        self._zshift("lsl", d, n, shift, left=True)
+
+    def ZLSR(self, d: ZReg, n: ZReg, shift: int):
+        """Zd[i] = Zn[i] >> shift, logical (unpredicated)"""
+        self._zshift("lsr", d, n, shift, left=False)
+
+    def ZASR(self, d: ZReg, n: ZReg, shift: int):
+        """Zd[i] = Zn[i] >> shift, arithmetic (unpredicated)"""
+        self._zshift("asr", d, n, shift, left=False)
+
+    def _zbitwise(self, mnemonic: str, d: ZReg, n: ZReg, m: ZReg):
+        """The unpredicated bitwise forms exist for .d only; any element size is accepted and rendered as .d."""
+        self._zregs(mnemonic, _INTEGER, d=d, n=n, m=m)
+        self._sve(mnemonic, str(d.d), str(n.d), str(m.d))
+
+    def ZAND(self, d: ZReg, n: ZReg, m: ZReg):
+        self._zbitwise("and", d, n, m)
+
+    def ZORR(self, d: ZReg, n: ZReg, m: ZReg):
+        self._zbitwise("orr", d, n, m)
+
+    def ZEOR(self, d: ZReg, n: ZReg, m: ZReg):
+        self._zbitwise("eor", d, n, m)
+
+    def ZBIC(self, d: ZReg, n: ZReg, m: ZReg):
+        """Zd = Zn & ~Zm"""
+        self._zbitwise("bic", d, n, m)
+
+    def ZMOV(self, d: ZReg, n: ZReg):
+        """Zd = Zn, the whole register (mov z0.d, z1.d)"""
+        for name, reg in (("d", d), ("n", n)):
+            if not isinstance(reg, ZReg):
+                raise TypeError(f"mov parameter '{name}' must be an SVE register such as z_reg(0), got {reg!r}")
+        self._sve("mov", str(d.d), str(n.d))
+
+    def ZMOVPRFX(self, d: ZReg, n: ZReg):
+        """
+        Zd = Zn as a prefix to the destructive instruction that follows and
+        writes d, which then reads d as if it were n:
+
+            ZMOVPRFX(z_reg(4), z_reg(1)); ZMUL(z_reg(4).d, p_reg(0), z_reg(2).d)   # z4 = z1 · z2
+
+        Cores that fuse the pair execute it as one constructive instruction.
+        """
+        for name, reg in (("d", d), ("n", n)):
+            if not isinstance(reg, ZReg):
+                raise TypeError(f"movprfx parameter '{name}' must be an SVE register such as z_reg(0), got {reg!r}")
+        self._sve("movprfx", f"z{d.number}", f"z{n.number}")
+
+    def ZDUP(self, d: ZReg, src):
+        """Zd[i] = src: a w/x register (x for .d), or an immediate in [-128, 127]"""
+        esize = self._zregs("dup", _INTEGER, d=d)
+        if isinstance(src, int):
+            if not -128 <= src <= 127:
+                raise ValueError(f"dup immediate must be in range [-128, 127], got {src}")
+            return self._sve("dup", str(d), imm=src)
+        self._sve("dup", str(d), self._gpr("dup", src, "x" if esize == 64 else "w"))
+
+    def _zdot(self, mnemonic: str, d: ZReg, n: ZReg, m):
+        """.s += four bytes, .d += four halfwords; an indexed m picks one group per 128-bit segment"""
+        esize = self._zregs(mnemonic, (32, 64), d=d)
+        if isinstance(m, ZElem):
+            self._zregs(mnemonic, (esize // 4,), n=n)
+            limit = 7 if esize == 32 else 15
+            if m.esize != esize // 4 or m.number > limit:
+                raise ValueError(f"{mnemonic} indexed operand must be a .{_SUFFIX[esize // 4]} element "
+                                 f"of z0-z{limit}, got {m}")
+            # the index picks a group of four elements in each 128-bit segment
+            groups = 128 // esize
+            if m.index >= groups:
+                raise ValueError(f"{mnemonic} .{_SUFFIX[esize]} index must be 0-{groups - 1}, got {m}")
+        else:
+            self._zregs(mnemonic, (esize // 4,), n=n, m=m)
+        self._sve(mnemonic, str(d), str(n), str(m), reads_dst=True)
+
+    def ZSDOT(self, d: ZReg, n: ZReg, m):
+        """Zd.s[i] += Σ_j Zn.b[4i+j] · Zm.b[4i+j], signed (.d from .h); m may be indexed, z_reg(2).b[1]"""
+        self._zdot("sdot", d, n, m)
+
+    def ZUDOT(self, d: ZReg, n: ZReg, m):
+        """As ZSDOT, unsigned"""
+        self._zdot("udot", d, n, m)
+
+    # ---------- floating point ----------
+    def _fp3(self, mnemonic: str, d: ZReg, n: ZReg, m: ZReg):
+        self._zregs(mnemonic, _FP, d=d, n=n, m=m)
+        self._sve(mnemonic, str(d), str(n), str(m))
+
+    def ZFADD(self, d: ZReg, n: ZReg, m: ZReg):
+        """Zd[i] = Zn[i] + Zm[i] (.h/.s/.d, unpredicated)"""
+        self._fp3("fadd", d, n, m)
+
+    def ZFSUB(self, d: ZReg, n: ZReg, m: ZReg):
+        self._fp3("fsub", d, n, m)
+
+    def ZFMUL(self, d: ZReg, n: ZReg, m: ZReg):
+        self._fp3("fmul", d, n, m)
+
+    def ZFMLA(self, d: ZReg, pg: PReg, n: ZReg, m: ZReg):
+        """Zd[i] += Zn[i] · Zm[i], fused, in the active lanes"""
+        self._zregs("fmla", _FP, d=d, n=n, m=m)
+        self._sve("fmla", str(d), self._governing("fmla", pg, "m"), str(n), str(m), reads_dst=True)
+
+    def ZFMLS(self, d: ZReg, pg: PReg, n: ZReg, m: ZReg):
+        """Zd[i] -= Zn[i] · Zm[i], fused, in the active lanes"""
+        self._zregs("fmls", _FP, d=d, n=n, m=m)
+        self._sve("fmls", str(d), self._governing("fmls", pg, "m"), str(n), str(m), reads_dst=True)
+
+    # ---------- reductions ----------
+    def _reduce(self, mnemonic: str, allowed: tuple, d, pg: PReg, n: ZReg, result_bits: Optional[int] = None):
+        """Scalar result in the b/h/s/d register numbered like d (a ZReg or VReg), result_bits wide"""
+        if not hasattr(d, "number"):
+            raise TypeError(f"{mnemonic} destination must be a vector register such as z_reg(0), got {d!r}")
+        esize = self._zregs(mnemonic, allowed, n=n)
+        bits = result_bits or esize
+        self._sve(mnemonic, f"{'bhsd'[bits.bit_length() - 4]}{d.number}", self._governing(mnemonic, pg, None),
+                  str(n))
+
+    def ZUADDV(self, d, pg: PReg, n: ZReg):
+        """d (a d register) = sum of the active lanes of n, zero-extended to 64 bits"""
+        self._reduce("uaddv", _INTEGER, d, pg, n, result_bits=64)
+
+    def ZSADDV(self, d, pg: PReg, n: ZReg):
+        """d (a d register) = sum of the active lanes of n, sign-extended to 64 bits (.b/.h/.s)"""
+        self._reduce("saddv", (8, 16, 32), d, pg, n, result_bits=64)
+
+    def ZUMINV(self, d, pg: PReg, n: ZReg):
+        """Unsigned minimum of the active lanes (all ones when none is active)"""
+        self._reduce("uminv", _INTEGER, d, pg, n)
+
+    def ZUMAXV(self, d, pg: PReg, n: ZReg):
+        self._reduce("umaxv", _INTEGER, d, pg, n)
+
+    def ZSMINV(self, d, pg: PReg, n: ZReg):
+        self._reduce("sminv", _INTEGER, d, pg, n)
+
+    def ZSMAXV(self, d, pg: PReg, n: ZReg):
+        self._reduce("smaxv", _INTEGER, d, pg, n)
+
+    def ZFADDV(self, d, pg: PReg, n: ZReg):
+        """Floating-point sum of the active lanes, in a tree order (not sequential, see FADDA)"""
+        self._reduce("faddv", _FP, d, pg, n)
+
+    # ---------- SVE2 ----------
+    def _long(self, mnemonic: str, d: ZReg, n: ZReg, m: ZReg, accumulate: bool):
+        """d has twice the element size of n and m, one lane per even (B) or odd (T) lane of n"""
+        esize = self._zregs(mnemonic, (16, 32, 64), d=d)
+        self._zregs(mnemonic, (esize // 2,), n=n, m=m)
+        self._sve(mnemonic, str(d), str(n), str(m), reads_dst=accumulate)
+
+    def ZUMULLB(self, d: ZReg, n: ZReg, m: ZReg):
+        """Zd[i] = Zn[2i] · Zm[2i], widened (SVE2)"""
+        self._long("umullb", d, n, m, accumulate=False)
+
+    def ZUMULLT(self, d: ZReg, n: ZReg, m: ZReg):
+        """Zd[i] = Zn[2i+1] · Zm[2i+1], widened (SVE2)"""
+        self._long("umullt", d, n, m, accumulate=False)
+
+    def ZUMLALB(self, d: ZReg, n: ZReg, m: ZReg):
+        """Zd[i] += Zn[2i] · Zm[2i], widened (SVE2)"""
+        self._long("umlalb", d, n, m, accumulate=True)
+
+    def ZUMLALT(self, d: ZReg, n: ZReg, m: ZReg):
+        """Zd[i] += Zn[2i+1] · Zm[2i+1], widened (SVE2)"""
+        self._long("umlalt", d, n, m, accumulate=True)
+
+    def _carry(self, mnemonic: str, d: ZReg, n: ZReg, m: ZReg):
+        self._zregs(mnemonic, (32, 64), d=d, n=n, m=m)
+        self._sve(mnemonic, str(d), str(n), str(m), reads_dst=True)
+
+    def ZADCLB(self, d: ZReg, n: ZReg, m: ZReg):
+        """
+        Add with carry long (SVE2), for independent multi-precision sums in
+        lane pairs: Zd[2i] = Zd[2i] + Zn[2i] + (Zm[2i+1] & 1), Zd[2i+1] = carry out.
+        """
+        self._carry("adclb", d, n, m)
+
+    def ZADCLT(self, d: ZReg, n: ZReg, m: ZReg):
+        """As ZADCLB on the odd lanes of n, carry in from the odd lanes of m (SVE2)"""
+        self._carry("adclt", d, n, m)
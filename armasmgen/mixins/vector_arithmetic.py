@@ -1,7 +1,7 @@
 # armasmgen/mixins/vector_arithmetic.py
 from ..core import Instruction, RegArg
 from ..register import Register, RegisterType, RegisterWidth
-from typing import TYPE_CHECKING
+from typing import Optional, TYPE_CHECKING
 
 if TYPE_CHECKING:
     from ..register import Register
@@ -60,194 +60,302 @@ class VectorArithmeticMixin:
         
         return reg_str
 
+    # ---------- fixed-arrangement entry points ----------
+    # The methods below predate VReg; each is one instruction of SIMDMixin
+    # with the arrangement fixed by its name, on plain vector registers.
+    def _legacy(self, mnemonic: str, arrangements: tuple, *regs: RegArg, imm: Optional[int] = None,
+                reads_dst: bool = False):
+        """Validate Vd, Vn[, Vm] and append each its arrangement: _legacy("add", ("4S",) * 3, "v0", "v1", "v2")"""
+        operands = [f"{self._validate_vector_register(reg, name)}.{arrangement}"
+                    for reg, name, arrangement in zip(regs, ("Vd", "Vn", "Vm"), arrangements)]
+        self._simd(mnemonic, *operands, imm=imm, reads_dst=reads_dst)
+
     def ADD_8B(self, Vd: RegArg, Vn: RegArg, Vm: RegArg):
         """
         Vector Add (8 x 8-bit elements):
         Adds 8 corresponding 8-bit elements from two vector registers.
-        
+
             Vd.8B = Vn.8B + Vm.8B
-        
+
         Example:
             ADD_8B("v0", "v1", "v2")  # v0.8B = v1.8B + v2.8B
-            
+
         Raises:
             TypeError: If any parameter is not a vector register
         """
-        dst_str = self._validate_vector_register(Vd, "Vd")
-        src0_str = self._validate_vector_register(Vn, "Vn") 
-        src1_str = self._validate_vector_register(Vm, "Vm")
-        
-        self.emit(Instruction(
-            template="add {dst}.8B, {src0}.8B, {src1}.8B",
-            dsts=[dst_str],
-            srcs=[src0_str, src1_str],
-            kwargs=dict(dst=dst_str, src0=src0_str, src1=src1_str)
-        ))
+        self._legacy("add", ("8B",) * 3, Vd, Vn, Vm)
 
     def ADD_16B(self, Vd: RegArg, Vn: RegArg, Vm: RegArg):
         """
         Vector Add (16 x 8-bit elements):
         Adds 16 corresponding 8-bit elements from two vector registers.
-        
+
             Vd.16B = Vn.16B + Vm.16B
-        
+
         Example:
             ADD_16B("v0", "v1", "v2")  # v0.16B = v1.16B + v2.16B
-            
+
         Raises:
             TypeError: If any parameter is not a vector register
         """
-        dst_str = self._validate_vector_register(Vd, "Vd")
-        src0_str = self._validate_vector_register(Vn, "Vn") 
-        src1_str = self._validate_vector_register(Vm, "Vm")
-        
-        self.emit(Instruction(
-            template="add {dst}.16B, {src0}.16B, {src1}.16B",
-            dsts=[dst_str],
-            srcs=[src0_str, src1_str],
-            kwargs=dict(dst=dst_str, src0=src0_str, src1=src1_str)
-        ))
+        self._legacy("add", ("16B",) * 3, Vd, Vn, Vm)
 
     def ADD_4H(self, Vd: RegArg, Vn: RegArg, Vm: RegArg):
         """
         Vector Add (4 x 16-bit elements):
         Adds 4 corresponding 16-bit elements from two vector registers.
-        
+
             Vd.4H = Vn.4H + Vm.4H
-        
+
         Example:
             ADD_4H("v0", "v1", "v2")  # v0.4H = v1.4H + v2.4H
-            
+
         Raises:
             TypeError: If any parameter is not a vector register
         """
-        dst_str = self._validate_vector_register(Vd, "Vd")
-        src0_str = self._validate_vector_register(Vn, "Vn") 
-        src1_str = self._validate_vector_register(Vm, "Vm")
-        
-        self.emit(Instruction(
-            template="add {dst}.4H, {src0}.4H, {src1}.4H",
-            dsts=[dst_str],
-            srcs=[src0_str, src1_str],
-            kwargs=dict(dst=dst_str, src0=src0_str, src1=src1_str)
-        ))
+        self._legacy("add", ("4H",) * 3, Vd, Vn, Vm)
 
     def ADD_8H(self, Vd: RegArg, Vn: RegArg, Vm: RegArg):
         """
         Vector Add (8 x 16-bit elements):
         Adds 8 corresponding 16-bit elements from two vector registers.
-        
+
             Vd.8H = Vn.8H + Vm.8H
-        
+
         Example:
             ADD_8H("v0", "v1", "v2")  # v0.8H = v1.8H + v2.8H
-            
+
         Raises:
             TypeError: If any parameter is not a vector register
         """
-        dst_str = self._validate_vector_register(Vd, "Vd")
-        src0_str = self._validate_vector_register(Vn, "Vn") 
-        src1_str = self._validate_vector_register(Vm, "Vm")
-        
-        self.emit(Instruction(
-            template="add {dst}.8H, {src0}.8H, {src1}.8H",
-            dsts=[dst_str],
-            srcs=[src0_str, src1_str],
-            kwargs=dict(dst=dst_str, src0=src0_str, src1=src1_str)
-        ))
+        self._legacy("add", ("8H",) * 3, Vd, Vn, Vm)
 
     def ADD_2S(self, Vd: RegArg, Vn: RegArg, Vm: RegArg):
         """
         Vector Add (2 x 32-bit elements):
         Adds 2 corresponding 32-bit elements from two vector registers.
-        
+
             Vd.2S = Vn.2S + Vm.2S
-        
+
         Example:
             ADD_2S("v0", "v1", "v2")  # v0.2S = v1.2S + v2.2S
-            
+
         Raises:
             TypeError: If any parameter is not a vector register
         """
-        dst_str = self._validate_vector_register(Vd, "Vd")
-        src0_str = self._validate_vector_register(Vn, "Vn") 
-        src1_str = self._validate_vector_register(Vm, "Vm")
-        
-        self.emit(Instruction(
-            template="add {dst}.2S, {src0}.2S, {src1}.2S",
-            dsts=[dst_str],
-            srcs=[src0_str, src1_str],
-            kwargs=dict(dst=dst_str, src0=src0_str, src1=src1_str)
-        ))
+        self._legacy("add", ("2S",) * 3, Vd, Vn, Vm)
 
     def ADD_4S(self, Vd: RegArg, Vn: RegArg, Vm: RegArg):
         """
         Vector Add (4 x 32-bit elements):
         Adds 4 corresponding 32-bit elements from two vector registers.
-        
+
             Vd.4S = Vn.4S + Vm.4S
-        
+
         Example:
             ADD_4S("v0", "v1", "v2")  # v0.4S = v1.4S + v2.4S
-            
+
         Raises:
             TypeError: If any parameter is not a vector register
         """
-        dst_str = self._validate_vector_register(Vd, "Vd")
-        src0_str = self._validate_vector_register(Vn, "Vn") 
-        src1_str = self._validate_vector_register(Vm, "Vm")
-        
-        self.emit(Instruction(
-            template="add {dst}.4S, {src0}.4S, {src1}.4S",
-            dsts=[dst_str],
-            srcs=[src0_str, src1_str],
-            kwargs=dict(dst=dst_str, src0=src0_str, src1=src1_str)
-        ))
+        self._legacy("add", ("4S",) * 3, Vd, Vn, Vm)
 
     def ADD_1D(self, Vd: RegArg, Vn: RegArg, Vm: RegArg):
         """
         Vector Add (1 x 64-bit element):
         Adds 1 corresponding 64-bit element from two vector registers.
-        
+
             Vd.1D = Vn.1D + Vm.1D
-        
+
         Example:
             ADD_1D("v0", "v1", "v2")  # v0.1D = v1.1D + v2.1D
-            
+
+        There is no vector add of 1D; this emits the scalar add on the d
+        registers, which has the same effect.
+
         Raises:
             TypeError: If any parameter is not a vector register
         """
-        dst_str = self._validate_vector_register(Vd, "Vd")
-        src0_str = self._validate_vector_register(Vn, "Vn") 
-        src1_str = self._validate_vector_register(Vm, "Vm")
-        
-        self.emit(Instruction(
-            template="add {dst}.1D, {src0}.1D, {src1}.1D",
-            dsts=[dst_str],
-            srcs=[src0_str, src1_str],
-            kwargs=dict(dst=dst_str, src0=src0_str, src1=src1_str)
-        ))
+        regs = [self._validate_vector_register(reg, name) for reg, name in ((Vd, "Vd"), (Vn, "Vn"), (Vm, "Vm"))]
+        self._simd("add", *[f"d{reg[1:]}" for reg in regs])
 
     def ADD_2D(self, Vd: RegArg, Vn: RegArg, Vm: RegArg):
         """
         Vector Add (2 x 64-bit elements):
         Adds 2 corresponding 64-bit elements from two vector registers.
-        
+
             Vd.2D = Vn.2D + Vm.2D
-        
+
         Example:
             ADD_2D("v0", "v1", "v2")  # v0.2D = v1.2D + v2.2D
-            
+
         Raises:
             TypeError: If any parameter is not a vector register
         """
+        self._legacy("add", ("2D",) * 3, Vd, Vn, Vm)
+
+
+    def AESE(self, Vd: RegArg, Vn: RegArg):
+        """
+        AES single round encryption:
+        XORs the round key into the state and applies one round of ShiftRows/SubBytes.
+        Keep AESMC on the same register immediately after it so the pair fuses.
+
+            Vd = SubBytes(ShiftRows(Vd ^ Vn))
+
+        Reference: A-profile: section C7.2.7, page C7-1391
+        """
         dst_str = self._validate_vector_register(Vd, "Vd")
-        src0_str = self._validate_vector_register(Vn, "Vn") 
-        src1_str = self._validate_vector_register(Vm, "Vm")
-        
+        src_str = self._validate_vector_register(Vn, "Vn")
+        self.emit(Instruction(
+            template="aese {dst}.16B, {src}.16B",
+            dsts=[dst_str],
+            srcs=[dst_str, src_str],
+            kwargs=dict(dst=dst_str, src=src_str)
+        ))
+
+    def AESD(self, Vd: RegArg, Vn: RegArg):
+        """
+        AES single round decryption:
+        XORs the round key into the state and applies one round of InvShiftRows/InvSubBytes.
+        Keep AESIMC on the same register immediately after it so the pair fuses.
+
+            Vd = InvSubBytes(InvShiftRows(Vd ^ Vn))
+
+        Reference: A-profile: section C7.2.6, page C7-1390
+        """
+        dst_str = self._validate_vector_register(Vd, "Vd")
+        src_str = self._validate_vector_register(Vn, "Vn")
+        self.emit(Instruction(
+            template="aesd {dst}.16B, {src}.16B",
+            dsts=[dst_str],
+            srcs=[dst_str, src_str],
+            kwargs=dict(dst=dst_str, src=src_str)
+        ))
+
+    def AESMC(self, Vd: RegArg, Vn: RegArg):
+        """
+        AES mix columns:
+
+            Vd = MixColumns(Vn)
+
+        Reference: A-profile: section C7.2.9, page C7-1393
+        """
+        dst_str = self._validate_vector_register(Vd, "Vd")
+        src_str = self._validate_vector_register(Vn, "Vn")
+        self.emit(Instruction(
+            template="aesmc {dst}.16B, {src}.16B",
+            dsts=[dst_str],
+            srcs=[src_str],
+            kwargs=dict(dst=dst_str, src=src_str)
+        ))
+
+    def AESIMC(self, Vd: RegArg, Vn: RegArg):
+        """
+        AES inverse mix columns:
+
+            Vd = InvMixColumns(Vn)
+
+        Reference: A-profile: section C7.2.8, page C7-1392
+        """
+        dst_str = self._validate_vector_register(Vd, "Vd")
+        src_str = self._validate_vector_register(Vn, "Vn")
         self.emit(Instruction(
-            template="add {dst}.2D, {src0}.2D, {src1}.2D",
+            template="aesimc {dst}.16B, {src}.16B",
             dsts=[dst_str],
-            srcs=[src0_str, src1_str],
-            kwargs=dict(dst=dst_str, src0=src0_str, src1=src1_str)
+            srcs=[src_str],
+            kwargs=dict(dst=dst_str, src=src_str)
         ))
+
+    # ---------- widening multiplies ----------
+    def UMULL_2D(self, Vd: RegArg, Vn: RegArg, Vm: RegArg):
+        """
+        Unsigned widening multiply, lower half (2 x 32 -> 2 x 64-bit):
+
+            Vd.2D[i] = Vn.2S[i] * Vm.2S[i]      (full 64-bit product)
+        """
+        self._legacy("umull", ("2D", "2S", "2S"), Vd, Vn, Vm)
+
+    def UMULL2_2D(self, Vd: RegArg, Vn: RegArg, Vm: RegArg):
+        """Unsigned widening multiply, upper half (lanes 2-3 of 4 x 32 -> 2 x 64-bit)"""
+        self._legacy("umull2", ("2D", "4S", "4S"), Vd, Vn, Vm)
+
+    def UMULL_4S(self, Vd: RegArg, Vn: RegArg, Vm: RegArg):
+        """Unsigned widening multiply, lower half (4 x 16 -> 4 x 32-bit)"""
+        self._legacy("umull", ("4S", "4H", "4H"), Vd, Vn, Vm)
+
+    def UMULL2_4S(self, Vd: RegArg, Vn: RegArg, Vm: RegArg):
+        """Unsigned widening multiply, upper half (lanes 4-7 of 8 x 16 -> 4 x 32-bit)"""
+        self._legacy("umull2", ("4S", "8H", "8H"), Vd, Vn, Vm)
+
+    def UMLAL_2D(self, Vd: RegArg, Vn: RegArg, Vm: RegArg):
+        """
+        Unsigned widening multiply-accumulate, lower half (2 x 32 -> 2 x 64-bit):
+
+            Vd.2D[i] += Vn.2S[i] * Vm.2S[i]     (mod 2^64, no carry out of the lane)
+        """
+        self._legacy("umlal", ("2D", "2S", "2S"), Vd, Vn, Vm, reads_dst=True)
+
+    def UMLAL2_2D(self, Vd: RegArg, Vn: RegArg, Vm: RegArg):
+        """Unsigned widening multiply-accumulate, upper half (lanes 2-3 of 4 x 32 -> 2 x 64-bit)"""
+        self._legacy("umlal2", ("2D", "4S", "4S"), Vd, Vn, Vm, reads_dst=True)
+
+    def UMLAL_4S(self, Vd: RegArg, Vn: RegArg, Vm: RegArg):
+        """Unsigned widening multiply-accumulate, lower half (4 x 16 -> 4 x 32-bit)"""
+        self._legacy("umlal", ("4S", "4H", "4H"), Vd, Vn, Vm, reads_dst=True)
+
+    def UMLAL2_4S(self, Vd: RegArg, Vn: RegArg, Vm: RegArg):
+        """Unsigned widening multiply-accumulate, upper half (lanes 4-7 of 8 x 16 -> 4 x 32-bit)"""
+        self._legacy("umlal2", ("4S", "8H", "8H"), Vd, Vn, Vm, reads_dst=True)
+
+    def SMULL_2D(self, Vd: RegArg, Vn: RegArg, Vm: RegArg):
+        """
+        Signed widening multiply, lower half (2 x 32 -> 2 x 64-bit):
+
+            Vd.2D[i] = Vn.2S[i] * Vm.2S[i]      (operands sign-extended)
+        """
+        self._legacy("smull", ("2D", "2S", "2S"), Vd, Vn, Vm)
+
+    def SMULL2_2D(self, Vd: RegArg, Vn: RegArg, Vm: RegArg):
+        """Signed widening multiply, upper half (lanes 2-3 of 4 x 32 -> 2 x 64-bit)"""
+        self._legacy("smull2", ("2D", "4S", "4S"), Vd, Vn, Vm)
+
+    def SMULL_4S(self, Vd: RegArg, Vn: RegArg, Vm: RegArg):
+        """Signed widening multiply, lower half (4 x 16 -> 4 x 32-bit)"""
+        self._legacy("smull", ("4S", "4H", "4H"), Vd, Vn, Vm)
+
+    # ---------- shifts, masks and lane moves for carry handling ----------
+    def USHR_2D(self, Vd: RegArg, Vn: RegArg, shift: int):
+        """
+        Unsigned shift right (2 x 64-bit): Vd.2D[i] = Vn.2D[i] >> shift, shift in 1-64.
+        The carry out of a radix-2^w limb held in a 64-bit lane is USHR by w.
+        """
+        if not 1 <= shift <= 64:
+            raise ValueError("USHR shift for 2D must be in range [1, 64]")
+        self._legacy("ushr", ("2D", "2D"), Vd, Vn, imm=shift)
+
+    def USRA_2D(self, Vd: RegArg, Vn: RegArg, shift: int):
+        """Unsigned shift right and accumulate (2 x 64-bit): Vd.2D[i] += Vn.2D[i] >> shift, shift in 1-64"""
+        if not 1 <= shift <= 64:
+            raise ValueError("USRA shift for 2D must be in range [1, 64]")
+        self._legacy("usra", ("2D", "2D"), Vd, Vn, imm=shift, reads_dst=True)
+
+    def AND_16B(self, Vd: RegArg, Vn: RegArg, Vm: RegArg):
+        """Bitwise AND (128-bit): Vd = Vn & Vm"""
+        self._legacy("and", ("16B",) * 3, Vd, Vn, Vm)
+
+    def DUP_2D(self, Vd: RegArg, Xn: RegArg):
+        """Duplicate a general register into both 64-bit lanes: Vd.2D[i] = Xn"""
+        dst_str = self._validate_vector_register(Vd, "Vd")
+        src_str = self._reg_to_str(Xn)
+        if not src_str.startswith("x"):
+            raise TypeError(f"Parameter 'Xn' must be a 64-bit general register, got '{src_str}'")
+        self._simd("dup", f"{dst_str}.2D", src_str)
+
+    def XTN_2S(self, Vd: RegArg, Vn: RegArg):
+        """Narrow (2 x 64 -> 2 x 32-bit, lower half of Vd, upper half zeroed): Vd.2S[i] = Vn.2D[i] mod 2^32"""
+        self._legacy("xtn", ("2S", "2D"), Vd, Vn)
+
+    def XTN2_4S(self, Vd: RegArg, Vn: RegArg):
+        """Narrow into the upper half (lanes 2-3), keeping lanes 0-1: Vd.4S[i + 2] = Vn.2D[i] mod 2^32"""
+        self._legacy("xtn2", ("4S", "2D"), Vd, Vn, reads_dst=True)
@@ -0,0 +1,25 @@
+# armasmgen/passes/__init__.py
+"""
+Transformation passes over recorded instruction streams.
+
+    analysis  ── register/memory introspection of Instruction records
+    unroll    ── loop body replication with induction-pointer folding
+    modulo    ── iterative modulo scheduling (software pipelining)
+    fusion    ── macro-op fusion pair detection, repair and reporting
+    renaming  ── liveness-based register renaming against WAR/WAW hazards
+    interleave ── round-robin merge of independent streams, flag chains kept whole
+    prefetch  ── PRFM insertion for strided pointer streams in loops
+"""
+
+from .unroll import unroll_body, induction_pointers
+from .modulo import ModuloSchedule, ScheduleReport
+from .fusion import fuse_pairs, find_pairs, FusionReport
+from .renaming import rename_registers, liveness, RenameReport
+from .interleave import interleave, flag_units
+from .prefetch import insert_prefetches, pointer_streams, PrefetchPolicy, PrefetchReport
+
+__all__ = ["unroll_body", "induction_pointers", "ModuloSchedule", "ScheduleReport",
+           "fuse_pairs", "find_pairs", "FusionReport",
+           "rename_registers", "liveness", "RenameReport",
+           "interleave", "flag_units",
+           "insert_prefetches", "pointer_streams", "PrefetchPolicy", "PrefetchReport"]
@@ -0,0 +1,243 @@
+# armasmgen/passes/analysis.py
+"""
+Instruction introspection shared by the transformation passes.
+
+The mixins record every instruction as a template plus dsts/srcs strings.
+The helpers here recover what the passes need from that record:
+canonical register names, memory addressing, and re-rendering an access
+with a different offset or indexing mode.
+"""
+
+import re
+from dataclasses import dataclass, replace
+from typing import Optional
+
+from ..core import Instruction
+
+# Registers that never carry a dependency
+ZERO_REGS = {"xzr", "wzr"}
+
+_ADDR_RE = re.compile(
+    r"\[(?P<base>\{\w+\}|\w+)(?:, #\{(?P<off>\w+)\})?\](?P<wb>!?)(?:, #\{(?P<post>\w+)\})?$"
+)
+
+_ACCESS_SIZE = {"x": 8, "w": 4, "q": 16, "d": 8, "s": 4, "h": 2, "b": 1, "v": 16}
+
+# LD1-LD4 / ST1-ST4: "ld2 {{v0.4S, v1.4S}}, [{base}], #{offset}", lane form "{{v0.S}}[1]"
+_STRUCTURED = {f"{op}{n}" for op in ("ld", "st") for n in (1, 2, 3, 4)} | {f"ld{n}r" for n in (1, 2, 3, 4)}
+_LIST_RE = re.compile(r"\{\{(?P<regs>[^}]*)\}\}(?P<lane>\[\d+\])?")
+_STRUCTURED_ADDR_RE = re.compile(r"\[\{base\}\](?:, (?:#\{(?P<post>offset)\}|\{(?P<step>step)\}))?$")
+_ELEMENT_BYTES = {"b": 1, "h": 2, "s": 4, "d": 8}
+
+
+def mnemonic(inst: Instruction) -> str:
+    """First token of the template ("" for labels, comments and directives)."""
+    head = inst.template.split(" ", 1)[0]
+    if not head or head.endswith(":") or head.startswith((".", "//")):
+        return ""
+    return head.lower()
+
+
+def is_label(inst: Instruction) -> bool:
+    return inst.template.endswith(":") and " " not in inst.template
+
+
+def canonical(reg: str) -> Optional[str]:
+    """
+    Map a register name to the architectural register it occupies:
+    w3/x3 -> x3, q5/d5/s5/v5/z5 -> v5 (z5 extends v5), p2.s/p2/z -> p2.
+    Returns None for the zero register.
+    """
+    reg = reg.strip().lower()
+    if reg in ZERO_REGS:
+        return None
+    m = re.fullmatch(r"([xw])(\d+)", reg)
+    if m:
+        return f"x{m.group(2)}"
+    m = re.fullmatch(r"([vqdshbz])(\d+)(?:\..*)?", reg)
+    if m:
+        return f"v{m.group(2)}"
+    m = re.fullmatch(r"p(\d+)(?:[./].*)?", reg)
+    if m:
+        return f"p{m.group(1)}"
+    return reg
+
+
+def defs(inst: Instruction) -> set:
+    return {c for c in map(canonical, inst.dsts) if c}
+
+
+def uses(inst: Instruction) -> set:
+    return {c for c in map(canonical, inst.srcs) if c}
+
+
+# Condition flags are not recorded by the mixins; derive them from the mnemonic
+FLAGS = "nzcv"
+_FLAG_SETTERS = {"adds", "adcs", "subs", "sbcs", "negs", "ngcs", "ands", "bics",
+                 "cmp", "cmn", "tst", "ccmp", "ccmn", "whilelt", "whilelo"}
+_FLAG_READERS = {"adc", "adcs", "sbc", "sbcs", "ngc", "ngcs", "csel", "csinc", "csinv",
+                 "csneg", "cset", "csetm", "cinc", "cinv", "cneg", "ccmp", "ccmn"}
+
+
+def writes_flags(inst: Instruction) -> bool:
+    return mnemonic(inst) in _FLAG_SETTERS
+
+
+def reads_flags(inst: Instruction) -> bool:
+    op = mnemonic(inst)
+    return op in _FLAG_READERS or op.startswith("b.")
+
+
+def defs_with_flags(inst: Instruction) -> set:
+    return defs(inst) | ({FLAGS} if writes_flags(inst) else set())
+
+
+def uses_with_flags(inst: Instruction) -> set:
+    return uses(inst) | ({FLAGS} if reads_flags(inst) else set())
+
+
+def spelled_out(inst: Instruction, reg: str) -> bool:
+    """True if the template names the (canonical) register literally, out of reach of rename()."""
+    n = reg[1:]
+    pattern = {"x": rf"\b[xw]{n}\b", "p": rf"\bp{n}\b"}.get(reg[0], rf"\b[vqdshbz]{n}\b")
+    return re.search(pattern, inst.template) is not None
+
+
+def rename(inst: Instruction, mapping: dict) -> Instruction:
+    """
+    Substitute registers (keyed by canonical name, e.g. {"x5": "x9"}),
+    keeping the width of each occurrence: w5 -> w9, q5 -> q9.
+    """
+    def sub(value):
+        if not isinstance(value, str):
+            return value
+        target = mapping.get(canonical(value))
+        if target is None:
+            return value
+        m = re.fullmatch(r"([a-z]+?)(\d+)([./].*)?", value.strip(), re.IGNORECASE)
+        suffix = m.group(3) or ""
+        return f"{m.group(1)}{re.sub(r'^[a-z]+', '', target)}{suffix}"
+
+    return replace(inst,
+                   dsts=[sub(d) for d in inst.dsts],
+                   srcs=[sub(s) for s in inst.srcs],
+                   kwargs={k: sub(v) for k, v in inst.kwargs.items()})
+
+
+@dataclass
+class MemAccess:
+    """Addressing of a load/store: base register, offset and indexing mode."""
+    base: str           # register string as it appears in the kwargs
+    base_key: str       # kwarg name holding the base ("" for a literal base)
+    offset: int         # immediate offset (0 when absent)
+    mode: str           # "offset" | "pre" | "post" | "post_reg" (base += register)
+    size: int           # bytes per transferred register
+    count: int          # number of transferred registers (1 or 2; up to 4 for LD1-LD4/ST1-ST4)
+    is_load: bool
+    structured: bool = False    # LD1-LD4/ST1-ST4: no offset form, post-index only by the transfer size
+
+
+def mem_access(inst: Instruction) -> Optional[MemAccess]:
+    """Decode the addressing of a single-register, pair or structured load/store."""
+    op = mnemonic(inst)
+    if op in _STRUCTURED:
+        return _structured_access(inst, op)
+    if op not in ("ldr", "str", "ldp", "stp", "ldur", "stur"):
+        return None
+    m = _ADDR_RE.search(inst.template)
+    if not m:
+        return None
+    raw_base = m.group("base")
+    if raw_base.startswith("{"):
+        base_key = raw_base[1:-1]
+        base = inst.kwargs[base_key]
+    else:
+        base_key, base = "", raw_base
+    if m.group("post"):
+        mode, offset = "post", inst.kwargs[m.group("post")]
+    elif m.group("off"):
+        mode = "pre" if m.group("wb") else "offset"
+        offset = inst.kwargs[m.group("off")]
+    else:
+        mode, offset = "offset", 0
+    first_reg = inst.template.split(" ", 1)[1].split(",")[0].strip()
+    if first_reg.startswith("{"):
+        first_reg = inst.kwargs[first_reg[1:-1]]
+    size = _ACCESS_SIZE.get(first_reg.strip().lower()[0], 8)
+    return MemAccess(base=base, base_key=base_key, offset=offset, mode=mode,
+                     size=size, count=2 if op in ("ldp", "stp") else 1,
+                     is_load=op.startswith("ld"))
+
+
+def _structured_access(inst: Instruction, op: str) -> Optional[MemAccess]:
+    regs, addr = _LIST_RE.search(inst.template), _STRUCTURED_ADDR_RE.search(inst.template)
+    if not regs or not addr:
+        return None
+    names = [r.strip() for r in regs.group("regs").split(",")]
+    arrangement = names[0].split(".")[1].lower()
+    if regs.group("lane") or op.endswith("r"):
+        size = _ELEMENT_BYTES[arrangement[-1]]
+    else:
+        lanes = int(arrangement[:-1])
+        size = lanes * _ELEMENT_BYTES[arrangement[-1]]
+    if addr.group("post"):
+        mode, offset = "post", inst.kwargs["offset"]
+    elif addr.group("step"):
+        mode, offset = "post_reg", 0
+    else:
+        mode, offset = "offset", 0
+    return MemAccess(base=inst.kwargs["base"], base_key="base", offset=offset, mode=mode,
+                     size=size, count=len(names), is_load=op.startswith("ld"), structured=True)
+
+
+def offset_encodable(acc: MemAccess, offset: int, mode: str) -> bool:
+    """Whether the immediate fits the encoding of this access in the given mode."""
+    if acc.structured:
+        # [base] or [base], #transfer-size only
+        return offset == 0 if mode == "offset" else mode == "post" and offset == acc.size * acc.count
+    if acc.count == 2:
+        return offset % acc.size == 0 and -64 * acc.size <= offset <= 63 * acc.size
+    if -256 <= offset <= 255:
+        return True
+    # Scaled unsigned form exists only without writeback
+    return mode == "offset" and offset % acc.size == 0 and 0 <= offset <= 4095 * acc.size
+
+
+def with_address(inst: Instruction, offset: int, mode: str = "offset") -> Instruction:
+    """
+    Re-render a load/store with a new immediate offset and indexing mode.
+    The base register is unchanged; writeback modes record the base as a destination.
+    """
+    acc = mem_access(inst)
+    if acc is None:
+        raise ValueError(f"not a load/store: {inst.template}")
+    head = _ADDR_RE.sub("", inst.template)
+    base_ref = "{base}" if acc.base_key else acc.base
+    if mode == "post":
+        addr = f"[{base_ref}], #{{offset}}"
+    elif mode == "pre":
+        addr = f"[{base_ref}, #{{offset}}]!"
+    elif offset:
+        addr = f"[{base_ref}, #{{offset}}]"
+    else:
+        addr = f"[{base_ref}]"
+
+    kwargs = {k: v for k, v in inst.kwargs.items()
+              if k not in (acc.base_key, "offset", "imm", "addr")}
+    if acc.base_key:
+        kwargs["base"] = acc.base
+    if "{offset}" in addr:
+        kwargs["offset"] = offset
+
+    base_canon = canonical(acc.base)
+    dsts = [d for d in inst.dsts if canonical(d) != base_canon or _is_transfer_reg(inst, d)]
+    if mode in ("pre", "post"):
+        dsts.append(acc.base)
+    return replace(inst, template=head + addr, dsts=dsts, kwargs=kwargs)
+
+
+def _is_transfer_reg(inst: Instruction, reg: str) -> bool:
+    """True if reg is one of the loaded registers (as opposed to a written-back base)."""
+    operands = inst.template.split(" ", 1)[1].split("[", 1)[0]
+    names = [o.strip()[1:-1] for o in operands.split(",") if o.strip().startswith("{")]
+    return any(inst.kwargs.get(n) == reg for n in names)
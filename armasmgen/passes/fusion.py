@@ -0,0 +1,138 @@
+# armasmgen/passes/fusion.py
+"""
+Macro-op fusion awareness.
+
+Cores fuse some dependent pairs (CMP+B.cond, ADRP+ADD, MOVZ+MOVK,
+AESE+AESMC, ...) into one macro-op, but only when the two instructions
+are adjacent in program order. The pairs a core fuses come from
+MachineModel.fusion_pairs.
+
+A fusion opportunity is a consumer together with the nearest earlier
+instruction of the same straight-line segment that produces one of its
+inputs (flags included), when the mnemonic pair is fusible and the
+consumer writes the producer's register (or nothing, as for B.cond).
+Labels and directives end a segment; comments are ignored.
+
+fuse_pairs() repairs broken opportunities by sliding the producer down to
+the consumer, or the consumer up to the producer, across instructions it
+is independent of, and reports what was kept, repaired and left broken.
+"""
+
+from dataclasses import dataclass, field
+from typing import List, Tuple
+
+from ..core import Instruction
+from ..machine import MachineModel
+from .analysis import defs, defs_with_flags, uses_with_flags, mnemonic, mem_access
+
+_BRANCHES = {"b", "bl", "br", "blr", "ret", "cbz", "cbnz", "tbz", "tbnz"}
+
+
+@dataclass
+class FusionReport:
+    function: str
+    model: str
+    kept: int = 0       # opportunities adjacent in the final stream
+    broken: int = 0     # opportunities that could not be made adjacent
+    repaired: int = 0   # kept opportunities that needed a move
+    pairs: List[Tuple[str, str]] = field(default_factory=list)   # broken pairs, rendered
+
+    def __str__(self):
+        return (f"fusion ({self.model}): {self.kept} kept, {self.broken} broken"
+                f"{f', {self.repaired} repaired' if self.repaired else ''}")
+
+
+def _is_branch(inst: Instruction) -> bool:
+    op = mnemonic(inst)
+    return op in _BRANCHES or op.startswith("b.")
+
+
+def _segments(insts: List[Instruction]) -> List[List[int]]:
+    """Positions of real instructions, split at labels, directives and after branches."""
+    segs, cur = [], []
+    for pos, inst in enumerate(insts):
+        if not mnemonic(inst):
+            if inst.template.startswith("//") or not inst.template.strip():
+                continue
+            segs.append(cur)
+            cur = []
+            continue
+        cur.append(pos)
+        if _is_branch(inst):
+            segs.append(cur)
+            cur = []
+    segs.append(cur)
+    return [s for s in segs if len(s) > 1]
+
+
+def find_pairs(insts: List[Instruction], model: MachineModel) -> List[Tuple[int, int]]:
+    """Fusion opportunities as (producer, consumer) positions in insts."""
+    pairs, taken = [], set()
+    for seg in _segments(insts):
+        for jj in range(1, len(seg)):
+            cons = insts[seg[jj]]
+            need = uses_with_flags(cons)
+            for ii in range(jj - 1, -1, -1):
+                prod = insts[seg[ii]]
+                if not defs_with_flags(prod) & need:
+                    continue
+                if (model.fuses(prod, cons) and seg[ii] not in taken and seg[jj] not in taken
+                        and (not defs(cons) or defs(cons) == defs(prod))):
+                    pairs.append((seg[ii], seg[jj]))
+                    taken.update((seg[ii], seg[jj]))
+                break
+    return pairs
+
+
+def _adjacent(insts, a, b) -> bool:
+    return all(insts[p].template.startswith("//") or not insts[p].template.strip()
+               for p in range(a + 1, b))
+
+
+def _independent(x: Instruction, y: Instruction) -> bool:
+    dx, dy = defs_with_flags(x), defs_with_flags(y)
+    if dx & (uses_with_flags(y) | dy) or dy & uses_with_flags(x):
+        return False
+    return not (mem_access(x) and mem_access(y))
+
+
+def _join(insts: List[Instruction], prod: int, cons: int) -> bool:
+    between = [insts[p] for p in range(prod + 1, cons)]
+    p_inst, c_inst = insts[prod], insts[cons]
+    # Slide the producer down to the consumer
+    if not _is_branch(p_inst) and all(_independent(p_inst, m) for m in between):
+        insts.insert(cons - 1, insts.pop(prod))
+        return True
+    # Or lift the consumer up to the producer
+    if not _is_branch(c_inst) and all(_independent(c_inst, m) for m in between):
+        insts.insert(prod + 1, insts.pop(cons))
+        return True
+    return False
+
+
+def fuse_pairs(insts: List[Instruction], model: MachineModel, *,
+               function: str = "", repair: bool = True):
+    """
+    Return (instructions, FusionReport). With repair, broken opportunities
+    are made adjacent where the instructions in between allow it.
+    """
+    out, repaired = list(insts), 0
+    if repair:
+        for _ in range(len(out)):
+            moved = False
+            for prod, cons in find_pairs(out, model):
+                if not _adjacent(out, prod, cons) and _join(out, prod, cons):
+                    repaired, moved = repaired + 1, True
+                    break
+            if not moved:
+                break
+
+    report = FusionReport(function=function, model=model.name, repaired=repaired)
+    for prod, cons in find_pairs(out, model):
+        if _adjacent(out, prod, cons):
+            report.kept += 1
+        else:
+            report.broken += 1
+            report.pairs.append((out[prod].render(), out[cons].render()))
+    report.repaired = min(report.repaired, report.kept)
+    return out, report
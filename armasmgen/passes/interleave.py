@@ -0,0 +1,76 @@
+# armasmgen/passes/interleave.py
+"""
+Interleaving of independent straight-line instruction streams.
+
+k products (or reductions, or hash rounds) that share no registers form k
+dependence chains; issued one after the other, a wide core idles on each
+chain's latency in turn. Merged instruction by instruction, the chains
+fill the pipelines together.
+
+The condition flags are the one resource the streams cannot share. Each
+stream is cut into units: an instruction that leaves the flags dead is a
+unit on its own, and a run that starts with a flag write stays one unit
+up to its last flag reader (ADDS ... ADCS ... ADC). Units are taken
+round-robin, so no stream's ADDS lands inside another stream's carry
+chain.
+
+The streams must use disjoint registers, which interleave() checks;
+memory is not examined, so the streams must not write anything another
+one reads. Labels and branches are rejected.
+"""
+
+from typing import List
+
+from ..core import Instruction
+from .analysis import defs, is_label, mnemonic, reads_flags, uses, writes_flags
+
+_BRANCHES = {"b", "bl", "br", "blr", "ret", "cbz", "cbnz", "tbz", "tbnz"}
+
+
+def flag_units(insts: List[Instruction]) -> List[List[Instruction]]:
+    """Split a stream where the flags are dead; comments stay with the instruction after them."""
+    live_after = [False] * len(insts)
+    live = False
+    for i in range(len(insts) - 1, -1, -1):
+        live_after[i] = live
+        if mnemonic(insts[i]):
+            live = reads_flags(insts[i]) or (live and not writes_flags(insts[i]))
+
+    units, current = [], []
+    for inst, live in zip(insts, live_after):
+        current.append(inst)
+        if mnemonic(inst) and not live:
+            units.append(current)
+            current = []
+    if current:
+        units.append(current)
+    return units
+
+
+def _registers(insts: List[Instruction]) -> set:
+    regs = set()
+    for inst in insts:
+        regs |= defs(inst) | uses(inst)
+    return regs - {"sp"}
+
+
+def interleave(streams: List[List[Instruction]]) -> List[Instruction]:
+    """Merge independent streams unit by unit, round-robin (see flag_units)."""
+    seen = set()
+    for stream in streams:
+        for inst in stream:
+            op = mnemonic(inst)
+            if is_label(inst) or op in _BRANCHES or op.startswith("b."):
+                raise ValueError(f"cannot interleave control flow: {inst.render()}")
+        regs = _registers(stream)
+        if regs & seen:
+            raise ValueError(f"interleaved streams share registers {sorted(regs & seen)}")
+        seen |= regs
+
+    queues = [flag_units(s) for s in streams]
+    merged = []
+    for step in range(max((len(q) for q in queues), default=0)):
+        for q in queues:
+            if step < len(q):
+                merged.extend(q[step])
+    return merged
@@ -0,0 +1,460 @@
+# armasmgen/passes/modulo.py
+"""
+Iterative modulo scheduling (software pipelining) for Loop(..., pipeline=model).
+
+The loop body is turned into a dependence graph whose edges carry a
+latency and an iteration distance:
+
+    registers   RAW / WAR / WAW, within an iteration (d=0) and into the next (d=1)
+    flags       NZCV treated as one more register (derived from the mnemonic)
+    memory      exact overlap test for accesses through the same induction
+                pointer, conservative ordering otherwise (unless noalias)
+
+Induction pointers are virtualised: their increments disappear from the
+graph and every access becomes a fixed offset from the pointer value at
+loop entry, so the pointer update never constrains the schedule.
+
+The initiation interval starts at MII = max(ResMII, RecMII):
+
+    ResMII  busiest functional unit (occupancy / unit count) or the issue width
+    RecMII  smallest II for which no dependence cycle has positive weight
+            sum(latency) - II * sum(distance)
+
+and grows until the iterative scheduler (Rau, 1994) places every op in the
+modulo reservation table within its budget.
+
+Registers whose first access in the body is a write are iteration-local.
+Their loop-carried WAR/WAW edges are dropped and lifetimes longer than II
+are handled by modulo variable expansion: the kernel is replicated u times
+with those registers renamed to scratch registers. Registers read before
+they are written (carries, accumulators) keep every edge.
+"""
+
+import re
+from dataclasses import dataclass, replace
+from typing import Dict, List, Optional
+
+from ..core import Instruction
+from ..machine import MachineModel, OpTiming
+from .analysis import (canonical, defs_with_flags, uses_with_flags, is_label,
+                       mem_access, offset_encodable, rename, spelled_out, with_address)
+from .fusion import fuse_pairs
+from .unroll import _self_increment, induction_pointers, fold_post_index, pointer_advance
+
+# Farthest iteration distance examined for accesses through the same pointer
+_MAX_MEM_DISTANCE = 16
+
+
+@dataclass
+class ScheduleReport:
+    model: str
+    ops: int            # scheduled instructions per iteration
+    ii: int             # achieved initiation interval (cycles per iteration)
+    res_mii: int        # resource-bound lower limit
+    rec_mii: int        # recurrence-bound lower limit
+    stages: int         # iterations in flight in the kernel
+    mve_unroll: int     # kernel copies needed by modulo variable expansion
+
+    @property
+    def mii(self) -> int:
+        return max(self.res_mii, self.rec_mii)
+
+    def __str__(self):
+        return (f"modulo schedule ({self.model}): II={self.ii} "
+                f"(ResMII={self.res_mii}, RecMII={self.rec_mii}), "
+                f"stages={self.stages}, MVE x{self.mve_unroll}")
+
+
+@dataclass
+class _Op:
+    inst: Instruction
+    timing: OpTiming
+    ptr: Optional[str] = None   # virtualised base register
+    addr: int = 0               # offset from the pointer value at the start of the iteration
+    span: int = 0               # bytes touched (memory ops only)
+    is_load: bool = False
+
+
+class _Unencodable(Exception):
+    def __init__(self, ptr):
+        super().__init__(ptr)
+        self.ptr = ptr
+
+
+class ModuloSchedule:
+    """
+    Modulo schedule of one loop body.
+
+        sched = ModuloSchedule(body, NEOVERSE_N1, scratch=["x9", "x10"])
+        sched.prologue(), sched.kernel(), sched.epilogue(), sched.fixups()
+
+    One kernel pass starts `unroll` iterations; the prologue starts the
+    first stages-1 iterations and the epilogue drains the last ones, so
+    prologue + P kernel passes + epilogue run stages-1 + P*unroll iterations.
+    """
+
+    def __init__(self, body: List[Instruction], model: MachineModel, *,
+                 scratch=(), noalias: bool = False):
+        if any(is_label(i) for i in body):
+            raise ValueError("Cannot pipeline a loop body that defines labels (nested loop?)")
+        self.model = model
+        self.noalias = noalias
+        pointers = induction_pointers(body)
+        while True:
+            try:
+                self._build(body, pointers, scratch)
+                return
+            except _Unencodable as e:
+                pointers = pointers - {e.ptr}
+
+    # ---------- construction ----------
+    @classmethod
+    def bounds(cls, body: List[Instruction], model: MachineModel, *, noalias: bool = False):
+        """
+        (ResMII, RecMII) of the body without scheduling it: the cycles per
+        iteration no schedule beats, and what an out-of-order core that
+        renames the iteration-local registers approaches. The core renames
+        LD1-LD4 list registers too, so they count as iteration-local here.
+        """
+        sched = cls.__new__(cls)
+        sched.model, sched.noalias = model, noalias
+        sched._analyse(body, induction_pointers(body), rename_lists=True)
+        return sched._res_mii(), sched._rec_mii()
+
+    def _analyse(self, body, pointers, rename_lists=False):
+        self._virtualise(body, pointers)
+        self.local = self._iteration_local(rename_lists)
+        self.edges = self._register_edges() + self._memory_edges()
+
+    def _build(self, body, pointers, scratch):
+        self._analyse(body, pointers)
+        res_mii, rec_mii = self._res_mii(), self._rec_mii()
+        ii = max(res_mii, rec_mii, 1)
+        while True:
+            times = self._iterative_schedule(ii)
+            if times is not None:
+                break
+            ii += 1
+        self.ii, self.times = ii, times
+        self.stages = max(times) // ii + 1 if times else 1
+        self._expand(scratch)
+        self.report = ScheduleReport(self.model.name, len(self.ops), ii, res_mii, rec_mii,
+                                     self.stages, self.unroll)
+        # Validate every offset the emitted code will use
+        self.prologue(), self.kernel(), self.epilogue()
+
+    def _virtualise(self, body, pointers):
+        self.ops: List[_Op] = []
+        self.step: Dict[str, int] = {p: 0 for p in pointers}
+        self.names: Dict[str, str] = {}
+        for inst in body:
+            inc = _self_increment(inst)
+            if inc and inc[0] in pointers:
+                self.step[inc[0]] += inc[1]
+                self.names[inc[0]] = inst.kwargs["dst"]
+                continue
+            acc = mem_access(inst)
+            base = canonical(acc.base) if acc else None
+            op = _Op(inst, self.model.timing(inst))
+            if acc:
+                op.span, op.is_load = acc.size * acc.count, acc.is_load
+            if base in pointers:
+                self.names[base] = acc.base
+                if acc.mode == "pre":
+                    self.step[base] += acc.offset
+                op.addr = self.step[base] + (acc.offset if acc.mode == "offset" else 0)
+                if acc.mode == "post":
+                    self.step[base] += acc.offset
+                op.ptr = base
+                op.inst = with_address(inst, op.addr, "offset")
+            self.ops.append(op)
+        self.pointers = set(pointers)
+
+    def _defs(self, op):
+        return defs_with_flags(op.inst) - self.pointers
+
+    def _uses(self, op):
+        return uses_with_flags(op.inst) - self.pointers
+
+    def _iteration_local(self, rename_lists=False) -> set:
+        """Renamable registers whose first access in the body is a write."""
+        seen, local = set(), set()
+        for op in self.ops:
+            seen |= self._uses(op)
+            for reg in self._defs(op):
+                if reg not in seen and re.fullmatch(r"[xv]\d+", reg):
+                    local.add(reg)
+                seen.add(reg)
+        # Registers spelled out in a template (LD1-LD4 lists) cannot take another name
+        if rename_lists:
+            return local
+        return {reg for reg in local if not any(spelled_out(op.inst, reg) for op in self.ops)}
+
+    def _register_edges(self):
+        n, edges = len(self.ops), []
+        last_def: Dict[str, int] = {}
+        readers: Dict[str, List[int]] = {}
+
+        def add(src, dst, lat, reg=None):
+            # reg is given for WAR/WAW edges, which renaming removes across iterations
+            if dst < n:
+                edges.append((src, dst, lat, 0))
+            elif src < n and (reg is None or reg not in self.local):
+                edges.append((src, dst - n, lat, 1))
+
+        # Two copies of the body give the nearest dependence inside and across iterations
+        for pos in range(2 * n):
+            op = self.ops[pos % n]
+            for reg in self._uses(op):
+                if reg in last_def:
+                    src = last_def[reg]
+                    add(src, pos, self.ops[src % n].timing.latency)
+                readers.setdefault(reg, []).append(pos)
+            for reg in self._defs(op):
+                for r in readers.get(reg, []):
+                    if r != pos:
+                        add(r, pos, 0, reg)
+                if reg in last_def:
+                    add(last_def[reg], pos, 0, reg)
+                last_def[reg], readers[reg] = pos, []
+        return edges
+
+    def _memory_edges(self):
+        mem = [i for i, op in enumerate(self.ops) if op.span]
+        edges = []
+        for i in mem:
+            for j in mem:
+                a, b = self.ops[i], self.ops[j]
+                if a.is_load and b.is_load:
+                    continue
+                lat = 1 if not a.is_load and b.is_load else 0
+                if a.ptr and a.ptr == b.ptr:
+                    step = self.step[a.ptr]
+                    for d in range(0 if i < j else 1, _MAX_MEM_DISTANCE + 1):
+                        lo = b.addr + d * step
+                        if a.addr < lo + b.span and lo < a.addr + a.span:
+                            edges.append((i, j, lat, d))
+                    continue
+                same_base = canonical(mem_access(a.inst).base) == canonical(mem_access(b.inst).base)
+                if self.noalias and not same_base:
+                    continue
+                if i < j:
+                    edges.append((i, j, lat, 0))
+                edges.append((i, j, lat, 1))
+        return edges
+
+    # ---------- bounds ----------
+    def _res_mii(self) -> int:
+        busy: Dict[str, int] = {}
+        for op in self.ops:
+            busy[op.timing.unit] = busy.get(op.timing.unit, 0) + op.timing.occupancy
+        bound = -(-len(self.ops) // self.model.issue_width)
+        for unit, cycles in busy.items():
+            bound = max(bound, -(-cycles // self.model.units.get(unit, 1)))
+        return bound
+
+    def _has_positive_cycle(self, ii) -> bool:
+        n, neg = len(self.ops), float("-inf")
+        dist = [[neg] * n for _ in range(n)]
+        for s, d, lat, k in self.edges:
+            dist[s][d] = max(dist[s][d], lat - ii * k)
+        for k in range(n):
+            dk = dist[k]
+            for i in range(n):
+                dik = dist[i][k]
+                if dik == neg:
+                    continue
+                di = dist[i]
+                for j in range(n):
+                    if dik + dk[j] > di[j]:
+                        di[j] = dik + dk[j]
+        return any(dist[i][i] > 0 for i in range(n))
+
+    def _rec_mii(self) -> int:
+        if not any(k for *_, k in self.edges):
+            return 0
+        lo, hi = 1, sum(lat for _, _, lat, _ in self.edges) + 1
+        while lo < hi:
+            mid = (lo + hi) // 2
+            if self._has_positive_cycle(mid):
+                lo = mid + 1
+            else:
+                hi = mid
+        return lo
+
+    # ---------- scheduling ----------
+    def _iterative_schedule(self, ii) -> Optional[List[int]]:
+        n, model = len(self.ops), self.model
+        preds = [[] for _ in range(n)]
+        succs = [[] for _ in range(n)]
+        for s, d, lat, k in self.edges:
+            preds[d].append((s, lat - ii * k))
+            succs[s].append((d, lat - ii * k))
+
+        # Priority: longest path to the end of the iteration
+        height = [op.timing.latency for op in self.ops]
+        for _ in range(n):
+            changed = False
+            for s, d, lat, k in self.edges:
+                if height[d] + lat - ii * k > height[s]:
+                    height[s], changed = height[d] + lat - ii * k, True
+            if not changed:
+                break
+
+        time: List[Optional[int]] = [None] * n
+        last: List[Optional[int]] = [None] * n
+        unit_use: Dict[tuple, List[int]] = {}
+        issue_use: Dict[int, List[int]] = {}
+
+        def slots(o, t):
+            tm = self.ops[o].timing
+            return [((t + c) % ii, tm.unit) for c in range(tm.occupancy)]
+
+        def fits(o, t):
+            if len(issue_use.get(t % ii, [])) >= model.issue_width:
+                return False
+            need: Dict[tuple, int] = {}
+            for slot in slots(o, t):
+                need[slot] = need.get(slot, 0) + 1
+            return all(len(unit_use.get(s, [])) + c <= model.units.get(s[1], 1)
+                       for s, c in need.items())
+
+        def place(o, t):
+            time[o] = last[o] = t
+            issue_use.setdefault(t % ii, []).append(o)
+            for slot in slots(o, t):
+                unit_use.setdefault(slot, []).append(o)
+
+        def evict(o):
+            issue_use[time[o] % ii].remove(o)
+            for slot in slots(o, time[o]):
+                unit_use[slot].remove(o)
+            time[o] = None
+            pending.add(o)
+
+        pending = set(range(n))
+        budget = n * 8
+        while pending:
+            if budget == 0:
+                return None
+            budget -= 1
+            o = max(pending, key=lambda x: (height[x], -x))
+            pending.discard(o)
+            est = max([0] + [time[p] + w for p, w in preds[o] if time[p] is not None and p != o])
+            t = next((c for c in range(est, est + ii) if fits(o, c)), None)
+            if t is None:
+                t = est if last[o] is None or est > last[o] else last[o] + 1
+                while not fits(o, t):
+                    row = issue_use.get(t % ii, [])
+                    clash = [x for s in slots(o, t) for x in unit_use.get(s, [])]
+                    evict((clash or row)[0])
+            place(o, t)
+            for s, w in succs[o]:
+                if s != o and time[s] is not None and time[s] < t + w:
+                    evict(s)
+        self._sink(time, succs, fits, place, evict, pending)
+        base = min(time) if time else 0
+        return [t - base for t in time]
+
+    @staticmethod
+    def _sink(time, succs, fits, place, evict, pending):
+        """Move ops as late as their consumers allow, shortening register lifetimes."""
+        last, moved = max(time, default=0), True
+        while moved:
+            moved = False
+            for o in sorted(range(len(time)), key=lambda x: -time[x]):
+                bound = [time[s] - w for s, w in succs[o] if s != o]
+                if not bound:
+                    continue
+                bound.append(last)
+                t0 = time[o]
+                evict(o)
+                pending.discard(o)
+                t = next(c for c in range(min(bound), t0 - 1, -1) if c == t0 or fits(o, c))
+                place(o, t)
+                moved |= t != t0
+
+    # ---------- modulo variable expansion ----------
+    def _expand(self, scratch):
+        life: Dict[str, tuple] = {}
+        for op, t in zip(self.ops, self.times):
+            for reg in self._defs(op) & self.local:
+                first, end = life.get(reg, (t, t))
+                life[reg] = (min(first, t), max(end, t))
+            for reg in self._uses(op) & self.local:
+                first, end = life.get(reg, (t, t))
+                life[reg] = (first, max(end, t))
+        copies = {r: max(1, -(-(end - first) // self.ii)) for r, (first, end) in life.items()}
+        self.unroll = max(copies.values(), default=1)
+
+        used = set()
+        for op in self.ops:
+            used |= defs_with_flags(op.inst) | uses_with_flags(op.inst)
+        free = [canonical(s) for s in scratch]
+        clash = used.intersection(free)
+        if clash:
+            raise ValueError(f"scratch registers {sorted(clash)} are used by the loop body")
+
+        self.rename: List[Dict[str, str]] = [{} for _ in range(self.unroll)]
+        for reg in sorted(r for r, q in copies.items() if q > 1):
+            for c in range(1, self.unroll):
+                pick = next((s for s in free if s[0] == reg[0]), None)
+                if pick is None:
+                    raise ValueError(
+                        f"modulo variable expansion needs {self.unroll - 1} scratch "
+                        f"{'x' if reg[0] == 'x' else 'v'}-registers for {reg} (II={self.ii}); "
+                        "pass more via scratch=[...]")
+                free.remove(pick)
+                self.rename[c][reg] = pick
+
+    # ---------- emission ----------
+    def _instance(self, o, k, advanced):
+        op = self.ops[o]
+        inst = op.inst
+        if op.ptr:
+            offset = k * self.step[op.ptr] + op.addr - advanced * self.step[op.ptr]
+            if not offset_encodable(mem_access(inst), offset, "offset"):
+                raise _Unencodable(op.ptr)
+            inst = with_address(inst, offset, "offset")
+        else:
+            inst = replace(inst, kwargs=dict(inst.kwargs))
+        return rename(inst, self.rename[k % self.unroll])
+
+    def _region(self, iterations, lo, hi, advanced):
+        """Instances of the given iterations issuing in flat cycles [lo, hi), in issue order."""
+        picks = [(t + k * self.ii, k, o)
+                 for k in iterations for o, t in enumerate(self.times)
+                 if lo <= t + k * self.ii < hi]
+        out = [self._instance(o, k, advanced) for _, k, o in sorted(picks)]
+        # Issue order may separate pairs the decoder would fuse; rejoin them
+        return fuse_pairs(out, self.model)[0] if self.model.fusion_pairs else out
+
+    def prologue(self) -> List[Instruction]:
+        s = self.stages
+        return self._region(range(s - 1), 0, (s - 1) * self.ii, 0)
+
+    def kernel(self) -> List[Instruction]:
+        s, u = self.stages, self.unroll
+        out = self._region(range(s - 1 + u), (s - 1) * self.ii, (s - 1 + u) * self.ii, 0)
+        for p in sorted(self.pointers):
+            total = u * self.step[p]
+            if not total:
+                continue
+            accesses = [(i, mem_access(inst)) for i, inst in enumerate(out)]
+            positions = [i for i, acc in accesses if acc and canonical(acc.base) == p]
+            if not fold_post_index(out, positions, total):
+                out.extend(pointer_advance(self.ops[-1].inst, self.names[p], total))
+        return out
+
+    def epilogue(self) -> List[Instruction]:
+        s, u = self.stages, self.unroll
+        return self._region(range(s - 1 + u), (s - 1 + u) * self.ii, (2 * s - 1 + u) * self.ii, u)
+
+    def fixups(self) -> List[Instruction]:
+        """Advance the pointers over the iterations the prologue started."""
+        out = []
+        for p in sorted(self.pointers):
+            total = (self.stages - 1) * self.step[p]
+            if total:
+                out.extend(pointer_advance(self.ops[-1].inst, self.names[p], total))
+        return out
@@ -0,0 +1,183 @@
+# armasmgen/passes/prefetch.py
+"""
+Software prefetch insertion for Loop(..., prefetch=PrefetchPolicy(...)).
+
+A stream is an induction pointer (see unroll.induction_pointers): a
+register the loop body only uses as a load/store base and only advances
+by constants. Its step is the sum of the post/pre-index updates and
+``add/sub p, p, #imm`` in one pass of the body, its window the bytes the
+body touches relative to the pointer value at the top of the pass.
+
+At the top of the pass, each stream gets PRFMs for the bytes the body
+will reach `distance` iterations later, step / line of them a line apart.
+The pointer's alignment is unknown, so that tiles the stream with one
+PRFM per line only when the step is a whole number of lines; the loop
+replicates its pass line_period() times (at most policy.max_period) to
+make it one:
+
+    step = 128, line 64    2 PRFMs per pass
+    step =  96, line 64    the pass doubled (192 B), 3 PRFMs
+    step =  16, line 64    the pass four times over (64 B), 1 PRFM
+
+A stream that would need more than max_period copies, or whose PRFM
+offsets would leave the PRFM immediate range, gets ceil(step / line)
+PRFMs per pass, and some lines are prefetched twice.
+Streams the body stores through get the store hint (PSTL1KEEP by default,
+which fetches the line for writing), load-only streams the load hint.
+
+Pointers the body already prefetches by hand read the base outside an
+access and are not induction pointers, so they are left alone.
+"""
+
+from dataclasses import dataclass, field
+from math import gcd
+from typing import Dict, List, Optional, Tuple
+
+from ..core import Instruction
+from ..mixins.memory import PREFETCH_OPS, prefetch_instruction
+from .analysis import canonical, mem_access
+from .unroll import _self_increment, induction_pointers
+
+
+@dataclass
+class PrefetchPolicy:
+    distance: int = 8                       # iterations ahead
+    distance_bytes: Optional[int] = None    # bytes ahead of every stream (overrides distance)
+    load: str = "pldl1keep"                 # hint for load-only streams
+    store: str = "pstl1keep"                # hint for streams the body stores through
+    line: int = 64                          # cache line size in bytes
+    ops: Dict[str, Optional[str]] = field(default_factory=dict)   # per register: hint, or None to skip
+    max_period: int = 8                     # most copies of a pass made to advance by whole lines
+
+    def __post_init__(self):
+        if self.distance < 1:
+            raise ValueError("prefetch distance must be at least one iteration")
+        if self.distance_bytes is not None and self.distance_bytes < 1:
+            raise ValueError("prefetch distance in bytes must be positive")
+        if self.line < 8 or self.line & (self.line - 1):
+            raise ValueError("cache line size must be a power of two of at least 8 bytes")
+        if self.max_period < 1:
+            raise ValueError("prefetch period must be at least one pass")
+        for op in [self.load, self.store] + [op for op in self.ops.values() if op is not None]:
+            if op not in PREFETCH_OPS:
+                raise ValueError(f"prefetch hint must be (pld|pli|pst)l(1|2|3)(keep|strm), got '{op}'")
+        self.ops = {canonical(str(reg)): op for reg, op in self.ops.items()}
+
+
+@dataclass
+class Stream:
+    reg: str            # register as the body spells it
+    step: int           # bytes the pointer advances per pass
+    lo: int             # lowest byte touched, relative to the pointer at the top of the pass
+    hi: int             # one past the highest byte touched
+    stores: bool        # the body stores through the pointer
+
+
+@dataclass
+class PrefetchReport:
+    distance: int                                   # bytes ahead of the largest stream
+    streams: List[str] = field(default_factory=list)    # one line per prefetched stream
+    prfms: int = 0                                  # PRFMs per pass
+
+    def __str__(self):
+        if not self.streams:
+            return "prefetch: no strided streams"
+        return f"prefetch: {self.prfms} prfm per pass ({'; '.join(self.streams)})"
+
+
+def pointer_streams(body: List[Instruction]) -> Dict[str, Stream]:
+    """Induction pointers with their step and the window the body accesses, keyed by canonical name."""
+    pointers = induction_pointers(body)
+    offset = {p: 0 for p in pointers}
+    streams: Dict[str, Stream] = {}
+    for inst in body:
+        inc = _self_increment(inst)
+        if inc and inc[0] in pointers:
+            offset[inc[0]] += inc[1]
+            continue
+        acc = mem_access(inst)
+        base = canonical(acc.base) if acc else None
+        if base not in pointers:
+            continue
+        if acc.mode == "pre":
+            offset[base] += acc.offset
+        addr = offset[base] + (acc.offset if acc.mode == "offset" else 0)
+        if acc.mode == "post":
+            offset[base] += acc.offset
+        end = addr + acc.size * acc.count
+        s = streams.get(base)
+        if s is None:
+            streams[base] = Stream(acc.base, 0, addr, end, not acc.is_load)
+        else:
+            s.lo, s.hi, s.stores = min(s.lo, addr), max(s.hi, end), s.stores or not acc.is_load
+    for p, s in streams.items():
+        s.step = offset[p]
+    return {p: s for p, s in streams.items() if s.step}
+
+
+def _prefetched_streams(body: List[Instruction], policy: PrefetchPolicy) -> Dict[str, Stream]:
+    streams = pointer_streams(body)
+    return {p: s for p, s in streams.items() if policy.ops.get(p, "") is not None}
+
+
+def _targets(s: Stream, policy: PrefetchPolicy, iterations: int) -> Tuple[int, List[int]]:
+    """Bytes ahead and the PRFM offsets of one pass of the stream, one per line of its step"""
+    span = abs(s.step)
+    ahead = policy.distance_bytes or -(-policy.distance * span // iterations)
+    first = s.lo + ahead if s.step > 0 else s.hi - ahead - span
+    return ahead, [first + j * policy.line for j in range(-(-span // policy.line))]
+
+
+def line_period(body: List[Instruction], policy: PrefetchPolicy, iterations: int = 1) -> int:
+    """
+    Copies of the pass after which every prefetched stream has advanced by
+    whole cache lines; 1 when it already does, more than max_period copies
+    would be needed, or a PRFM of the copies would be out of range.
+    """
+    streams = _prefetched_streams(body, policy).values()
+    period = 1
+    for s in streams:
+        need = policy.line // gcd(abs(s.step), policy.line)
+        period = period * need // gcd(period, need)
+    if period > policy.max_period:
+        return 1
+    for s in streams:
+        last = (period - 1) * s.step
+        copies = Stream(s.reg, period * s.step, min(s.lo, s.lo + last), max(s.hi, s.hi + last), s.stores)
+        if not all(_in_range(o) for o in _targets(copies, policy, period * iterations)[1]):
+            return 1
+    return period
+
+
+def _in_range(offset: int) -> bool:
+    return -256 <= offset <= 255 or 0 <= offset - offset % 8 <= 32760
+
+
+def _encodable(offset: int) -> int:
+    """PRFM immediate for offset: unscaled in [-256, 255], else rounded down to 8 bytes."""
+    if not _in_range(offset):
+        raise ValueError(f"prefetch offset {offset} is out of PRFM range; shorten the distance")
+    return offset if -256 <= offset <= 255 else offset - offset % 8
+
+
+def insert_prefetches(body: List[Instruction], policy: PrefetchPolicy, iterations: int = 1):
+    """
+    Prefetch every stream of one pass of a loop body that runs `iterations`
+    source iterations (the unroll factor, or the kernel copies of a modulo
+    schedule). Returns the new body and a PrefetchReport.
+    """
+    streams = _prefetched_streams(body, policy)
+    prfms: List[Instruction] = []
+    report = PrefetchReport(distance=0)
+    for p in sorted(streams):
+        s = streams[p]
+        op = policy.ops.get(p, policy.store if s.stores else policy.load)
+        ahead, offsets = _targets(s, policy, iterations)
+        for offset in offsets:
+            prfm = prefetch_instruction(op, s.reg, _encodable(offset))
+            prfm.depth, prfm.block = body[0].depth, body[0].block
+            prfms.append(prfm)
+        report.distance = max(report.distance, ahead)
+        report.prfms += len(offsets)
+        report.streams.append(f"{s.reg} {op} {ahead} B ahead, {len(offsets)} per {s.step:+d} B step")
+    return prfms + body, report
@@ -0,0 +1,231 @@
+# armasmgen/passes/renaming.py
+"""
+Register renaming to remove false (WAR/WAW) dependencies.
+
+Generators tend to reuse one temporary (prod_lo, temp1, ...) for every
+partial product, which chains otherwise independent MUL/UMULH pairs
+through write-after-read and write-after-write hazards. This pass gives
+such values a register of their own:
+
+    1. liveness over the function's control flow (labels, branches, ret)
+    2. each value chain - a plain write of r, the read-modify-writes of r
+       that follow it, and the reads in between - that dies inside its
+       basic block is a candidate
+    3. the chain moves to a pool register that is dead and unreferenced
+       over the chain's range, if that lowers the block's count of
+       WAR/WAW dependencies; ties go to the least recently used register
+
+Only hazards between instructions less than `window` apart are counted:
+with a finite pool every register is reused eventually, and a reuse far
+enough back no longer limits the scheduler or an in-order pipeline.
+
+Renaming stops when the pool runs dry; the report counts the false
+dependencies removed and the chains left in place for lack of registers.
+
+At ret the AAPCS64 result and callee-saved registers are live; unknown
+branch targets keep every register live.
+"""
+
+import re
+from dataclasses import dataclass
+from typing import List, Optional
+
+from ..core import Instruction
+from .analysis import canonical, defs, uses, is_label, mnemonic, rename, spelled_out
+
+_ALL = frozenset([f"x{i}" for i in range(31)] + [f"v{i}" for i in range(32)] + ["sp"])
+_RET_LIVE = frozenset(["x0", "x1", "sp"] + [f"x{i}" for i in range(19, 31)]
+                      + [f"v{i}" for i in range(0, 4)] + [f"v{i}" for i in range(8, 16)])
+_CALL_USES = frozenset([f"x{i}" for i in range(9)] + [f"v{i}" for i in range(8)] + ["sp"])
+_CALL_CLOBBERS = frozenset([f"x{i}" for i in range(18)] + ["x30"]
+                           + [f"v{i}" for i in range(8)] + [f"v{i}" for i in range(16, 32)])
+
+# Caller-saved registers a function may use without saving (x18 is reserved on some platforms)
+DEFAULT_POOL = tuple([f"x{i}" for i in range(18)]
+                     + [f"v{i}" for i in range(8)] + [f"v{i}" for i in range(16, 32)])
+
+_COND_BRANCHES = {"cbz", "cbnz", "tbz", "tbnz"}
+
+# Hazards further apart than this many instructions no longer constrain scheduling
+DEFAULT_WINDOW = 32
+
+
+@dataclass
+class RenameReport:
+    function: str
+    removed: int = 0    # WAR/WAW dependencies removed
+    renamed: int = 0    # value chains moved to another register
+    starved: int = 0    # chains with a false dependency left for lack of a free register
+
+    def __str__(self):
+        text = (f"rename: {self.removed} false dependencies removed, "
+                f"{self.renamed} values renamed")
+        if self.starved:
+            text += f" ({self.starved} left for lack of registers)"
+        return text
+
+
+def _renamable(reg: Optional[str]) -> bool:
+    return bool(reg) and re.fullmatch(r"[xv]\d+", reg) is not None and reg not in ("x18", "x29", "x30")
+
+
+def _reg_uses(inst: Instruction) -> set:
+    op = mnemonic(inst)
+    if op in ("bl", "blr"):
+        return uses(inst) | _CALL_USES
+    return uses(inst)
+
+
+def _reg_defs(inst: Instruction) -> set:
+    if mnemonic(inst) in ("bl", "blr"):
+        return defs(inst) | _CALL_CLOBBERS
+    return defs(inst)
+
+
+def _ends_block(inst: Instruction) -> bool:
+    op = mnemonic(inst)
+    return op in ("b", "br", "ret", "bl", "blr") or op in _COND_BRANCHES or op.startswith("b.")
+
+
+def liveness(insts: List[Instruction]):
+    """live_out[i] for every position (canonical register names)."""
+    n = len(insts)
+    labels = {inst.template[:-1]: i for i, inst in enumerate(insts) if is_label(inst)}
+    succ: List[List[int]] = []
+    exit_live: List[frozenset] = []
+    for i, inst in enumerate(insts):
+        op, target = mnemonic(inst), inst.kwargs.get("label")
+        nxt, extra = [i + 1] if i + 1 < n else [], frozenset() if i + 1 < n else _ALL
+        if op == "ret":
+            nxt, extra = [], _RET_LIVE
+        elif op == "br":
+            nxt, extra = [], _ALL
+        elif op == "b" or op in _COND_BRANCHES or op.startswith("b."):
+            jump = [labels[target]] if target in labels else []
+            jump_extra = frozenset() if target in labels else _ALL
+            nxt = jump if op == "b" else nxt + jump
+            extra = jump_extra if op == "b" else extra | jump_extra
+        succ.append(nxt)
+        exit_live.append(extra)
+
+    live_in = [set() for _ in range(n)]
+    live_out = [set() for _ in range(n)]
+    changed = True
+    while changed:
+        changed = False
+        for i in range(n - 1, -1, -1):
+            out = set(exit_live[i])
+            for s in succ[i]:
+                out |= live_in[s]
+            inn = _reg_uses(insts[i]) | (out - _reg_defs(insts[i]))
+            if out != live_out[i] or inn != live_in[i]:
+                live_out[i], live_in[i], changed = out, inn, True
+    return live_out
+
+
+def _blocks(insts: List[Instruction]) -> List[range]:
+    bounds, start = [], 0
+    for i, inst in enumerate(insts):
+        if is_label(inst) or inst.template.startswith("."):
+            bounds.append(range(start, i))
+            start = i + 1
+        elif _ends_block(inst):
+            bounds.append(range(start, i + 1))
+            start = i + 1
+    bounds.append(range(start, len(insts)))
+    return [b for b in bounds if len(b)]
+
+
+def false_dependencies(insts: List[Instruction], block: range, window: int = DEFAULT_WINDOW) -> int:
+    """WAR and WAW register dependencies inside one block spanning fewer than window instructions."""
+    return _count(block, [_reg_uses(i) for i in insts], [_reg_defs(i) for i in insts], window)
+
+
+def _count(block, U, D, window, regs=None) -> int:
+    count, reads, last_def = 0, {}, {}
+    for i in block:
+        for reg in U[i]:
+            if regs is None or reg in regs:
+                reads.setdefault(reg, []).append(i)
+        for reg in D[i]:
+            if regs is not None and reg not in regs:
+                continue
+            # A read-modify-write reads its own old value; that is not a hazard
+            count += sum(1 for p in reads.get(reg, ()) if p != i and i - p < window)
+            if reg in last_def and i - last_def[reg] < window:
+                count += 1
+            reads[reg], last_def[reg] = [], i
+    return count
+
+
+def _chain(block, start, reg, U, D, live_out):
+    """Positions of the value chain written at start, or None if it outlives the block."""
+    members = [start]
+    for p in range(start + 1, block.stop):
+        reads, writes = reg in U[p], reg in D[p]
+        if writes and not reads:
+            return members
+        if reads or writes:
+            members.append(p)
+    return None if reg in live_out[block.stop - 1] else members
+
+
+def rename_registers(insts: List[Instruction], pool=DEFAULT_POOL, *, function: str = "",
+                     window: int = DEFAULT_WINDOW):
+    """Return (instructions, RenameReport)."""
+    out = list(insts)
+    pool = [canonical(r if isinstance(r, str) else str(r)) for r in pool]
+    report = RenameReport(function=function)
+    U = [_reg_uses(i) for i in out]
+    D = [_reg_defs(i) for i in out]
+    live_out = liveness(out)
+
+    for block in _blocks(out):
+        before = _count(block, U, D, window)
+        for start in block:
+            if mnemonic(out[start]) in ("bl", "blr"):
+                continue
+            for reg in sorted(D[start] - U[start]):
+                if not _renamable(reg):
+                    continue
+                members = _chain(block, start, reg, U, D, live_out)
+                if not members or any(spelled_out(out[p], reg) for p in members):
+                    continue
+                span = range(start, members[-1] + 1)
+                best, available = None, False
+                for free in pool:
+                    if free[0] != reg[0] or free == reg:
+                        continue
+                    if any(free in live_out[p] or free in U[p] or free in D[p] for p in span):
+                        continue
+                    available = True
+                    regs = {reg, free}
+                    current = _count(block, U, D, window, regs)
+                    trial_u, trial_d = list(U), list(D)
+                    for p in members:
+                        trial_u[p] = {free if r == reg else r for r in U[p]}
+                        trial_d[p] = {free if r == reg else r for r in D[p]}
+                    gain = current - _count(block, trial_u, trial_d, window, regs)
+                    # Least recently referenced register first on equal gain
+                    recent = max((p for p in range(block.start, start)
+                                  if free in U[p] or free in D[p]), default=-1)
+                    if gain > 0 and (best is None or (gain, -recent) > best[:2]):
+                        best = (gain, -recent, free)
+                if best is None:
+                    if not available and _has_hazard(block, start, reg, U, D, window):
+                        report.starved += 1
+                    continue
+                free = best[2]
+                for p in members:
+                    out[p] = rename(out[p], {reg: free})
+                    U[p], D[p] = _reg_uses(out[p]), _reg_defs(out[p])
+                for p in span[:-1]:
+                    live_out[p] = (live_out[p] - {reg}) | {free}
+                report.renamed += 1
+        report.removed += before - _count(block, U, D, window)
+    return out, report
+
+
+def _has_hazard(block, start, reg, U, D, window) -> bool:
+    """Whether the write at start follows a nearby read or write of reg in the block."""
+    return any(reg in U[p] or reg in D[p] for p in range(max(block.start, start - window + 1), start))
@@ -0,0 +1,146 @@
+# armasmgen/passes/unroll.py
+"""
+Loop body replication for Loop(..., unroll=k).
+
+Pointers that the body only advances by constants (post/pre-indexed
+loads and stores, or ``add p, p, #imm``) are treated as induction
+variables: inside the replicated body their accesses are rewritten to
+fixed offsets from the value at the top of the unrolled iteration, and
+the k per-iteration increments are folded into one post-index update
+(or a single ADD when no access can absorb it).
+"""
+
+from dataclasses import replace
+from typing import Dict, List
+
+from ..core import Instruction
+from .analysis import (canonical, defs, uses, mnemonic, is_label,
+                       mem_access, offset_encodable, with_address)
+
+
+def _self_increment(inst: Instruction):
+    """Return (reg, delta) for ``add/sub p, p, #imm``, else None."""
+    op = mnemonic(inst)
+    if op not in ("add", "sub") or "imm" not in inst.kwargs:
+        return None
+    dst, src = inst.kwargs.get("dst"), inst.kwargs.get("src0")
+    if dst is None or canonical(dst) != canonical(src):
+        return None
+    return canonical(dst), inst.kwargs["imm"] if op == "add" else -inst.kwargs["imm"]
+
+
+def induction_pointers(body: List[Instruction]) -> set:
+    """Registers that the body only reads as a load/store base and only advances by constants."""
+    candidates, excluded = set(), set()
+    for inst in body:
+        acc = mem_access(inst)
+        inc = _self_increment(inst)
+        base = canonical(acc.base) if acc else None
+        if inc:
+            candidates.add(inc[0])
+            continue
+        for reg in defs(inst):
+            if acc and reg == base and acc.mode in ("pre", "post"):
+                candidates.add(reg)
+            else:
+                excluded.add(reg)
+        for reg in uses(inst):
+            if reg != base:
+                excluded.add(reg)
+        if acc and not acc.base_key:
+            excluded.add(base)
+    return candidates - excluded
+
+
+def unroll_body(body: List[Instruction], k: int) -> List[Instruction]:
+    """
+    Replicate the body k times, folding induction-pointer increments.
+
+    The result executes exactly like k consecutive copies of the body.
+    """
+    if k <= 1:
+        return [replace(i, kwargs=dict(i.kwargs)) for i in body]
+    if any(is_label(i) for i in body):
+        raise ValueError("Cannot replicate a loop body that defines labels (nested loop?)")
+
+    pointers = induction_pointers(body)
+    while True:
+        out, failed = _replicate(body, k, pointers)
+        if not failed:
+            return out
+        pointers -= failed
+
+
+def _replicate(body, k, pointers):
+    out: List[Instruction] = []
+    offset: Dict[str, int] = {p: 0 for p in pointers}
+    accesses: Dict[str, List[int]] = {p: [] for p in pointers}
+    names: Dict[str, str] = {}
+    failed = set()
+
+    for _ in range(k):
+        for inst in body:
+            inc = _self_increment(inst)
+            if inc and inc[0] in pointers:
+                offset[inc[0]] += inc[1]
+                names[inc[0]] = inst.kwargs["dst"]
+                continue
+            acc = mem_access(inst)
+            base = canonical(acc.base) if acc else None
+            if base in pointers:
+                names[base] = acc.base
+                if acc.mode == "pre":
+                    offset[base] += acc.offset
+                addr = offset[base] + (acc.offset if acc.mode == "offset" else 0)
+                if acc.mode == "post":
+                    offset[base] += acc.offset
+                if not offset_encodable(acc, addr, "offset"):
+                    failed.add(base)
+                accesses[base].append(len(out))
+                out.append(with_address(inst, addr, "offset"))
+                continue
+            out.append(replace(inst, kwargs=dict(inst.kwargs)))
+
+    if failed:
+        return out, failed
+
+    tail: List[Instruction] = []
+    for p in sorted(pointers):
+        total = offset[p]
+        if total and not fold_post_index(out, accesses[p], total):
+            tail.extend(pointer_advance(body[-1], names[p], total))
+    return out + tail, set()
+
+
+def fold_post_index(out, positions, total) -> bool:
+    """
+    Turn one access at offset 0 into ``[p], #total`` and rebase the later
+    accesses by -total. Tries the latest candidate first so the pointer
+    update is off the critical path of as many accesses as possible.
+    """
+    for idx, pos in reversed(list(enumerate(positions))):
+        acc = mem_access(out[pos])
+        if acc.offset != 0 or not offset_encodable(acc, total, "post"):
+            continue
+        later = [(q, mem_access(out[q])) for q in positions[idx + 1:]]
+        if all(offset_encodable(a, a.offset - total, "offset") for _, a in later):
+            out[pos] = with_address(out[pos], total, "post")
+            for q, a in later:
+                out[q] = with_address(out[q], a.offset - total, "offset")
+            return True
+    return False
+
+
+def pointer_advance(last: Instruction, name: str, total: int) -> List[Instruction]:
+    """Emit ``add/sub name, name, #imm`` chunks covering total bytes."""
+    op = "add" if total > 0 else "sub"
+    remaining, chunks = abs(total), []
+    while remaining:
+        step = min(remaining, 4095)
+        chunks.append(Instruction(
+            template=f"{op} {{dst}}, {{src0}}, #{{imm}}",
+            dsts=[name], srcs=[name],
+            kwargs=dict(dst=name, src0=name, imm=step),
+            depth=last.depth, block=last.block))
+        remaining -= step
+    return chunks
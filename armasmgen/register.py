@@ -6,6 +6,8 @@ Provides:
 - Register class for representing physical and virtual registers
 - Register pools for organizing registers by type and calling convention
 - Virtual register support for macro blocks and register allocation
+- VReg / VElem: arranged vector operands (v3.4S, v3.S[1]) for SIMD instructions
+- ZReg / ZElem / PReg: SVE vector and predicate operands (z3.s, z3.s[1], p0/z)
 """
 
 from typing import Optional, Set, List, Union
@@ -105,6 +107,24 @@ class Register:
         new_name = f"{new_width.value}{self.number}"
         return Register(new_name, self.reg_type, new_width, self.number, False)
     
+    def arranged(self, arrangement: str) -> 'VReg':
+        """This vector register with an arrangement: v_reg(3).arranged("4S") -> v3.4S"""
+        if self.reg_type != RegisterType.VECTOR:
+            raise TypeError(f"only vector registers take an arrangement, not {self.reg_type.value} register '{self}'")
+        if self.number is None:
+            raise ValueError("Cannot arrange a register without number")
+        return VReg(self.number, arrangement)
+
+    # Arranged views, named element type then lane count: v_reg(3).s4 -> v3.4S
+    b8 = property(lambda self: self.arranged("8B"))
+    b16 = property(lambda self: self.arranged("16B"))
+    h4 = property(lambda self: self.arranged("4H"))
+    h8 = property(lambda self: self.arranged("8H"))
+    s2 = property(lambda self: self.arranged("2S"))
+    s4 = property(lambda self: self.arranged("4S"))
+    d1 = property(lambda self: self.arranged("1D"))
+    d2 = property(lambda self: self.arranged("2D"))
+
     @classmethod
     def physical(cls, name: str, reg_type: RegisterType, width: RegisterWidth, number: int) -> 'Register':
         """Create a physical register"""
@@ -116,6 +136,216 @@ class Register:
         return cls(name, reg_type, width, None, True, virtual_name)
 
 
+# Element size and lane count of each NEON arrangement
+ARRANGEMENTS = {
+    "8B": (8, 8), "16B": (8, 16),
+    "4H": (16, 4), "8H": (16, 8),
+    "2S": (32, 2), "4S": (32, 4),
+    "1D": (64, 1), "2D": (64, 2),
+}
+
+
+class VReg:
+    """
+    A vector register with its arrangement, the operand of the generic SIMD
+    instructions (mixins/simd.py). The arrangement is validated here, once;
+    instructions only compare element sizes and lane counts.
+
+        VReg(3, "4S")    v_reg(3).s4    ->  v3.4S
+        v_reg(3).s4[1]                  ->  v3.S[1]   (one element, see VElem)
+    """
+
+    __slots__ = ("number", "arrangement", "esize", "lanes")
+
+    def __init__(self, number: int, arrangement: str):
+        arrangement = arrangement.upper()
+        if arrangement not in ARRANGEMENTS:
+            raise ValueError(f"unknown arrangement '{arrangement}', expected one of {', '.join(ARRANGEMENTS)}")
+        if not 0 <= number <= 31:
+            raise ValueError(f"Vector register number must be 0-31, got {number}")
+        self.number = number
+        self.arrangement = arrangement
+        self.esize, self.lanes = ARRANGEMENTS[arrangement]
+
+    @property
+    def bits(self) -> int:
+        """64 for the lower half (8B, 4H, 2S, 1D), 128 for the full register."""
+        return self.esize * self.lanes
+
+    def arranged(self, arrangement: str) -> 'VReg':
+        """The same register under another arrangement."""
+        return VReg(self.number, arrangement)
+
+    def __getitem__(self, index: int) -> 'VElem':
+        return VElem(self.number, self.esize, index)
+
+    def __str__(self) -> str:
+        return f"v{self.number}.{self.arrangement}"
+
+    def __repr__(self) -> str:
+        return f"VReg({self.number}, {self.arrangement!r})"
+
+    def __eq__(self, other) -> bool:
+        return isinstance(other, VReg) and (self.number, self.arrangement) == (other.number, other.arrangement)
+
+    def __hash__(self) -> int:
+        return hash((self.number, self.arrangement))
+
+
+_ELEMENT_NAMES = {8: "B", 16: "H", 32: "S", 64: "D"}
+
+
+class VElem:
+    """One element of a vector register, v3.S[1]: the scalar operand of by-element forms and DUP."""
+
+    __slots__ = ("number", "esize", "index")
+
+    def __init__(self, number: int, esize: int, index: int):
+        if esize not in _ELEMENT_NAMES:
+            raise ValueError(f"element size must be 8, 16, 32 or 64 bits, not {esize}")
+        if not 0 <= index < 128 // esize:
+            raise ValueError(f"{_ELEMENT_NAMES[esize]} element index must be 0-{128 // esize - 1}, got {index}")
+        self.number = number
+        self.esize = esize
+        self.index = index
+
+    def __str__(self) -> str:
+        return f"v{self.number}.{_ELEMENT_NAMES[self.esize]}[{self.index}]"
+
+    def __repr__(self) -> str:
+        return f"VElem({self.number}, {self.esize}, {self.index})"
+
+
+_SVE_SUFFIXES = {"b": 8, "h": 16, "s": 32, "d": 64, "q": 128}
+
+
+class ZReg:
+    """
+    An SVE vector register, scalable: its width is the implementation's vector
+    length (128-2048 bits), so instructions see only the element size.
+    z3 shares its low 128 bits with v3.
+
+        z_reg(3)      ->  z3      (no element size: register lists, unsized moves)
+        z_reg(3).s    ->  z3.s
+        z_reg(3).s[1] ->  z3.s[1] (indexed operand, see ZElem)
+    """
+
+    __slots__ = ("number", "esize")
+
+    def __init__(self, number: int, esize: Optional[int] = None):
+        if not 0 <= number <= 31:
+            raise ValueError(f"SVE vector register number must be 0-31, got {number}")
+        if esize is not None and esize not in _SVE_SUFFIXES.values():
+            raise ValueError(f"SVE element size must be 8, 16, 32, 64 or 128 bits, not {esize}")
+        self.number = number
+        self.esize = esize
+
+    @property
+    def suffix(self) -> str:
+        return {v: k for k, v in _SVE_SUFFIXES.items()}[self.esize] if self.esize else ""
+
+    def sized(self, esize: int) -> 'ZReg':
+        """The same register with another element size."""
+        return ZReg(self.number, esize)
+
+    b = property(lambda self: self.sized(8))
+    h = property(lambda self: self.sized(16))
+    s = property(lambda self: self.sized(32))
+    d = property(lambda self: self.sized(64))
+    q = property(lambda self: self.sized(128))
+
+    def __getitem__(self, index: int) -> 'ZElem':
+        if self.esize is None:
+            raise ValueError(f"index an SVE register with an element size, such as z_reg({self.number}).s[{index}]")
+        return ZElem(self.number, self.esize, index)
+
+    def __str__(self) -> str:
+        return f"z{self.number}" + (f".{self.suffix}" if self.esize else "")
+
+    def __repr__(self) -> str:
+        return f"ZReg({self.number}, {self.esize})"
+
+    def __eq__(self, other) -> bool:
+        return isinstance(other, ZReg) and (self.number, self.esize) == (other.number, other.esize)
+
+    def __hash__(self) -> int:
+        return hash(("z", self.number, self.esize))
+
+
+class ZElem:
+    """One element of every 128-bit segment of an SVE register, z3.s[1]: the indexed operand of SDOT, FMLA, ..."""
+
+    __slots__ = ("number", "esize", "index")
+
+    def __init__(self, number: int, esize: int, index: int):
+        if not 0 <= index < 128 // esize:
+            raise ValueError(f"{esize}-bit element index must be 0-{128 // esize - 1}, got {index}")
+        self.number = number
+        self.esize = esize
+        self.index = index
+
+    def __str__(self) -> str:
+        return f"{ZReg(self.number, self.esize)}[{self.index}]"
+
+    def __repr__(self) -> str:
+        return f"ZElem({self.number}, {self.esize}, {self.index})"
+
+
+class PReg:
+    """
+    An SVE predicate register, one bit per byte of the vector length.
+
+        p_reg(0).s    ->  p0.s    (destination of PTRUE / WHILELT: one lane per 32-bit element)
+        p_reg(0).z    ->  p0/z    (governing predicate, inactive lanes zeroed)
+        p_reg(0).m    ->  p0/m    (governing predicate, inactive lanes keep the destination)
+        p_reg(0)      ->  p0      (governing predicate of stores and reductions)
+
+    Loads, stores and predicated arithmetic take their governing predicate
+    from p0-p7; instructions qualify a plain p_reg(n) as they need.
+    """
+
+    __slots__ = ("number", "esize", "qualifier")
+
+    def __init__(self, number: int, esize: Optional[int] = None, qualifier: Optional[str] = None):
+        if not 0 <= number <= 15:
+            raise ValueError(f"SVE predicate register number must be 0-15, got {number}")
+        if esize is not None and esize not in (8, 16, 32, 64):
+            raise ValueError(f"predicate element size must be 8, 16, 32 or 64 bits, not {esize}")
+        if qualifier not in (None, "z", "m"):
+            raise ValueError(f"predicate qualifier must be 'z' or 'm', not {qualifier!r}")
+        self.number = number
+        self.esize = esize
+        self.qualifier = qualifier
+
+    def sized(self, esize: int) -> 'PReg':
+        return PReg(self.number, esize)
+
+    def qualified(self, qualifier: str) -> 'PReg':
+        return PReg(self.number, None, qualifier)
+
+    b = property(lambda self: self.sized(8))
+    h = property(lambda self: self.sized(16))
+    s = property(lambda self: self.sized(32))
+    d = property(lambda self: self.sized(64))
+    z = property(lambda self: self.qualified("z"))
+    m = property(lambda self: self.qualified("m"))
+
+    def __str__(self) -> str:
+        if self.qualifier:
+            return f"p{self.number}/{self.qualifier}"
+        return f"p{self.number}" + (f".{ZReg(0, self.esize).suffix}" if self.esize else "")
+
+    def __repr__(self) -> str:
+        return f"PReg({self.number}, {self.esize}, {self.qualifier!r})"
+
+    def __eq__(self, other) -> bool:
+        return isinstance(other, PReg) and (self.number, self.esize, self.qualifier) == \
+            (other.number, other.esize, other.qualifier)
+
+    def __hash__(self) -> int:
+        return hash(("p", self.number, self.esize, self.qualifier))
+
+
 # Convenience functions for creating common registers
 def x_reg(n: int) -> Register:
     """Create x register (64-bit general purpose)"""
@@ -138,6 +368,14 @@ def d_reg(n: int) -> Register:
     return Register.physical(f"d{n}", RegisterType.VECTOR, RegisterWidth.D, n)
     return Register.physical(f"d{n}", RegisterType.VECTOR, RegisterWidth.D, n)
 
+def z_reg(n: int) -> ZReg:
+    """Create z register (SVE vector, no element size yet: z_reg(n).s for z<n>.s)"""
+    return ZReg(n)
+
+def p_reg(n: int) -> PReg:
+    """Create p register (SVE predicate: p_reg(n).s, p_reg(n).z, p_reg(n).m)"""
+    return PReg(n)
+
 def virtual_x(name: str) -> Register:
     """Create virtual x register"""
     return Register.virtual(f"X<{name}>", RegisterType.GENERAL, RegisterWidth.X, name)
@@ -147,6 +385,10 @@ def virtual_v(name: str) -> Register:
     return Register.virtual(f"V<{name}>", RegisterType.VECTOR, RegisterWidth.V, name)
 
 
+# Vector registers in allocation order; v8-v15 are callee-saved (lower halves), so they come last
+VECTOR_POOL = tuple(v_reg(i) for i in list(range(8)) + list(range(16, 32)) + list(range(8, 16)))
+
+
 class RegisterPool:
     """
     Manages a collection of registers with allocation and tracking capabilities.
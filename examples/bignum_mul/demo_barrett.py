@@ -0,0 +1,125 @@
+#!/usr/bin/env python3
+"""
+Barrett reduction generator: barrett_n(r, x, m, mu) for n = 2..8 limbs.
+
+    r = x mod m,   x < 2^(128n),   2^(64(n-1)) < m < 2^(64n),   mu = floor(2^(128n) / m)
+
+The lower bound on m is what keeps mu within n + 1 limbs.
+
+HAC algorithm 14.42 with b = 2^64, k = n:
+
+    q1 = floor(x / b^(n-1))        the top n + 1 limbs of x
+    q3 = floor(q1 · mu / b^(n+1))  the quotient estimate, at most 2 below floor(x / m)
+    r  = (x - q3 · m) mod b^(n+1)  only the low n + 1 limbs of either side matter
+    r  < 3m: two conditional subtractions of m
+
+mu depends only on m, so a caller precomputes it once per modulus; there is no
+conversion into or out of Montgomery form and x can be any 2n-limb value, for
+example a product straight from a multiplication kernel.
+
+q1 · mu goes through emit_product from demo_field.py with t in a window of
+n + 2 registers: a limb of the product is dropped as soon as its row is done,
+unless it is part of q3. q3 · m is subtracted from r row by row with SUBS/SBCS
+chains that stop at limb n. The corrections are straight-line SUBS/SBCS +
+CSEL, so the running time does not depend on x or m.
+"""
+
+from armasmgen.builder import ASMCode, BackgroundCode
+from armasmgen.register import x_reg
+
+from demo_montmul import load_limbs, streamed, _callee_saved
+from demo_field import chain, emit_product, store_limbs
+
+# Arguments: barrett_n(uint64_t r[n], const uint64_t x[2n], const uint64_t m[n], const uint64_t mu[n + 1])
+R_PTR, X_PTR, M_PTR, MU_PTR = (x_reg(i) for i in range(4))
+
+POOL = [x_reg(i) for i in range(4, 18)] + [x_reg(i) for i in range(19, 29)]
+
+SIZES = (2, 3, 4, 6, 8)   # 128 to 512 bits
+
+
+class Window:
+    """
+    Limbs t[k] of a product whose low limbs can be dropped once final: t[k] lives in
+    regs[k % len(regs)]. Supports the indexing and slicing emit_product uses.
+    """
+
+    def __init__(self, regs):
+        self.regs = regs
+
+    def __getitem__(self, k):
+        if isinstance(k, slice):
+            return [self[i] for i in range(k.start or 0, k.stop)]
+        return self.regs[k % len(self.regs)]
+
+
+def emit_barrett(m, n: int):
+    q1 = POOL[:n + 1]
+    window = POOL[n + 1:2 * n + 3]
+    scalar = POOL[2 * n + 3]        # mu[i] in the quotient product, m[j] in the subtraction
+    prods = POOL[2 * n + 4:2 * n + 6]
+    saved = _callee_saved(POOL[:2 * n + 6])
+
+    for r0, r1 in saved:
+        m.STP_pre(r0, r1, "sp", -16)
+
+    m.comment("q3 = floor(x[n-1, 2n) * mu / 2^(64(n+1)))")
+    load_limbs(m, q1, X_PTR, n - 1)
+    t = Window(window)
+    emit_product(m, q1, MU_PTR, scalar, t, prods)
+    q3 = t[n + 1:2 * n + 2]
+
+    m.comment("r = (x - q3*m) mod 2^(64(n+1))")
+    r = q1
+    load_limbs(m, r, X_PTR)
+    for j in range(n):
+        if j:
+            m.LDR_offset(scalar, M_PTR, 8 * j)
+        else:
+            m.LDR(scalar, M_PTR)
+        chain(m, r[j:], [(m.MUL, q, scalar) for q in q3[:n + 1 - j]], prods, subtract=True)
+        chain(m, r[j + 1:], [(m.UMULH, q, scalar) for q in q3[:n - j]], prods, subtract=True)
+
+    # r < 3m: subtract m twice, each time only if it does not borrow
+    u = q3
+    for step in range(2):
+        m.comment(f"correction {step + 1}: r = r >= m ? r - m : r")
+        modulus = streamed(m, M_PTR, prods, n)
+        for j in range(n):
+            (m.SUBS if j == 0 else m.SBCS)(u[j], r[j], modulus(j))
+        m.SBCS(u[n], r[n], "xzr")
+        for j in range(n + 1 if step == 0 else n):
+            m.CSEL(r[j], u[j], r[j], "cs")
+    store_limbs(m, r[:n], R_PTR)
+
+    for r0, r1 in reversed(saved):
+        m.LDP_post(r0, r1, "sp", 16)
+
+
+def create_barrett(n: int, rename=False):
+    """
+    Create barrett_n(r, x, m, mu): r = x mod m for a 2n-limb x and an n-limb m above
+    2^(64(n-1)), with mu = floor(2^(128n) / m) in n + 1 limbs. r may alias x.
+    """
+    if not 2 <= n <= 8:
+        raise ValueError(f"Barrett reduction supports 2 to 8 limbs, not {n}")
+    with ASMCode(label=f"barrett_{n}", rename=rename) as f:
+        emit_barrett(f, n)
+    return f
+
+
+def main():
+    print("=== Barrett Reduction Generator ===")
+    out = BackgroundCode()
+    with out:
+        for n in SIZES:
+            create_barrett(n)
+    out.export_to_file("barrett.s")
+    for n in SIZES:
+        print(f"✓ barrett_{n} ({64 * n:>3}-bit modulus)")
+    print("✓ Assembly exported to: barrett.s")
+    print("Run 'make run-barrett' to check against GMP and compare with Montgomery and mpz_mod.")
+
+
+if __name__ == "__main__":
+    main()
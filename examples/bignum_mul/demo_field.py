@@ -0,0 +1,518 @@
+#!/usr/bin/env python3
+"""
+Field arithmetic for named primes: fully unrolled add/sub/mul/sqr/reduce kernels.
+
+    secp256k1   p = 2^256 - 2^32 - 977
+    p25519      p = 2^255 - 19
+    p256        p = 2^256 - 2^224 + 2^192 + 2^96 - 1      (NIST P-256)
+    p384        p = 2^384 - 2^128 - 2^96 + 2^32 - 1       (NIST P-384)
+
+Every kernel works in radix 2^64 on n = 4 or 6 limbs and returns values in [0, p):
+
+    {f}_add(r, a, b)     r = a + b mod p
+    {f}_sub(r, a, b)     r = a - b mod p
+    {f}_mul(r, a, b)     r = a · b mod p           (· R⁻¹ for p256, p384)
+    {f}_sqr(r, a)        r = a² mod p              (· R⁻¹ for p256, p384)
+    {f}_reduce(r, x)     r = x mod p, x 2n limbs   (· R⁻¹ for p256, p384)
+
+mul and sqr build the 2n-limb product in registers (sqr computes each cross
+product once and doubles) and run the same reduction as reduce.
+
+secp256k1 and p25519 are pseudo-Mersenne: 2^(64n) ≡ c mod p with a one-limb
+c (2^32 + 977 and 38). The high half folds onto the low half in one
+multiply-accumulate row, the leftover limb folds in with one more multiply,
+and one conditional subtraction finishes.
+
+p256 and p384 keep values in the Montgomery domain (x·R mod p, R = 2^(64n)),
+as OpenSSL's nistz256 code does. -p⁻¹ mod 2^64 is 1 for P-256 and 2^32 + 1 for
+P-384, and their limbs are all 0, all ones or 32-bit halves, so the
+reduction rows are shifts, additions and subtractions with no multiplies.
+
+p25519 also has mul51/sqr51 on five 51-bit limbs (the ref10 representation):
+inputs with limbs below 2^52, outputs with limbs below 2^52, not canonical.
+"""
+
+from armasmgen.builder import ASMCode, BackgroundCode
+from armasmgen.register import x_reg
+
+from demo_montmul import load_limbs, _stp, _callee_saved
+
+# Arguments: f_op(uint64_t *r, const uint64_t *a, const uint64_t *b)
+R_PTR, A_PTR, B_PTR = (x_reg(i) for i in range(3))
+
+POOL = [x_reg(i) for i in range(3, 18)] + [x_reg(i) for i in range(19, 29)]
+
+MASK51 = (1 << 51) - 1
+
+
+class Registers:
+    """Hands out POOL registers in order and remembers which ones a kernel used."""
+
+    def __init__(self):
+        self.free = list(POOL)
+        self.used = []
+
+    def take(self, count):
+        if count > len(self.free):
+            raise ValueError(f"kernel needs {count} more registers, {len(self.free)} left")
+        regs, self.free = self.free[:count], self.free[count:]
+        self.used += regs
+        return regs
+
+
+def emit_constant(m, reg, value):
+    """reg = value with MOVZ/MOVK, or MVN/MOVK when most 16-bit chunks are all ones."""
+    chunks = [(value >> (16 * k)) & 0xFFFF for k in range(4)]
+    if chunks.count(0xFFFF) > chunks.count(0):
+        m.MVN(reg, "xzr")
+        keep = 0xFFFF
+    else:
+        first = next(k for k in range(4) if chunks[k])
+        m.MOVZ(reg, chunks[first], 16 * first)
+        chunks[first] = keep = 0
+    for k in range(4):
+        if chunks[k] != keep:
+            m.MOVK(reg, chunks[k], 16 * k)
+
+
+def constants(m, values, regs):
+    """Registers holding values, one per distinct nonzero value; zero reads as xzr."""
+    held, free = {0: "xzr"}, iter(regs)
+    for v in values:
+        if v not in held:
+            held[v] = next(free)
+            emit_constant(m, held[v], v)
+    return [held[v] for v in values]
+
+
+def chain(m, dst, terms, prods=None, src=None, subtract=False):
+    """
+    dst[k] = src[k] ± terms[k] as one carry chain (src defaults to dst). A term is a
+    register, None for the carry alone, or an (op, x, y) product; products issue one
+    limb ahead into prods.
+    """
+    first, rest = (m.SUBS, m.SBCS) if subtract else (m.ADDS, m.ADCS)
+    src = src or dst
+
+    def issue(k):
+        term = terms[k]
+        if isinstance(term, tuple):
+            op, x, y = term
+            op(prods[k % 2], x, y)
+            return prods[k % 2]
+        return term or "xzr"
+
+    ready = issue(0)
+    for k in range(len(dst)):
+        following = issue(k + 1) if k + 1 < len(dst) else None
+        (first if k == 0 else rest)(dst[k], src[k], ready)
+        ready = following
+
+
+def store_limbs(m, regs, base):
+    for j in range(0, len(regs) - 1, 2):
+        _stp(m, regs[j], regs[j + 1], base, 8 * j)
+    if len(regs) % 2:
+        m.STR_offset(regs[-1], base, 8 * (len(regs) - 1))
+
+
+# ---------------------------------------------------------------------------
+# Products into t[0, 2n)
+# ---------------------------------------------------------------------------
+
+def emit_product(m, a, b_ptr, bi, t, prods):
+    """t[0, 2n) = a · b, one row per limb of b: a MUL chain, then an UMULH chain one limb up."""
+    n = len(a)
+    for i in range(n):
+        if i:
+            m.LDR_offset(bi, b_ptr, 8 * i)
+        else:
+            m.LDR(bi, b_ptr)
+        m.comment(f"row {i}: t += a*b[{i}]")
+        if i == 0:
+            for j in range(n):
+                m.MUL(t[j], a[j], bi)
+            chain(m, t[1:n], [(m.UMULH, a[j], bi) for j in range(n - 1)], prods)
+            m.UMULH(t[n], a[n - 1], bi)
+            m.ADC(t[n], t[n], "xzr")
+        else:
+            # t[i + n] is not written yet: it starts as the carry of the MUL chain
+            chain(m, t[i:i + n], [(m.MUL, x, bi) for x in a], prods)
+            m.ADC(t[i + n], "xzr", "xzr")
+            chain(m, t[i + 1:i + n + 1], [(m.UMULH, x, bi) for x in a], prods)
+
+
+def emit_square(m, a, t, prods):
+    """t[0, 2n) = a²: the products a[i]·a[j], i < j, once each, doubled, plus the squares a[i]²."""
+    n = len(a)
+    m.comment("cross products a[i]*a[j], i < j")
+    for i in range(n - 1):
+        row = a[i + 1:]
+        if i == 0:
+            for j, x in enumerate(row):
+                m.MUL(t[1 + j], x, a[0])
+            chain(m, t[2:n], [(m.UMULH, x, a[0]) for x in row[:-1]], prods)
+            m.UMULH(t[n], row[-1], a[0])
+            m.ADC(t[n], t[n], "xzr")
+        else:
+            chain(m, t[2 * i + 1:i + n], [(m.MUL, x, a[i]) for x in row], prods)
+            m.ADC(t[i + n], "xzr", "xzr")
+            chain(m, t[2 * i + 2:i + n + 1], [(m.UMULH, x, a[i]) for x in row], prods)
+
+    m.comment("double, then add the squares a[i]^2")
+    chain(m, t[1:2 * n - 1], t[1:2 * n - 1])
+    m.ADC(t[2 * n - 1], "xzr", "xzr")
+    m.MUL(t[0], a[0], a[0])
+    chain(m, t[1:], [(m.UMULH if k % 2 else m.MUL, a[k // 2], a[k // 2]) for k in range(1, 2 * n)], prods)
+
+
+# ---------------------------------------------------------------------------
+# Fields
+# ---------------------------------------------------------------------------
+
+class Field:
+    """A named prime p = sum(limbs[k]·2^(64k)) and the reduction that fits its shape."""
+
+    montgomery = False
+
+    def __init__(self, name, p, n):
+        self.name, self.p, self.n = name, p, n
+        self.limbs = [(p >> (64 * k)) & 0xFFFFFFFFFFFFFFFF for k in range(n)]
+
+    def emit_reduce(self, m, t, spare):
+        """Reduce t[0, 2n) into n registers holding a value in [0, p); spare has n + 5 free registers."""
+        raise NotImplementedError
+
+
+class PseudoMersenne(Field):
+    """p = 2^(64n) - c with a one-limb c, or p = 2^(64n - 1) - c/2 (then 2^(64n) ≡ c as well)."""
+
+    def __init__(self, name, p, n):
+        super().__init__(name, p, n)
+        self.c = (1 << (64 * n)) % p
+
+    def emit_reduce(self, m, t, spare):
+        n = self.n
+        c, e, prods, u = spare[0], spare[1], spare[2:4], spare[4:4 + n]
+        low, high = t[:n], t[n:2 * n]
+
+        emit_constant(m, c, self.c)
+        m.comment("t[0, n) += c * t[n, 2n): the carry limb e is at most c")
+        chain(m, low, [(m.MUL, x, c) for x in high], prods)
+        m.ADC(e, "xzr", "xzr")
+        chain(m, low[1:] + [e], [(m.UMULH, x, c) for x in high], prods)
+
+        m.comment("t[0, n) += c * e; a carry out of that leaves room for one more c")
+        m.MUL(prods[0], e, c)
+        if self.c * self.c >> 64:
+            m.UMULH(prods[1], e, c)
+            chain(m, low, [prods[0], prods[1]] + [None] * (n - 2))
+        else:
+            chain(m, low, [prods[0]] + [None] * (n - 1))
+        m.CSEL(e, c, "xzr", "cs")
+        chain(m, low, [e] + [None] * (n - 1))
+
+        if self.p >> (64 * n - 1):
+            m.comment("r = t >= p ? t + c - 2^(64n) : t")
+            chain(m, u, [c] + [None] * (n - 1), src=low)
+            for k in range(n):
+                m.CSEL(low[k], u[k], low[k], "cs")
+        else:
+            half = self.c // 2
+            mask, top = prods
+            m.comment(f"fold bit {64 * n - 1}: t = t mod 2^{64 * n - 1} + {half} * bit")
+            m.MVN(mask, "xzr")
+            m.LSR(mask, mask, 1)
+            m.LSR(top, low[-1], 63)
+            m.AND(low[-1], low[-1], mask)
+            m.MOV_imm(c, half)
+            m.MUL(top, top, c)
+            chain(m, low, [top] + [None] * (n - 1))
+            m.comment(f"r = t + {half} has bit {64 * n - 1} set ? t + {half} - 2^{64 * n - 1} : t")
+            chain(m, u, [c] + [None] * (n - 1), src=low)
+            m.CMP_imm(u[-1], 0)
+            m.AND(u[-1], u[-1], mask)
+            for k in range(n):
+                m.CSEL(low[k], u[k], low[k], "mi")
+        return low
+
+
+class MontgomeryFriendly(Field):
+    """
+    Montgomery domain with multiplication-free reduction rows. row(m, ti, temps) emits
+    q and q·p for the row, returning the added and the subtracted limbs of q·p as
+    {limb offset: register}: q·p = sum(added) - sum(subtracted), and the limb at offset 0
+    cancels t[i].
+    """
+
+    montgomery = True
+
+    def __init__(self, name, p, n, row):
+        super().__init__(name, p, n)
+        self.row = row
+
+    def emit_reduce(self, m, t, spare):
+        """
+        Montgomery reduction of t[0, 2n) < p·R. Row i adds q·p·2^(64i), which clears t[i];
+        the carry limb at offset n goes back into t[i], and the end adds t[0, n) into
+        t[n, 2n) in one chain, so no row carries past its own n limbs.
+        """
+        n = self.n
+        top, temps = spare[0], spare[1:8]
+        for i in range(n):
+            m.comment(f"row {i}: t += q*p*2^(64*{i})")
+            added, subtracted = self.row(m, t[i], temps)
+            low = min(added)
+            chain(m, t[i + low:i + n], [added.get(k) for k in range(low, n)])
+            m.ADC(t[i], added.get(n, "xzr"), "xzr")
+            if subtracted:
+                low = min(subtracted)
+                chain(m, t[i + low:i + n], [subtracted.get(k) for k in range(low, n)], subtract=True)
+                m.SBC(t[i], t[i], "xzr")
+
+        m.comment("add the carry limbs, then r = t >= p ? t - p : t")
+        r = t[n:2 * n]
+        chain(m, r, t[:n])
+        m.ADC(top, "xzr", "xzr")
+        emit_cond_sub(m, r, top, constants(m, self.limbs, t[:n]), spare[1:1 + n])
+        return r
+
+
+def p256_row(m, ti, temps):
+    """
+    -p⁻¹ ≡ 1, so q = t[i]. q·p = -q + q·2^96 + q·(2^64 - 2^32 + 1)·2^192; the -q cancels t[i]
+    without a borrow and the rest is nonnegative.
+    """
+    q = ti
+    shl, shr, lo, hi = temps[:4]
+    m.LSL(shl, q, 32)
+    m.LSR(shr, q, 32)
+    m.SUBS(lo, q, shl)
+    m.SBC(hi, q, shr)
+    return {1: shl, 2: shr, 3: lo, 4: hi}, {}
+
+
+def p384_row(m, ti, temps):
+    """
+    -p⁻¹ ≡ 2^32 + 1, so q = t[i] + (t[i] << 32).
+    q·p = q·(2^32 - 1) + q·2^384 - q·(2^96 + 2^128).
+    """
+    q, shl, shr, lo, hi, mid, carry = temps[:7]
+    m.LSL(shl, ti, 32)
+    m.ADD(q, ti, shl)
+    m.LSL(shl, q, 32)
+    m.LSR(shr, q, 32)
+    m.SUBS(lo, shl, q)
+    m.SBC(hi, shr, "xzr")
+    m.ADDS(mid, shr, q)
+    m.ADC(carry, "xzr", "xzr")
+    return {0: lo, 1: hi, 6: q}, {1: shl, 2: mid, 3: carry}
+
+
+FIELDS = {
+    "secp256k1": PseudoMersenne("secp256k1", 2**256 - 2**32 - 977, 4),
+    "p25519": PseudoMersenne("p25519", 2**255 - 19, 4),
+    "p256": MontgomeryFriendly("p256", 2**256 - 2**224 + 2**192 + 2**96 - 1, 4, p256_row),
+    "p384": MontgomeryFriendly("p384", 2**384 - 2**128 - 2**96 + 2**32 - 1, 6, p384_row),
+}
+
+
+# ---------------------------------------------------------------------------
+# Kernels
+# ---------------------------------------------------------------------------
+
+def emit_cond_sub(m, r, top, p, u):
+    """r = (top·2^(64n) + r) >= p ? ... - p : ..., for values below 2p; top may be xzr."""
+    chain(m, u, p, src=r, subtract=True)
+    m.SBCS("xzr", top, "xzr")
+    for k in range(len(r)):
+        m.CSEL(r[k], u[k], r[k], "cs")
+
+
+def _kernel(m, regs, body):
+    saved = _callee_saved(regs.used)
+    for r0, r1 in saved:
+        m.STP_pre(r0, r1, "sp", -16)
+    body()
+    for r0, r1 in reversed(saved):
+        m.LDP_post(r0, r1, "sp", 16)
+
+
+def emit_add(m, field):
+    n, regs = field.n, Registers()
+    a, b, u, (top,) = regs.take(n), regs.take(n), regs.take(n), regs.take(1)
+
+    def body():
+        load_limbs(m, a, A_PTR)
+        load_limbs(m, b, B_PTR)
+        chain(m, a, b)
+        m.ADC(top, "xzr", "xzr")
+        m.comment("r = a + b >= p ? a + b - p : a + b")
+        emit_cond_sub(m, a, top, constants(m, field.limbs, b), u)
+        store_limbs(m, a, R_PTR)
+    _kernel(m, regs, body)
+
+
+def emit_sub(m, field):
+    n, regs = field.n, Registers()
+    a, b, (mask,) = regs.take(n), regs.take(n), regs.take(1)
+
+    def body():
+        load_limbs(m, a, A_PTR)
+        load_limbs(m, b, B_PTR)
+        chain(m, a, b, subtract=True)
+        m.CSETM(mask, "cc")
+        m.comment("r = a - b, plus p when that borrowed")
+        p = constants(m, field.limbs, b)
+        for reg in dict.fromkeys(p):
+            if reg != "xzr":
+                m.AND(reg, reg, mask)
+        chain(m, a, p)
+        store_limbs(m, a, R_PTR)
+    _kernel(m, regs, body)
+
+
+def emit_mul(m, field, square):
+    n, regs = field.n, Registers()
+    a, t, prods = regs.take(n), regs.take(2 * n), regs.take(2)
+    bi = None if square else regs.take(1)[0]
+    spare = a + prods + ([] if square else [bi]) + regs.take(3 if square else 2)
+
+    def body():
+        load_limbs(m, a, A_PTR)
+        if square:
+            emit_square(m, a, t, prods)
+        else:
+            emit_product(m, a, B_PTR, bi, t, prods)
+        store_limbs(m, field.emit_reduce(m, t, spare), R_PTR)
+    _kernel(m, regs, body)
+
+
+def emit_reduce(m, field):
+    n, regs = field.n, Registers()
+    t, spare = regs.take(2 * n), regs.take(n + 5)
+
+    def body():
+        load_limbs(m, t, A_PTR)
+        store_limbs(m, field.emit_reduce(m, t, spare), R_PTR)
+    _kernel(m, regs, body)
+
+
+def emit_mul51(m, square):
+    """
+    p25519 in radix 2^51: column k sums a[i]·b[j] over i + j = k and 19·a[i]·b[j] over
+    i + j = k + 5 in a 128-bit (hi, lo), keeps the low 51 bits and carries the rest
+    into column k + 1; the carry out of column 4 comes back into limb 0 times 19.
+    """
+    regs = Registers()
+    a, r = regs.take(5), regs.take(5)
+    lo, hi, p0, p1, mask = regs.take(5)
+    if square:
+        # a[i]·a[j] for i < j counts twice and wraps around (19x) only for j >= 3
+        twice, wrapped = regs.take(4), regs.take(2)
+        double = dict(zip(range(4), twice))
+        times19 = dict(zip((3, 4), wrapped))
+        columns = [[] for _ in range(5)]
+        for i in range(5):
+            for j in range(i, 5):
+                x = a[i] if i == j else double[i]
+                y = times19[j] if i + j >= 5 else a[j]
+                columns[(i + j) % 5].append((x, y))
+    else:
+        b, wrapped = regs.take(5), regs.take(4)
+        times19 = dict(zip(range(1, 5), wrapped))
+        columns = [[(a[i], b[k - i] if i <= k else times19[k - i + 5]) for i in range(5)] for k in range(5)]
+
+    def body():
+        load_limbs(m, a, A_PTR)
+        m.MOV_imm(p0, 19)
+        if square:
+            for i, reg in double.items():
+                m.ADD(reg, a[i], a[i])
+            for j, reg in times19.items():
+                m.MUL(reg, a[j], p0)
+        else:
+            load_limbs(m, b, B_PTR)
+            for j, reg in times19.items():
+                m.MUL(reg, b[j], p0)
+        emit_constant(m, mask, MASK51)
+
+        for k, terms in enumerate(columns):
+            m.comment(f"column {k}")
+            for idx, (x, y) in enumerate(terms):
+                if idx == 0 and k == 0:
+                    m.MUL(lo, x, y)
+                    m.UMULH(hi, x, y)
+                elif idx == 0:
+                    # lo holds the carry from column k - 1
+                    m.MUL(p0, x, y)
+                    m.UMULH(hi, x, y)
+                    m.ADDS(lo, lo, p0)
+                    m.ADC(hi, hi, "xzr")
+                else:
+                    m.MUL(p0, x, y)
+                    m.UMULH(p1, x, y)
+                    m.ADDS(lo, lo, p0)
+                    m.ADC(hi, hi, p1)
+            m.AND(r[k], lo, mask)
+            m.EXTR(lo, hi, lo, 51)
+
+        m.comment("limb 0 += 19 * carry, and one more carry into limb 1")
+        m.MOV_imm(p0, 19)
+        m.MUL(lo, lo, p0)
+        m.ADD(r[0], r[0], lo)
+        m.LSR(lo, r[0], 51)
+        m.AND(r[0], r[0], mask)
+        m.ADD(r[1], r[1], lo)
+        store_limbs(m, r, R_PTR)
+    _kernel(m, regs, body)
+
+
+def create_field_kernel(field: str, op: str, rename=False):
+    """
+    Create {field}_{op}: op is add, sub, mul, sqr or reduce (and mul51, sqr51 for p25519).
+    r may alias the inputs.
+    """
+    if field not in FIELDS:
+        raise ValueError(f"unknown field {field}; choose from {', '.join(FIELDS)}")
+    f = FIELDS[field]
+    emitters = {
+        "add": lambda m: emit_add(m, f),
+        "sub": lambda m: emit_sub(m, f),
+        "mul": lambda m: emit_mul(m, f, square=False),
+        "sqr": lambda m: emit_mul(m, f, square=True),
+        "reduce": lambda m: emit_reduce(m, f),
+    }
+    if field == "p25519":
+        emitters["mul51"] = lambda m: emit_mul51(m, square=False)
+        emitters["sqr51"] = lambda m: emit_mul51(m, square=True)
+    if op not in emitters:
+        raise ValueError(f"{field} has no {op} kernel; choose from {', '.join(emitters)}")
+    with ASMCode(label=f"{field}_{op}", rename=rename) as code:
+        emitters[op](code)
+    return code
+
+
+OPS = ("add", "sub", "mul", "sqr", "reduce")
+
+
+def main():
+    print("=== Named-Prime Field Arithmetic Generator ===")
+    out = BackgroundCode()
+    with out:
+        for name in FIELDS:
+            for op in OPS:
+                create_field_kernel(name, op)
+        create_field_kernel("p25519", "mul51")
+        create_field_kernel("p25519", "sqr51")
+    out.export_to_file("field.s")
+    for name, f in FIELDS.items():
+        how = "Montgomery domain, multiply-free rows" if f.montgomery else f"pseudo-Mersenne, 2^{64 * f.n} ≡ {f.c:#x}"
+        print(f"✓ {name:<9} ({64 * f.n}-bit): {', '.join(OPS)} — {how}")
+    print("✓ p25519    radix 2^51: mul51, sqr51")
+    print("✓ Assembly exported to: field.s")
+    print("Run 'make run-field' to check against GMP modular arithmetic.")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,310 @@
+#!/usr/bin/env python3
+"""
+Montgomery multiplication generator: montmul_n(r, a, b, m, n0inv) for n = 4..64 limbs.
+
+    r = a · b · R⁻¹ mod m,   R = 2^(64n),   n0inv = -m⁻¹ mod 2^64,   a, b < m, m odd
+
+Coarsely integrated operand scanning (CIOS): row i adds a · b[i] into the
+running accumulator t, then adds q · m with q = t[0] · n0inv mod 2^64, which
+clears t[0], and shifts t down one limb. t stays below 2m, so one branchless
+conditional subtraction of m finishes the result.
+
+Each product a[j] · s is split into its MUL half and its UMULH half, and
+each half goes through a single ADDS/ADCS chain: four instructions per limb
+and no carry register. The MUL/UMULH of limb j + 1 issue before the
+addition of limb j.
+
+Up to MAX_REGISTER_LIMBS limbs, a and t stay in registers for the whole
+function, the one-limb shift is a renaming of the t registers, and all
+rows are straight-line code. Larger moduli keep t on the stack and loop
+over the rows.
+"""
+
+from armasmgen.builder import ASMCode, Block, BackgroundCode
+from armasmgen.register import x_reg
+
+# Arguments: montmul_n(uint64_t r[n], const uint64_t a[n], const uint64_t b[n], const uint64_t m[n], uint64_t n0inv)
+R_PTR, A_PTR, B_PTR, M_PTR, N0INV = (x_reg(i) for i in range(5))
+
+# Register-resident version: x1 joins the pool once a is loaded
+POOL = [x_reg(i) for i in range(5, 18)] + [x_reg(i) for i in range(19, 29)]
+MAX_REGISTER_LIMBS = 8
+
+# Stack version
+COUNT, BI, Q, CARRY, LO, HI = (x_reg(i) for i in range(5, 11))
+T_IN, T_OUT = x_reg(11), x_reg(12)
+OPERAND = (x_reg(13), x_reg(14))
+LIMBS = (x_reg(15), x_reg(16))
+MASK = x_reg(17)
+
+SIZES = (4, 6, 8, 12, 16, 32, 48, 64)   # 256 to 4096 bits
+
+
+def _ldp(m, r0, r1, base, offset):
+    if offset:
+        m.LDP_offset(r0, r1, base, offset)
+    else:
+        m.LDP(r0, r1, base)
+
+
+def _stp(m, r0, r1, base, offset):
+    if offset:
+        m.STP_offset(r0, r1, base, offset)
+    else:
+        m.STP(r0, r1, base)
+
+
+def load_limbs(m, regs, base, offset=0):
+    for j in range(0, len(regs) - 1, 2):
+        _ldp(m, regs[j], regs[j + 1], base, 8 * (offset + j))
+    if len(regs) % 2:
+        m.LDR_offset(regs[-1], base, 8 * (offset + len(regs) - 1))
+
+
+def streamed(m, base, pair, count, offset=0):
+    """operand(j) for j = 0, 1, ...: limbs of base[offset, offset + count) loaded two at a time into pair."""
+    def operand(j):
+        if j % 2 == 0:
+            if j + 1 < count:
+                _ldp(m, pair[0], pair[1], base, 8 * (offset + j))
+            else:
+                m.LDR_offset(pair[0], base, 8 * (offset + j))
+        return pair[j % 2]
+    return operand
+
+
+def mac_chain(m, count, operand, scalar, high, dst, prods):
+    """dst[j] += (high ? UMULH : MUL)(operand(j), scalar) for j < count, as one ADDS/ADCS carry chain."""
+    product = m.UMULH if high else m.MUL
+
+    def issue(j):
+        product(prods[j % 2], operand(j), scalar)
+
+    issue(0)
+    for j in range(count):
+        if j + 1 < count:
+            issue(j + 1)
+        (m.ADDS if j == 0 else m.ADCS)(dst[j], dst[j], prods[j % 2])
+
+
+def _callee_saved(regs):
+    """Pairs of x19-x28 covering every callee-saved register in regs."""
+    top = max((int(str(r)[1:]) for r in regs if 19 <= int(str(r)[1:]) <= 28), default=18)
+    return [(x_reg(i), x_reg(i + 1)) for i in range(19, top + 1, 2)]
+
+
+def emit_montmul_registers(m, n: int):
+    """CIOS with a and t[0, n + 2) in registers; m too when it fits."""
+    a = POOL[:n]
+    rest = [A_PTR] + POOL[n:]
+    t = rest[:n + 2]
+    qb = rest[n + 2]                    # b[i] in the multiplication half of a row, q in the reduction half
+    prods = rest[n + 3:n + 5]
+    if len(rest) >= 2 * n + 5:
+        mod = rest[n + 5:2 * n + 5]
+        modulus = mod.__getitem__
+        used = a + rest[:2 * n + 5]
+    else:
+        mod = None
+        pair = rest[n + 5:n + 7]
+        used = a + rest[:n + 7]
+    saved = _callee_saved(used)
+
+    for r0, r1 in saved:
+        m.STP_pre(r0, r1, "sp", -16)
+    load_limbs(m, a, A_PTR)
+    if mod:
+        load_limbs(m, mod, M_PTR)
+
+    for i in range(n):
+        if not mod:
+            modulus = streamed(m, M_PTR, pair, n)
+        m.LDR_post(qb, B_PTR, 8)
+        m.comment(f"row {i}: t += a*b[{i}]")
+        if i == 0:
+            for j in range(n):
+                m.MUL(t[j], a[j], qb)
+            mac_chain(m, n - 1, a.__getitem__, qb, True, t[1:], prods)
+            m.UMULH(t[n], a[n - 1], qb)
+            m.ADC(t[n], t[n], "xzr")
+        else:
+            # t[n + 1] is zero here: it is the limb the last shift moved out
+            mac_chain(m, n, a.__getitem__, qb, False, t, prods)
+            m.ADCS(t[n], t[n], "xzr")
+            m.ADC(t[n + 1], "xzr", "xzr")
+            mac_chain(m, n, a.__getitem__, qb, True, t[1:], prods)
+            m.ADC(t[n + 1], t[n + 1], "xzr")
+
+        m.comment(f"row {i}: t = (t + q*m) / 2^64")
+        m.MUL(qb, t[0], N0INV)
+        mac_chain(m, n, modulus, qb, False, t, prods)
+        m.ADCS(t[n], t[n], "xzr")
+        m.ADC(t[n + 1], "xzr" if i == 0 else t[n + 1], "xzr")
+        if not mod:
+            modulus = streamed(m, M_PTR, pair, n)
+        mac_chain(m, n, modulus, qb, True, t[1:], prods)
+        m.ADC(t[n + 1], t[n + 1], "xzr")
+        # t[0] is now exactly zero: the shift is a renaming, and the zero becomes the new t[n + 1]
+        t = t[1:] + t[:1]
+
+    m.comment("r = t >= m ? t - m : t")
+    if not mod:
+        modulus = streamed(m, M_PTR, pair, n)
+    for j in range(n):
+        (m.SUBS if j == 0 else m.SBCS)(a[j], t[j], modulus(j))
+    m.SBCS("xzr", t[n], "xzr")
+    for j in range(n):
+        m.CSEL(a[j], a[j], t[j], "cs")
+    for j in range(0, n - 1, 2):
+        _stp(m, a[j], a[j + 1], R_PTR, 8 * j)
+    if n % 2:
+        m.STR_offset(a[n - 1], R_PTR, 8 * (n - 1))
+
+    for r0, r1 in reversed(saved):
+        m.LDP_post(r0, r1, "sp", 16)
+
+
+class _Writer:
+    """Stores limbs at base, post-incremented, two at a time where they come in pairs."""
+
+    def __init__(self, m, base):
+        self.m, self.base, self.pending = m, base, None
+
+    def put(self, reg, last=False):
+        if self.pending is None and not last:
+            self.pending = reg
+        elif self.pending is None:
+            self.m.STR_post(reg, self.base, 8)
+        else:
+            self.m.STP_post(self.pending, reg, self.base, 16)
+            self.pending = None
+
+
+def _reader(m, base, pair, count):
+    """operand(j) for j = 0, 1, ... < count: limbs at base, post-incremented, two at a time."""
+    def operand(j):
+        if j % 2 == 0:
+            if j + 1 < count:
+                m.LDP_post(pair[0], pair[1], base, 16)
+            else:
+                m.LDR_post(pair[0], base, 8)
+        return pair[j % 2]
+    return operand
+
+
+def emit_montmul_row(m, n: int):
+    """One CIOS row with t[0, n + 2) on the stack: t = (t + a*b[i] + q*m) / 2^64."""
+    m.LDR_post(BI, B_PTR, 8)
+
+    m.comment("t += a*b[i]")
+    m.MOV(T_IN, "sp")
+    m.MOV(T_OUT, "sp")
+    x, limb, out = _reader(m, A_PTR, OPERAND, n), _reader(m, T_IN, LIMBS, n), _Writer(m, T_OUT)
+    for j in range(n):
+        aj, tj = x(j), limb(j)
+        m.MUL(LO, aj, BI)
+        m.UMULH(HI, aj, BI)
+        if j:
+            m.ADDS(LO, LO, CARRY)
+            m.ADC(HI, HI, "xzr")
+        m.ADDS(tj, tj, LO)
+        m.ADC(CARRY, HI, "xzr")
+        if j == 0:
+            m.MUL(Q, tj, N0INV)
+        out.put(tj, last=j == n - 1)
+    m.LDP(LIMBS[0], LIMBS[1], T_IN)
+    m.ADDS(LIMBS[0], LIMBS[0], CARRY)
+    m.ADC(LIMBS[1], LIMBS[1], "xzr")
+    m.STP(LIMBS[0], LIMBS[1], T_OUT)
+    m.SUB_imm(A_PTR, A_PTR, 8 * n)
+
+    m.comment("t = (t + q*m) / 2^64")
+    m.MOV(T_IN, "sp")
+    m.MOV(T_OUT, "sp")
+    x, limb = _reader(m, M_PTR, OPERAND, n), _reader(m, T_IN, LIMBS, n)
+    for j in range(n):
+        mj, tj = x(j), limb(j)
+        m.MUL(LO, mj, Q)
+        m.UMULH(HI, mj, Q)
+        if j == 0:
+            m.CMN(tj, LO)                   # t[0] + lo(q*m[0]) is zero; only its carry is kept
+        else:
+            m.ADDS(LO, LO, CARRY)
+            m.ADC(HI, HI, "xzr")
+            m.ADDS(tj, tj, LO)
+            m.STR_post(tj, T_OUT, 8)
+        m.ADC(CARRY, HI, "xzr")
+    m.LDP(LIMBS[0], LIMBS[1], T_IN)
+    m.ADDS(LIMBS[0], LIMBS[0], CARRY)
+    m.ADC(LIMBS[1], LIMBS[1], "xzr")
+    m.STP(LIMBS[0], LIMBS[1], T_OUT)
+    m.STR_offset("xzr", T_OUT, 16)
+    m.SUB_imm(M_PTR, M_PTR, 8 * n)
+
+
+def emit_montmul_memory(m, n: int, loop: str):
+    """CIOS with t[0, n + 2) on the stack and a loop over the rows."""
+    frame = (8 * (n + 2) + 15) // 16 * 16
+    m.SUB_imm("sp", "sp", frame)
+    m.MOV(T_OUT, "sp")
+    for _ in range(frame // 16):
+        m.STP_post("xzr", "xzr", T_OUT, 16)
+    m.MOV_imm(COUNT, n)
+
+    with Block(label=loop) as row:
+        emit_montmul_row(row, n)
+        row.SUBS_imm(COUNT, COUNT, 1)
+        row.B_cond("ne", loop)
+
+    m.comment("r = t >= m ? t - m : t, with m masked to zero when t < m")
+    m.MOV(T_IN, "sp")
+    x, limb = _reader(m, M_PTR, OPERAND, n), _reader(m, T_IN, LIMBS, n)
+    for j in range(n):
+        (m.SUBS if j == 0 else m.SBCS)("xzr", limb(j), x(j))
+    m.LDR(LIMBS[0], T_IN)
+    m.SBCS("xzr", LIMBS[0], "xzr")
+    m.CSETM(MASK, "cs")
+    m.SUB_imm(M_PTR, M_PTR, 8 * n)
+
+    m.MOV(T_IN, "sp")
+    x, limb, out = _reader(m, M_PTR, OPERAND, n), _reader(m, T_IN, LIMBS, n), _Writer(m, R_PTR)
+    for j in range(n):
+        mj, tj = x(j), limb(j)
+        m.AND(mj, mj, MASK)
+        (m.SUBS if j == 0 else m.SBCS)(tj, tj, mj)
+        out.put(tj, last=j == n - 1)
+    m.ADD_imm("sp", "sp", frame)
+
+
+def create_montmul(n: int, rename=False):
+    """
+    Create montmul_n(r, a, b, m, n0inv): r = a·b·2^(-64n) mod m for an odd n-limb modulus m,
+    with n0inv = -m⁻¹ mod 2^64 and a, b < m. r may alias a or b.
+    """
+    if not 4 <= n <= 64:
+        raise ValueError(f"Montgomery multiplication supports 4 to 64 limbs, not {n}")
+    label = f"montmul_{n}"
+    with ASMCode(label=label, rename=rename) as f:
+        if n <= MAX_REGISTER_LIMBS:
+            emit_montmul_registers(f, n)
+        else:
+            emit_montmul_memory(f, n, f"{label}_row")
+    return f
+
+
+def main():
+    print("=== Montgomery Multiplication Generator (CIOS) ===")
+    out = BackgroundCode()
+    with out:
+        for n in SIZES:
+            create_montmul(n)
+    out.export_to_file("montmul.s")
+    for n in SIZES:
+        where = "registers" if n <= MAX_REGISTER_LIMBS else "stack, row loop"
+        print(f"✓ montmul_{n:<2} ({64 * n:>4}-bit modulus): accumulator in {where}")
+    print("✓ Assembly exported to: montmul.s")
+    print("Run 'make run-montmul' to check against GMP with random moduli.")
+
+
+if __name__ == "__main__":
+    main()
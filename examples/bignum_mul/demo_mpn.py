@@ -0,0 +1,363 @@
+#!/usr/bin/env python3
+"""
+N-limb primitives with the GMP mpn argument order; the carry or borrow comes back in x0.
+
+    add_n(r, u, v, n)            r = u + v                 returns carry
+    sub_n(r, u, v, n)            r = u - v                 returns borrow
+    cmp_n(u, v, n)               sign(u - v)               returns -1, 0 or 1
+    neg_n(r, u, n)               r = -u mod 2^(64n)        returns borrow (1 unless u = 0)
+    add_1(r, u, n, v)            r = u + v, one-limb v     returns carry (n >= 1)
+    sub_1(r, u, n, v)            r = u - v, one-limb v     returns borrow (n >= 1)
+    cnd_add_n(c, r, u, v, n)     r = u + (c ? v : 0)       returns carry
+    cnd_sub_n(c, r, u, v, n)     r = u - (c ? v : 0)       returns borrow
+
+    mul_1(r, u, n, v)            r = u * v                 returns the high limb
+    addmul_1(r, u, n, v)         r += u * v                returns the carry limb
+    submul_1(r, u, n, v)         r -= u * v                returns the borrow limb
+    mul_basecase(r, u, un, v, vn)  r[0, un+vn) = u * v     un >= vn >= 1
+    sqr_basecase(r, u, n)        r[0, 2n) = u^2            n >= 1
+
+n is a runtime count. The first n mod 4 limbs go one at a time, the rest in
+blocks of four: two LDP per operand, one ADCS/SBCS chain, two STP, all with
+post-incremented pointers. The loop counters use SUB and CBZ/CBNZ, which
+leave the flags alone, so a single carry chain runs through the whole
+operand. r may alias u or v.
+
+cmp_n reads every limb instead of stopping at the first difference, and
+cnd_add_n/cnd_sub_n mask v rather than branch on c, so neither one's
+timing depends on the data.
+
+The multiply rows are software-pipelined for a machine model (Loop with
+pipeline=, see demo_modulo_schedule.py); the basecases run one such row per
+limb of v, or per limb of u for the cross products of a square, which is
+then doubled and given its diagonal in one EXTR + ADCS pass. With --gmp the
+multiply routines are named __gmpn_* as in a GMP build, so a library made
+from them can be linked ahead of -lgmp.
+
+Usage:
+    python3 demo_mpn.py [--gmp] [model]     (model: see armasmgen.machine.MODELS)
+"""
+
+import sys
+
+from armasmgen.builder import ASMCode, Block, BackgroundCode, Loop
+from armasmgen.machine import MODELS, NEOVERSE_N1
+from armasmgen.register import x_reg
+
+from demo_montmul import _callee_saved
+
+U = [x_reg(i) for i in range(8, 12)]
+V = [x_reg(i) for i in range(12, 16)]
+SINGLE, BLOCKS = x_reg(16), x_reg(17)
+ACC, MASK = x_reg(7), x_reg(6)
+
+# Multiply rows: x5-x9 hold the row body and x10-x17 its modulo-expanded
+# copies; inside the basecases a row's count, pointers and multiplier live in
+# the callee-saved ROW registers.
+A, R, LO, HI, CARRY = (x_reg(i) for i in range(5, 10))
+SCRATCH = [x_reg(i) for i in range(10, 18)]
+ROW = [x_reg(i) for i in range(19, 23)]
+
+GMP_PREFIX = "__gmpn_"
+
+
+def emit_limbs(m, name, n, loads, body, rp=None):
+    """
+    Run body(m, k) over n limbs, k being the limb's slot in U and V: the first
+    n mod 4 limbs one at a time in slot 0, then blocks of four in slots 0-3.
+    loads is [(pointer, registers)]; each limb is loaded from every pointer before
+    body runs, and the U slot is stored to rp afterwards when rp is given.
+    """
+    m.AND_imm(SINGLE, n, 3)
+    m.LSR(BLOCKS, n, 2)
+    m.CBZ(SINGLE, f"{name}_blocks")
+
+    with Block(label=f"{name}_single") as single:
+        for ptr, regs in loads:
+            single.LDR_post(regs[0], ptr, 8)
+        body(single, 0)
+        if rp:
+            single.STR_post(U[0], rp, 8)
+        single.SUB_imm(SINGLE, SINGLE, 1)
+        single.CBNZ(SINGLE, f"{name}_single")
+
+    with Block(label=f"{name}_blocks") as blocks:
+        blocks.CBZ(BLOCKS, f"{name}_done")
+
+    with Block(label=f"{name}_loop") as loop:
+        for ptr, regs in loads:
+            loop.LDP_post(regs[0], regs[1], ptr, 16)
+            loop.LDP_post(regs[2], regs[3], ptr, 16)
+        for k in range(4):
+            body(loop, k)
+        if rp:
+            loop.STP_post(U[0], U[1], rp, 16)
+            loop.STP_post(U[2], U[3], rp, 16)
+        loop.SUB_imm(BLOCKS, BLOCKS, 1)
+        loop.CBNZ(BLOCKS, f"{name}_loop")
+
+    with Block(label=f"{name}_done"):
+        pass
+
+
+def emit_add_n(m, name, subtract=False):
+    rp, up, vp, n = (x_reg(i) for i in range(4))
+    if subtract:
+        m.CMP("xzr", "xzr")     # C = 1: no borrow in
+    else:
+        m.CMN("xzr", "xzr")     # C = 0: no carry in
+    op = "SBCS" if subtract else "ADCS"
+    emit_limbs(m, name, n, [(up, U), (vp, V)], lambda e, k: getattr(e, op)(U[k], U[k], V[k]), rp)
+    _return_carry(m, subtract)
+
+
+def emit_cmp_n(m, name):
+    up, vp, n = (x_reg(i) for i in range(3))
+    m.CMP("xzr", "xzr")
+    m.MOV_imm(ACC, 0)
+
+    def body(e, k):
+        e.SBCS(U[k], U[k], V[k])
+        e.ORR(ACC, ACC, U[k])
+    emit_limbs(m, name, n, [(up, U), (vp, V)], body)
+    m.comment("x0 = borrow ? -1 : (u - v != 0)")
+    m.SBC(x_reg(0), "xzr", "xzr")
+    m.CMP_imm(ACC, 0)
+    m.CINC(ACC, "xzr", "ne")
+    m.ORR(x_reg(0), x_reg(0), ACC)
+
+
+def emit_neg_n(m, name):
+    rp, up, n = (x_reg(i) for i in range(3))
+    m.CMP("xzr", "xzr")
+    emit_limbs(m, name, n, [(up, U)], lambda e, k: e.SBCS(U[k], "xzr", U[k]), rp)
+    _return_carry(m, subtract=True)
+
+
+def emit_add_1(m, name, subtract=False):
+    rp, up, n, v = (x_reg(i) for i in range(4))
+    m.LDR_post(U[0], up, 8)
+    (m.SUBS if subtract else m.ADDS)(U[0], U[0], v)
+    m.STR_post(U[0], rp, 8)
+    m.SUB_imm(n, n, 1)
+    op = "SBCS" if subtract else "ADCS"
+    emit_limbs(m, name, n, [(up, U)], lambda e, k: getattr(e, op)(U[k], U[k], "xzr"), rp)
+    _return_carry(m, subtract)
+
+
+def emit_cnd_add_n(m, name, subtract=False):
+    cnd, rp, up, vp, n = (x_reg(i) for i in range(5))
+    m.CMP_imm(cnd, 0)
+    m.CSETM(MASK, "ne")
+    if subtract:
+        m.CMP("xzr", "xzr")
+    else:
+        m.CMN("xzr", "xzr")
+    op = "SBCS" if subtract else "ADCS"
+
+    def body(e, k):
+        e.AND(V[k], V[k], MASK)
+        getattr(e, op)(U[k], U[k], V[k])
+    emit_limbs(m, name, n, [(up, U), (vp, V)], body, rp)
+    _return_carry(m, subtract)
+
+
+def emit_row(m, name, kind, rp, up, n, v, model):
+    """
+    One pipelined row over n limbs: r = u*v, r += u*v or r -= u*v for kind
+    mul, addmul or submul. rp and up are post-incremented, n is counted down,
+    and the carry limb is left in CARRY. Returns the loop's schedule report.
+    """
+    m.MOV(CARRY, "xzr")
+    with Loop(n, label=f"{name}_row", pipeline=model, scratch=SCRATCH, noalias=True) as lp:
+        lp.LDR_post(A, up, 8)
+        if kind != "mul":
+            lp.LDR(R, rp)
+        lp.MUL(LO, A, v)
+        lp.UMULH(HI, A, v)
+        if kind == "addmul":
+            lp.ADDS(LO, LO, R)
+            lp.ADCS(HI, HI, "xzr")
+        lp.ADDS(LO, LO, CARRY)
+        if kind == "submul":
+            # u*v + carry fits in two limbs, so neither increment of HI overflows
+            lp.ADC(HI, HI, "xzr")
+            lp.SUBS(R, R, LO)
+            lp.CINC(CARRY, HI, "cc")
+            lp.STR_post(R, rp, 8)
+        else:
+            lp.ADC(CARRY, HI, "xzr")
+            lp.STR_post(LO, rp, 8)
+    return lp.report
+
+
+def emit_mul_1(m, name, model, kind="mul"):
+    rp, up, n, v = (x_reg(i) for i in range(4))
+    emit_row(m, name, kind, rp, up, n, v, model)
+    m.MOV(x_reg(0), CARRY)
+
+
+def emit_mul_basecase(m, name, model):
+    """r = u * v: a mul row for v[0], then an addmul row per limb of v, carry stored above each row."""
+    rp, up, un, vp, vn = (x_reg(i) for i in range(5))
+    count, uptr, rptr, vj = ROW
+    saved = _callee_saved(ROW)
+    for r0, r1 in saved:
+        m.STP_pre(r0, r1, "sp", -16)
+    m.MOV(rptr, rp)
+
+    for kind in ("mul", "addmul"):
+        with Block(label=f"{name}_{kind}") as row:
+            row.MOV(count, un)
+            row.MOV(uptr, up)
+            row.LDR_post(vj, vp, 8)
+            emit_row(row, f"{name}_{kind}", kind, rptr, uptr, count, vj, model)
+            row.STR(CARRY, rptr)
+            row.ADD_imm(rp, rp, 8)
+            row.MOV(rptr, rp)
+            row.SUB_imm(vn, vn, 1)
+            if kind == "addmul":
+                row.CBNZ(vn, f"{name}_addmul")
+            else:
+                row.CBZ(vn, f"{name}_done")
+    with Block(label=f"{name}_done") as done:
+        for r0, r1 in reversed(saved):
+            done.LDP_post(r0, r1, "sp", 16)
+
+
+def emit_sqr_basecase(m, name, model):
+    """
+    r = u^2: the cross products u[i] * u[i+1, n) go in by rows starting at
+    r[2i+1], then r = 2r + sum u[i]^2 * 2^(128i) limb pair by limb pair.
+    """
+    rp, up, n = (x_reg(i) for i in range(3))
+    vp, rbase, length = x_reg(3), x_reg(4), x_reg(23)
+    count, uptr, rptr, vi = ROW
+    saved = _callee_saved(ROW + [length])
+    for r0, r1 in saved:
+        m.STP_pre(r0, r1, "sp", -16)
+
+    m.STR_post("xzr", rp, 8)
+    m.MOV(vp, up)
+    m.MOV(rbase, rp)
+    m.SUB_imm(length, n, 1)
+
+    m.comment("cross products: r[2i+1, n+i] = u[i] * u[i+1, n) (+ r)")
+    for kind in ("mul", "addmul"):
+        with Block(label=f"{name}_{kind}") as row:
+            if kind == "addmul":
+                row.CMP_imm(length, 0)      # n = 1 leaves length at -1
+                row.B_cond("le", f"{name}_diagonal")
+            row.MOV(count, length)
+            row.LDR_post(vi, vp, 8)
+            row.MOV(uptr, vp)
+            row.MOV(rptr, rbase)
+            emit_row(row, f"{name}_{kind}", kind, rptr, uptr, count, vi, model)
+            row.STR(CARRY, rptr)
+            row.ADD_imm(rbase, rbase, 16)
+            row.SUB_imm(length, length, 1)
+            if kind == "addmul":
+                row.B(f"{name}_addmul")
+
+    prev, t0, t1, d0, d1 = x_reg(3), x_reg(4), *SCRATCH[:3]
+    with Block(label=f"{name}_diagonal") as diag:
+        diag.comment("r = 2r + diagonal; r[0] and r[2n-1] are still zero")
+        diag.SUB_imm(rp, rp, 8)
+        diag.LSL(t0, n, 4)
+        diag.ADD(t0, rp, t0)
+        diag.STR_offset("xzr", t0, -8)
+        diag.MOV(prev, "xzr")
+        diag.CMN("xzr", "xzr")
+        with Loop(n, label=f"{name}_pair") as lp:
+            lp.LDR_post(A, up, 8)
+            lp.MUL(LO, A, A)
+            lp.UMULH(HI, A, A)
+            lp.LDP(t0, t1, rp)
+            lp.EXTR(d0, t0, prev, 63)
+            lp.EXTR(d1, t1, t0, 63)
+            lp.MOV(prev, t1)
+            lp.ADCS(d0, d0, LO)
+            lp.ADCS(d1, d1, HI)
+            lp.STP_post(d0, d1, rp, 16)
+        for r0, r1 in reversed(saved):
+            diag.LDP_post(r0, r1, "sp", 16)
+
+
+def _return_carry(m, subtract):
+    if subtract:
+        m.CINC(x_reg(0), "xzr", "cc")   # borrow = !C
+    else:
+        m.ADC(x_reg(0), "xzr", "xzr")
+
+
+PRIMITIVES = {
+    "add_n": lambda m, name: emit_add_n(m, name),
+    "sub_n": lambda m, name: emit_add_n(m, name, subtract=True),
+    "cmp_n": emit_cmp_n,
+    "neg_n": emit_neg_n,
+    "add_1": lambda m, name: emit_add_1(m, name),
+    "sub_1": lambda m, name: emit_add_1(m, name, subtract=True),
+    "cnd_add_n": lambda m, name: emit_cnd_add_n(m, name),
+    "cnd_sub_n": lambda m, name: emit_cnd_add_n(m, name, subtract=True),
+}
+
+
+MULTIPLY = {
+    "mul_1": lambda m, name, model: emit_mul_1(m, name, model),
+    "addmul_1": lambda m, name, model: emit_mul_1(m, name, model, "addmul"),
+    "submul_1": lambda m, name, model: emit_mul_1(m, name, model, "submul"),
+    "mul_basecase": emit_mul_basecase,
+    "sqr_basecase": emit_sqr_basecase,
+}
+
+
+def create_primitive(name: str, rename=False, model=NEOVERSE_N1, prefix=""):
+    """
+    Create one of PRIMITIVES or MULTIPLY as the function prefix + name; the
+    multiply rows are pipelined for model.
+    """
+    label = prefix + name
+    if name in PRIMITIVES:
+        with ASMCode(label=label, rename=rename) as f:
+            PRIMITIVES[name](f, label)
+    elif name in MULTIPLY:
+        with ASMCode(label=label, rename=rename) as f:
+            MULTIPLY[name](f, label, model)
+    else:
+        raise ValueError(f"unknown primitive {name}; choose from {', '.join([*PRIMITIVES, *MULTIPLY])}")
+    return f
+
+
+def main():
+    args = sys.argv[1:]
+    gmp = "--gmp" in args
+    names = [a for a in args if a != "--gmp"]
+    if len(names) > 1 or (names and names[0] not in MODELS):
+        raise ValueError(f"usage: demo_mpn.py [--gmp] [model]; models: {', '.join(MODELS)}")
+    model = MODELS[names[0]] if names else NEOVERSE_N1
+
+    print("=== N-Limb Primitive Generator ===")
+    out = BackgroundCode()
+    with out:
+        if gmp:
+            for name in MULTIPLY:
+                create_primitive(name, model=model, prefix=GMP_PREFIX)
+        else:
+            for name in [*PRIMITIVES, *MULTIPLY]:
+                create_primitive(name, model=model)
+    path = "mpn_gmp.s" if gmp else "mpn.s"
+    out.export_to_file(path)
+    if not gmp:
+        print(f"✓ {', '.join(PRIMITIVES)}")
+        print("✓ n mod 4 single limbs, then 4-limb LDP/STP blocks; carry or borrow returned in x0")
+    print(f"✓ {', '.join(GMP_PREFIX + n if gmp else n for n in MULTIPLY)}")
+    print(f"✓ multiply rows pipelined for {model.name}")
+    print(f"✓ Assembly exported to: {path}")
+    if gmp:
+        print("Run 'make libmpn_tuned.a' to build the drop-in library.")
+    else:
+        print("Run 'make run-mpn' to check against GMP's mpn functions.")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,145 @@
+#!/usr/bin/env python3
+"""
+Batched multiplication generator: one call multiplies count operand pairs.
+
+    void mul256x256_batch(size_t count, const uint64_t *a, const uint64_t *b, uint64_t *r)
+
+    r[2n·i, 2n·(i+1)) = a[n·i, n·(i+1)) · b[n·i, n·(i+1))   for i = 0 .. count-1
+
+Each product is the Comba kernel of demo_mul_fixed.py. The batch saves
+what a loop of mul256x256_comba calls pays per product: the call and
+return, the callee-saved spills, and the operand loads at the head of
+each product, which start only after the previous call returned.
+
+Software pipelining of the loads: a[i] and b[i] are last read in column
+n-1+i, so the top half of one product frees the operand registers pair
+by pair. Each LDP_post of the next operands goes right after the last
+reader of its pair, so the next product starts with its operands in
+flight or already loaded. The last product runs peeled, without loads
+past the end of a and b.
+
+The loop is prefetched by the Loop(prefetch=...) pass: a, b and r are
+induction pointers of the body, so every iteration touches the operands
+PREFETCH_AHEAD products ahead with PRFM PLDL1KEEP and the result with
+PSTL1KEEP, one PRFM per cache line. --prefetch-distance D sets the
+distance in products (0 turns prefetching off; --no-prefetch is the same),
+and make tune-batch times the batches at each distance in
+PREFETCH_DISTANCES.
+
+Usage:
+    python3 demo_mul_batch.py [--no-prefetch | --prefetch-distance D]
+"""
+
+import sys
+
+from armasmgen.builder import ASMCode, Block, BackgroundCode, Loop, record
+from armasmgen.passes.analysis import canonical, uses
+from armasmgen.passes.prefetch import PrefetchPolicy
+from armasmgen.register import x_reg
+
+from demo_mul_fixed import comba_limbs, comba_operands, create_mul_comba, emit_comba
+
+BATCH_SIZES = (128, 256, 384, 512)
+
+# Products between a PRFM and the product that reads the line
+PREFETCH_AHEAD = 8
+
+# Comba uses x0 and x3-x17 (x19-x26 too above 256 bits); the batch state lives around it
+PTR_A, PTR_B = x_reg(1), x_reg(2)
+COUNT, PTR_R = x_reg(27), x_reg(28)
+
+
+def load_pairs(m, regs, ptr):
+    for i in range(0, len(regs), 2):
+        m.LDP_post(regs[i], regs[i + 1], ptr, 16)
+
+
+def emit_product_loading_next(m, n, a, b):
+    """One Comba product whose tail loads the next a and b as their registers die."""
+    product = record(lambda s: emit_comba(s, n, a, b, PTR_R, post_index=True))
+    last_use = {}
+    for pos, inst in enumerate(product):
+        for r in uses(inst):
+            last_use[r] = pos
+
+    # (position, ptr, pair): one LDP_post per operand pair, after the last reader of both registers
+    loads = []
+    for regs, ptr in ((a, PTR_A), (b, PTR_B)):
+        for i in range(0, n, 2):
+            pos = max(last_use[canonical(str(regs[i]))], last_use[canonical(str(regs[i + 1]))])
+            loads.append((pos, ptr, (regs[i], regs[i + 1])))
+    loads.sort(key=lambda load: load[0])
+    for ptr, regs in ((PTR_A, a), (PTR_B, b)):
+        # Post-indexing walks each operand upwards: the pairs must come free in limb order
+        order = [pair for _, p, pair in loads if p is ptr]
+        if order != [(regs[i], regs[i + 1]) for i in range(0, n, 2)]:
+            raise ValueError("operand pairs of the next product would load out of order")
+
+    pending = iter(loads)
+    nxt = next(pending, None)
+    for pos, inst in enumerate(product):
+        m.emit(inst)
+        while nxt is not None and nxt[0] == pos:
+            m.LDP_post(*nxt[2], nxt[1], 16)
+            nxt = next(pending, None)
+
+
+def create_mul_batch(bits: int, distance: int = PREFETCH_AHEAD):
+    """mul{bits}x{bits}_batch(count, a, b, r): count products of consecutive n-limb operands, prefetched distance products ahead (0: off)."""
+    n = comba_limbs(bits, "batched multiplication")
+    if n % 2:
+        raise ValueError(f"batched multiplication loads operands in pairs, {bits} bits is an odd limb count")
+    name = f"mul{bits}x{bits}_batch"
+    a, b = comba_operands(n, squaring=False)
+    saved = [(x_reg(27), x_reg(28))] + ([(x_reg(19 + i), x_reg(20 + i)) for i in range(0, n, 2)] if n > 4 else [])
+
+    with ASMCode(label=name) as f:
+        # mul{bits}x{bits}_batch(size_t count, const uint64_t *a, const uint64_t *b, uint64_t *r)
+        for r0, r1 in saved:
+            f.STP_pre(r0, r1, "sp", -16)
+        f.MOV(COUNT, x_reg(0))
+        f.MOV(PTR_R, x_reg(3))
+        f.CBZ(COUNT, f"{name}_done")
+
+        load_pairs(f, a, PTR_A)
+        load_pairs(f, b, PTR_B)
+        f.SUB_imm(COUNT, COUNT, 1)
+        with Loop(COUNT, label=f"{name}_loop", prefetch=PrefetchPolicy(distance) if distance else None) as lp:
+            emit_product_loading_next(lp, n, a, b)
+
+        f.comment("last product: nothing left to load")
+        emit_comba(f, n, a, b, PTR_R, post_index=True)
+        with Block(label=f"{name}_done"):
+            pass
+        for r0, r1 in reversed(saved):
+            f.LDP_post(r0, r1, "sp", 16)
+    return f
+
+
+def main():
+    args = sys.argv[1:]
+    if args == []:
+        distance = PREFETCH_AHEAD
+    elif args == ["--no-prefetch"]:
+        distance = 0
+    elif len(args) == 2 and args[0] == "--prefetch-distance" and args[1].isdigit():
+        distance = int(args[1])
+    else:
+        raise ValueError("usage: demo_mul_batch.py [--no-prefetch | --prefetch-distance D]")
+
+    print("=== Batched Multiplication Generator ===")
+    out = BackgroundCode()
+    with out:
+        for bits in BATCH_SIZES:
+            create_mul_batch(bits, distance)
+            create_mul_comba(bits)      # the one-call-per-product baseline
+    out.export_to_file("mul_batch.s")
+    for bits in BATCH_SIZES:
+        print(f"✓ mul{bits}x{bits}_batch, with mul{bits}x{bits}_comba as the per-call baseline")
+    print(f"✓ Prefetch: {f'{distance} products ahead' if distance else 'off'}")
+    print("✓ Assembly exported to: mul_batch.s")
+    print("Run 'make run-batch' to check against GMP and time batches of 1 to 1M products.")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,307 @@
+#!/usr/bin/env python3
+"""
+Multiplication tuning driver: picks the fastest strategy per limb count and
+writes it down as a C header.
+
+    void mul_dispatch(size_t n, uint64_t r[2n], const uint64_t a[n], const uint64_t b[n])
+
+The candidates are the generators already in this directory:
+
+    comba       product scanning, operands in registers    2 to 8 limbs, even
+    karatsuba   three half-size products per level          8 limbs and up
+    toom3       five third-size products                    12 limbs and up
+    basecase    mul_basecase from demo_mpn.py, one pipelined row per limb of b, any n
+
+Every candidate at every size in LIMBS goes into mul_dispatch.s, so any
+table the header picks links. The ranking comes from one of two sources:
+
+    model       the cycle model: straight-line kernels are list-scheduled
+                against a MachineModel (issue width, unit counts, latency and
+                occupancy; register and flag dependencies only, memory
+                assumed to forward), the basecase costs its rows at the II
+                the modulo scheduler reached. Good enough to rank, not to
+                predict.
+    --timings   the output of bench_mul_dispatch, the generated C driver that
+                times every candidate on the machine at hand (make tune-mul).
+
+mul_dispatch.h then holds GMP-style thresholds (the smallest tuned size each
+strategy wins at, like MUL_TOOM22_THRESHOLD) and a table of the winners
+indexed by n; sizes that were not tuned, or that the basecase won, call
+mul_basecase.
+
+Usage:
+    python3 demo_mul_dispatch.py [model]              (default neoverse-n1)
+    python3 demo_mul_dispatch.py --timings FILE
+"""
+
+import sys
+
+from armasmgen.builder import ASMCode, BackgroundCode
+from armasmgen.machine import MODELS, NEOVERSE_N1
+from armasmgen.passes.analysis import defs_with_flags, mnemonic, uses_with_flags
+
+from demo_mul_fixed import create_mul_comba
+from demo_mul_karatsuba import create_mul_karatsuba
+from demo_mul_toom3 import create_mul_toom3
+from demo_mpn import create_primitive, emit_row
+
+LIMBS = (2, 4, 6, 8, 12, 16, 24, 32, 48, 64, 96, 128)
+
+# Instructions of one basecase row outside the pipelined loop (pointer and count setup, carry store, branch)
+ROW_OVERHEAD = 8
+
+
+STRATEGIES = {
+    "comba": (lambda n: n <= 8 and n % 2 == 0, lambda bits: create_mul_comba(bits, rename=True)),
+    "karatsuba": (lambda n: n >= 8, create_mul_karatsuba),
+    "toom3": (lambda n: n >= 12, create_mul_toom3),
+    "basecase": (lambda n: True, None),
+}
+
+
+def symbol(strategy: str, n: int) -> str:
+    return "mul_basecase" if strategy == "basecase" else f"mul{64 * n}x{64 * n}_{strategy}"
+
+
+def candidates():
+    """(strategy, n) for every strategy that accepts n."""
+    return [(name, n) for n in LIMBS for name, (accepts, _) in STRATEGIES.items() if accepts(n)]
+
+
+# ═══════════════════════════════════════════════════════════════
+# Cycle model
+# ═══════════════════════════════════════════════════════════════
+
+def model_cycles(insts, model) -> int:
+    """
+    Cycles for a straight-line instruction stream on an out-of-order core
+    with an unbounded window: each instruction issues at the first cycle its
+    operands are ready, a unit of its class is free and the issue width is
+    not used up.
+    """
+    ready = {}
+    issued = {}                         # cycle -> instructions issued
+    busy = {}                           # (unit, cycle) -> units occupied
+    end = 0
+    for inst in insts:
+        if not mnemonic(inst):
+            continue
+        timing = model.timing(inst)
+        count = model.units.get(timing.unit, 1)
+        t = max((ready.get(r, 0) for r in uses_with_flags(inst)), default=0)
+        while (issued.get(t, 0) >= model.issue_width
+               or any(busy.get((timing.unit, t + k), 0) >= count for k in range(timing.occupancy))):
+            t += 1
+        issued[t] = issued.get(t, 0) + 1
+        for k in range(timing.occupancy):
+            busy[(timing.unit, t + k)] = busy.get((timing.unit, t + k), 0) + 1
+        for r in defs_with_flags(inst):
+            ready[r] = t + timing.latency
+        end = max(end, t + timing.latency)
+    return end
+
+
+def basecase_cycles(n: int, model) -> int:
+    """n addmul rows at the II the modulo scheduler reaches for this model."""
+    with BackgroundCode():
+        with ASMCode(label="row_estimate") as f:
+            report = emit_row(f, "row_estimate", "addmul", "x0", "x1", "x2", "x3", model)
+    row = (n + report.stages - 1) * report.ii + -(-ROW_OVERHEAD // model.issue_width)
+    return n * row
+
+
+def estimate(kernels: dict, strategy: str, n: int, model) -> float:
+    if strategy == "basecase":
+        return basecase_cycles(n, model)
+    return model_cycles(kernels[(strategy, n)]._inst, model)
+
+
+def read_timings(path: str) -> dict:
+    """'strategy n ns' lines from bench_mul_dispatch; '#' starts a comment."""
+    times = {}
+    with open(path) as src:
+        for line in src:
+            fields = line.split("#", 1)[0].split()
+            if len(fields) == 3:
+                times[(fields[0], int(fields[1]))] = float(fields[2])
+    if not times:
+        raise ValueError(f"no timings in {path}")
+    return times
+
+
+# ═══════════════════════════════════════════════════════════════
+# Outputs
+# ═══════════════════════════════════════════════════════════════
+
+def winners(times: dict) -> dict:
+    """n -> fastest strategy."""
+    best = {}
+    for (name, n), t in times.items():
+        if n not in best or t < times[(best[n], n)]:
+            best[n] = name
+    return best
+
+
+def thresholds(best: dict) -> dict:
+    """Strategy -> smallest tuned size it wins at (None if it never does)."""
+    return {name: min((n for n, w in best.items() if w == name), default=None)
+            for name in STRATEGIES if name != "basecase"}
+
+
+def write_header(path: str, best: dict, source: str):
+    picked = {n: name for n, name in sorted(best.items()) if name != "basecase"}
+    defines = "\n".join(f"#define MUL_{name.upper()}_THRESHOLD {'SIZE_MAX' if n is None else n}"
+                        for name, n in thresholds(best).items())
+    externs = "\n".join(f"extern void {symbol(name, n)}(const uint64_t *a, const uint64_t *b, uint64_t *r);"
+                        for n, name in picked.items())
+    table = "\n".join(f"    [{n}] = {symbol(name, n)}," for n, name in picked.items())
+    with open(path, "w") as out:
+        out.write(f"""// Generated by demo_mul_dispatch.py from {source}: the fastest multiplier per tuned size
+#ifndef MUL_DISPATCH_H
+#define MUL_DISPATCH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Smallest tuned size each strategy wins at (SIZE_MAX: none), as GMP's MUL_TOOM22_THRESHOLD
+{defines}
+
+#define MUL_DISPATCH_MAX {max(LIMBS)}
+
+extern void mul_basecase(uint64_t *r, const uint64_t *u, size_t un, const uint64_t *v, size_t vn);
+{externs}
+
+typedef void (*mul_kernel)(const uint64_t *a, const uint64_t *b, uint64_t *r);
+
+// Winner at each tuned size; every other size runs the basecase
+static const mul_kernel mul_table[MUL_DISPATCH_MAX + 1] = {{
+{table}
+}};
+
+// r[0, 2n) = a[0, n) * b[0, n), n >= 1
+static inline void mul_dispatch(size_t n, uint64_t *r, const uint64_t *a, const uint64_t *b) {{
+    if (n <= MUL_DISPATCH_MAX && mul_table[n]) {{
+        mul_table[n](a, b, r);
+    }} else {{
+        mul_basecase(r, a, n, b, n);
+    }}
+}}
+
+#endif
+""")
+
+
+def write_bench(path: str, entries):
+    """C driver printing 'strategy n ns' for every candidate, the input of --timings."""
+    externs = "\n".join(sorted({f"extern void {symbol(name, n)}(const uint64_t *a, const uint64_t *b, uint64_t *r);"
+                                for name, n in entries if name != "basecase"}))
+    table = "\n".join(f'    {{ "{name}", {n}, {"NULL" if name == "basecase" else symbol(name, n)} }},'
+                      for name, n in entries)
+    max_limbs = max(LIMBS)
+    with open(path, "w") as out:
+        out.write(f"""// Generated by demo_mul_dispatch.py: times every multiplication candidate, one 'strategy n ns' line each
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <time.h>
+
+extern void mul_basecase(uint64_t *r, const uint64_t *u, size_t un, const uint64_t *v, size_t vn);
+{externs}
+
+typedef void (*mul_kernel)(const uint64_t *a, const uint64_t *b, uint64_t *r);
+
+static const struct {{
+    const char *strategy;
+    int n;
+    mul_kernel mul;     // NULL: mul_basecase
+}} candidates[] = {{
+{table}
+}};
+
+#define MAX_LIMBS {max_limbs}
+#define REPEATS 5
+
+static double now_ns(void) {{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}}
+
+int main(void) {{
+    static uint64_t a[MAX_LIMBS], b[MAX_LIMBS], r[2 * MAX_LIMBS];
+    for (int i = 0; i < MAX_LIMBS; i++) {{
+        a[i] = ((uint64_t)rand() << 33) ^ (uint64_t)rand();
+        b[i] = ((uint64_t)rand() << 33) ^ (uint64_t)rand();
+    }}
+
+    printf("# strategy limbs ns (best of %d runs)\\n", REPEATS);
+    for (size_t c = 0; c < sizeof candidates / sizeof candidates[0]; c++) {{
+        int n = candidates[c].n;
+        int iterations = 4000000 / (n * n) + 100;
+        double best = 0;
+        for (int rep = 0; rep < REPEATS; rep++) {{
+            double start = now_ns();
+            for (int i = 0; i < iterations; i++) {{
+                if (candidates[c].mul) {{
+                    candidates[c].mul(a, b, r);
+                }} else {{
+                    mul_basecase(r, a, n, b, n);
+                }}
+                a[0] ^= r[n];   // keep the calls dependent
+            }}
+            double ns = (now_ns() - start) / iterations;
+            best = rep == 0 || ns < best ? ns : best;
+        }}
+        printf("%s %d %.1f\\n", candidates[c].strategy, n, best);
+    }}
+    return 0;
+}}
+""")
+
+
+def main():
+    args = sys.argv[1:]
+    entries = candidates()
+
+    print("=== Multiplication Tuning Driver ===")
+    out = BackgroundCode()
+    with out:
+        kernels = {(name, n): STRATEGIES[name][1](64 * n) for name, n in entries if name != "basecase"}
+        create_primitive("mul_basecase")
+    out.export_to_file("mul_dispatch.s")
+    write_bench("bench_mul_dispatch.c", entries)
+    print(f"✓ {len(entries)} candidates exported to: mul_dispatch.s")
+    print("✓ Timing driver written to: bench_mul_dispatch.c")
+
+    if args[:1] == ["--timings"]:
+        if len(args) != 2:
+            raise ValueError("usage: demo_mul_dispatch.py --timings FILE")
+        times = {key: t for key, t in read_timings(args[1]).items() if key in entries}
+        source, unit = f"measured timings in {args[1]}", "ns"
+    else:
+        if len(args) > 1 or (args and args[0] not in MODELS):
+            raise ValueError(f"usage: demo_mul_dispatch.py [model | --timings FILE]; models: {', '.join(MODELS)}")
+        model = MODELS[args[0]] if args else NEOVERSE_N1
+        times = {(name, n): estimate(kernels, name, n, model) for name, n in entries}
+        source, unit = f"the {model.name} cycle model", "cycles"
+
+    best = winners(times)
+    print(f"\nRanking from {source} ({unit}):")
+    print(f"{'limbs':>6}" + "".join(f"{name:>12}" for name in STRATEGIES))
+    for n in LIMBS:
+        cells = []
+        for name in STRATEGIES:
+            t = times.get((name, n))
+            mark = "*" if best.get(n) == name else " "
+            cells.append(f"{'-':>12}" if t is None else f"{t:>11.0f}{mark}")
+        print(f"{n:>6}" + "".join(cells))
+    for name, n in thresholds(best).items():
+        print(f"  MUL_{name.upper()}_THRESHOLD = {'none' if n is None else n}")
+
+    write_header("mul_dispatch.h", best, source)
+    print("✓ Thresholds and dispatch table written to: mul_dispatch.h")
+    print("Run 'make run-mul-dispatch' to check mul_dispatch against GMP, 'make tune-mul' to rank on this machine.")
+
+
+if __name__ == "__main__":
+    main()
@@ -6,7 +6,7 @@ Uses advanced ARM64 addressing modes and instruction optimizations.
 Demonstrates clean register abstraction with ArmAsmGen's register system.
 """
 
-from armasmgen.builder import ASMCode, Block
+from armasmgen.builder import ASMCode, Block, BackgroundCode
 from armasmgen.mixins.arithmetic import ArithmeticMixin
 from armasmgen.mixins.memory import MemoryMixin
 from armasmgen.mixins.control import ControlFlowMixin
@@ -16,10 +16,10 @@ from armasmgen.register import x_reg
 class AArch64MultiplicationISA(ArithmeticMixin, MemoryMixin, ControlFlowMixin):
     pass
 
-def create_mul128x128():
+def create_mul128x128(rename=False):
     """Create highly optimized 128×128→256 multiplication with minimal memory operations"""
     
-    f = ASMCode(label="mul128x128")
+    f = ASMCode(label="mul128x128", rename=rename)
     with f as asm:
         # Function signature: mul128x128(uint64_t a[2], uint64_t b[2], uint64_t result[4])
         # x0 = pointer to a[2] (128-bit input A)
@@ -87,10 +87,10 @@ def create_mul128x128():
     
     return f
 
-def create_mul256x256():
+def create_mul256x256(rename=False):
     """Create optimized 256×256→512 multiplication with reduced memory operations"""
     
-    f = ASMCode(label="mul256x256")
+    f = ASMCode(label="mul256x256", rename=rename)
     with f as asm:
         # Function signature: mul256x256(uint64_t a[4], uint64_t b[4], uint64_t result[8])
         # x0 = pointer to a[4] (256-bit input A)
@@ -189,10 +189,10 @@ def create_mul256x256():
     
     return f
 
-def create_mul512x512():
+def create_mul512x512(rename=False):
     """Create complete 512×512→1024 multiplication function using callee-saved registers"""
     
-    f = ASMCode(label="mul512x512")
+    f = ASMCode(label="mul512x512", rename=rename)
     with f as asm:
         # Function signature: mul512x512(uint64_t a[8], uint64_t b[8], uint64_t result[16])
         # x0 = pointer to a[8] (512-bit input A)
@@ -452,45 +452,218 @@ def create_mul512x512():
     
     return f
 
+# Product-scanning (Comba) registers shared by every size
+COMBA_ACC = [x_reg(11), x_reg(12), x_reg(13), x_reg(0)]           # x0 is free once a is loaded
+COMBA_PRODS = [(x_reg(14), x_reg(15)), (x_reg(16), x_reg(17))]    # two MUL/UMULH pairs in flight
+COMBA_SIZES = (128, 256, 512)
+
+def comba_limbs(bits, kind):
+    n = bits // 64
+    if bits % 64 or not 2 <= n <= 8:
+        raise ValueError(f"Comba {kind} supports 128 to 512 bits in whole limbs, not {bits}")
+    return n
+
+def emit_comba(m, n, a, b, ptr_result, post_index=False):
+    """
+    result[0, 2n) = a · b, or a² when b is None, column by column.
+
+    Column k sums the products a[i]·b[k-i] into a three-limb accumulator
+    (c0, c1, c2) with ADDS/ADCS/ADC; c0 is then limb k, stored exactly once.
+    All terms form one stream across columns, and the MUL/UMULH of the next
+    term issue before the additions of the current one.
+
+    For a square, a[i]·a[j] and a[j]·a[i] are the same product: each
+    off-diagonal product is computed once and added twice, and the diagonal
+    squares a[i]² once, so n(n+1)/2 products replace n².
+
+    The STP pairs go out in address order; with post_index each one
+    advances ptr_result by 16, leaving it just past the result.
+    """
+    stream = []     # (column, index in column, i, j, weight, last in column)
+    for k in range(2 * n - 1):
+        terms = [(i, k - i) for i in range(max(0, k - n + 1), min(k, n - 1) + 1)]
+        if b is None:
+            terms = [(i, j) for i, j in terms if i <= j]
+        stream += [(k, idx, i, j, 2 if b is None and i != j else 1, idx == len(terms) - 1)
+                   for idx, (i, j) in enumerate(terms)]
+    rhs = a if b is None else b
+
+    def store(lo, hi, limb):
+        if post_index:
+            m.STP_post(lo, hi, ptr_result, 16)
+        elif limb == 0:
+            m.STP(lo, hi, ptr_result)
+        else:
+            m.STP_offset(lo, hi, ptr_result, 8 * limb)
+
+    def issue(t):
+        k, _, i, j, _, _ = stream[t]
+        # The first product is the accumulator itself (column 0 holds a single term of weight 1)
+        lo, hi = (COMBA_ACC[0], COMBA_ACC[1]) if k == 0 else COMBA_PRODS[t % 2]
+        m.MUL(lo, a[i], rhs[j])
+        m.UMULH(hi, a[i], rhs[j])
+
+    # Four accumulator registers rotate so limbs k-1 and k are both intact for one STP after odd k
+    issue(0)
+    for t, (k, idx, i, j, weight, last) in enumerate(stream):
+        if t + 1 < len(stream):
+            issue(t + 1)
+        if k > 0:
+            c0, c1, c2 = COMBA_ACC[k % 4], COMBA_ACC[(k + 1) % 4], COMBA_ACC[(k + 2) % 4]
+            lo, hi = COMBA_PRODS[t % 2]
+            for w in range(weight):
+                fresh = idx == 0 and w == 0
+                m.ADDS(c0, c0, lo)
+                # c1 has not been written yet in column 1; c2 starts from the first carry
+                m.ADCS(c1, "xzr" if k == 1 and fresh else c1, hi)
+                if k < 2 * n - 2:   # the top column cannot carry out
+                    m.ADC(c2, "xzr" if fresh else c2, "xzr")
+        if last and k % 2:
+            store(COMBA_ACC[(k - 1) % 4], COMBA_ACC[k % 4], k - 1)
+    top = 2 * n - 2
+    store(COMBA_ACC[top % 4], COMBA_ACC[(top + 1) % 4], top)
+
+def comba_operands(n, squaring):
+    """Operand registers: up to four limbs of each operand fit in caller-saved registers; beyond that a lives in x19-x26."""
+    if n > 4:
+        return [x_reg(19 + i) for i in range(n)], None if squaring else [x_reg(3 + i) for i in range(n)]
+    return [x_reg(3 + i) for i in range(n)], None if squaring else [x_reg(7 + i) for i in range(n)]
+
+def load_operand(m, regs, ptr):
+    m.LDP(regs[0], regs[1], ptr)
+    for i in range(2, len(regs), 2):
+        m.LDP_offset(regs[i], regs[i + 1], ptr, 8 * i)
+
+def create_mul_comba(bits, rename=False):
+    """
+    Create bits×bits→2·bits multiplication by product scanning (Comba).
+
+    Carries stay in the column accumulator instead of going through memory,
+    and each result limb is stored once, in STP pairs (see emit_comba).
+    """
+    n = comba_limbs(bits, "multiplication")
+
+    f = ASMCode(label=f"mul{bits}x{bits}_comba", rename=rename)
+    with f as asm:
+        # Function signature: mul{bits}x{bits}_comba(uint64_t a[n], uint64_t b[n], uint64_t result[2n])
+        with Block() as m:   # no label: several of these share one .s file
+            ptr_a, ptr_b, ptr_result = x_reg(0), x_reg(1), x_reg(2)
+            a, b = comba_operands(n, squaring=False)
+            if n > 4:
+                for i in range(0, n, 2):
+                    m.STP_pre(x_reg(19 + i), x_reg(20 + i), "sp", -16)
+
+            load_operand(m, a, ptr_a)
+            load_operand(m, b, ptr_b)
+            emit_comba(m, n, a, b, ptr_result)
+
+            if n > 4:
+                for i in range(n - 2, -1, -2):
+                    m.LDP_post(x_reg(19 + i), x_reg(20 + i), "sp", 16)
+
+    return f
+
+def create_sqr(bits, rename=False):
+    """
+    Create bits→2·bits squaring by product scanning.
+
+    Each off-diagonal product a[i]·a[j], i < j, is computed once and doubled
+    by adding it twice into its column; the diagonal squares are added once.
+    That takes n(n+1)/2 multiplications instead of n² (see emit_comba).
+    """
+    n = comba_limbs(bits, "squaring")
+
+    f = ASMCode(label=f"sqr{bits}", rename=rename)
+    with f as asm:
+        # Function signature: sqr{bits}(uint64_t a[n], uint64_t result[2n])
+        with Block() as m:   # no label: several of these share one .s file
+            ptr_a, ptr_result = x_reg(0), x_reg(1)
+            a, _ = comba_operands(n, squaring=True)
+            if n > 4:
+                for i in range(0, n, 2):
+                    m.STP_pre(x_reg(19 + i), x_reg(20 + i), "sp", -16)
+
+            load_operand(m, a, ptr_a)
+            emit_comba(m, n, a, None, ptr_result)
+
+            if n > 4:
+                for i in range(n - 2, -1, -2):
+                    m.LDP_post(x_reg(19 + i), x_reg(20 + i), "sp", 16)
+
+    return f
+
+def export(create, path):
+    """Generate one function into its own file, temporaries renamed to break false dependencies"""
+    out = BackgroundCode()
+    with out:
+        fn = create(rename=True)
+    out.export_to_file(path)
+    print(f"✓ {fn.rename_report}")
+    return fn
+
 def main():
     """Generate all multiplication functions and export to assembly files"""
     print("=== Combined Multiplication Generator ===")
     print("Generating 128×128→256, 256×256→512, and 512×512→1024 multiplication functions")
+    print("in operand-scanning and product-scanning (Comba) form")
     
     # Generate 128-bit multiplication
     print("\n--- 128×128→256 Multiplication ---")
-    asm_code_128 = create_mul128x128()
     output_file_128 = "mul128x128_fixed.s"
-    asm_code_128.export_to_file(output_file_128)
+    export(create_mul128x128, output_file_128)
     print(f"✓ 128-bit assembly exported to: {output_file_128}")
     print("✓ Uses optimized 4-partial product algorithm")
     print("✓ Uses only caller-saved registers (x0-x17)")
     
     # Generate 256-bit multiplication  
     print("\n--- 256×256→512 Multiplication ---")
-    asm_code_256 = create_mul256x256()
     output_file_256 = "mul256x256_fixed.s"
-    asm_code_256.export_to_file(output_file_256)
+    export(create_mul256x256, output_file_256)
     print(f"✓ 256-bit assembly exported to: {output_file_256}")
     print("✓ Uses schoolbook multiplication algorithm")
     print("✓ Uses only caller-saved registers (x0-x18)")
     
     # Generate 512-bit multiplication
     print("\n--- 512×512→1024 Multiplication ---")
-    asm_code_512 = create_mul512x512()
     output_file_512 = "mul512x512_fixed.s"
-    asm_code_512.export_to_file(output_file_512)
+    export(create_mul512x512, output_file_512)
     print(f"✓ 512-bit assembly exported to: {output_file_512}")
     print("✓ Uses schoolbook multiplication algorithm")
     print("✓ Uses callee-saved registers (x19-x28) with proper stack management")
     print("✓ Complete implementation with all 64 partial products")
     print("✓ Production-ready with comprehensive schoolbook multiplication")
     
+    # Product-scanning versions of the same sizes, for comparison with operand scanning
+    print("\n--- Comba (product scanning) Multiplication ---")
+    output_file_comba = "mul_comba.s"
+    out = BackgroundCode()
+    with out:
+        fns = [create_mul_comba(bits, rename=True) for bits in COMBA_SIZES]
+    out.export_to_file(output_file_comba)
+    for bits, fn in zip(COMBA_SIZES, fns):
+        print(f"✓ mul{bits}x{bits}_comba {fn.rename_report}")
+    print(f"✓ Comba assembly exported to: {output_file_comba}")
+    print("✓ Three-limb column accumulator, every result limb stored once")
+    
+    # Squarings: each off-diagonal product computed once and doubled
+    print("\n--- Squaring ---")
+    output_file_sqr = "sqr.s"
+    out = BackgroundCode()
+    with out:
+        fns = [create_sqr(bits, rename=True) for bits in COMBA_SIZES]
+    out.export_to_file(output_file_sqr)
+    for bits, fn in zip(COMBA_SIZES, fns):
+        n = bits // 64
+        print(f"✓ sqr{bits} {fn.rename_report}; {n * (n + 1) // 2} products instead of {n * n}")
+    print(f"✓ Squaring assembly exported to: {output_file_sqr}")
+    
     print(f"\n=== Generation Complete ===")
     print(f"Generated files:")
     print(f"  - {output_file_128} (128×128→256 multiplication)")
     print(f"  - {output_file_256} (256×256→512 multiplication)")
     print(f"  - {output_file_512} (512×512→1024 multiplication - complete implementation)")
+    print(f"  - {output_file_comba} (128/256/512-bit product-scanning multiplication)")
+    print(f"  - {output_file_sqr} (128/256/512-bit squaring)")
     
     print("\n=== All Implementations Complete ===")
     print("🎉 Ready for production use with comprehensive test coverage!")
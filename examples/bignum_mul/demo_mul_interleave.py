@@ -0,0 +1,158 @@
+#!/usr/bin/env python3
+"""
+Interleaved multiplication generator: k independent n-limb products in one function.
+
+    void mul256x256_x2(const uint64_t *a0, const uint64_t *b0, uint64_t *r0,
+                       const uint64_t *a1, const uint64_t *b1, uint64_t *r1)
+
+    r_c[0, 2n) = a_c[0, n) · b_c[0, n)   for c = 0 .. k-1
+
+One product scans its columns through a three-register accumulator, each
+term an ADDS/ADCS/ADC chain that waits on the one before; a wide core
+spends most of the product waiting on that chain. Here every product is
+emitted as its own stream on its own registers, and passes/interleave.py
+merges the streams term by term, so k chains run side by side.
+
+Register budget: the 3k pointers stay live to the end, and each product
+in flight needs an accumulator (3), a MUL/UMULH pair (2), and either
+a[0, n) plus one limb of b or one limb of each operand. The products
+that run together (a group) are the whole k when that fits in x0-x17 and
+x19-x28, with a in registers when possible; otherwise the group halves,
+down to one product at a time.
+
+The AAPCS64 passes eight arguments in registers; for k = 4 the last four
+pointers arrive on the stack and are loaded into x8-x11 on entry.
+
+Usage:
+    python3 demo_mul_interleave.py
+"""
+
+from armasmgen.builder import ASMCode, BackgroundCode, record
+from armasmgen.passes.interleave import interleave
+from armasmgen.register import x_reg
+
+from demo_montmul import _callee_saved
+
+POOL = [x_reg(i) for i in range(18)] + [x_reg(i) for i in range(19, 29)]
+
+SIZES = (128, 256, 384, 512)
+WAYS = (1, 2, 4)
+
+# Accumulator (3) and product pair (2) of one product in flight
+WORK = 5
+
+
+def plan(n: int, k: int):
+    """(group, a_in_registers): how many of the k products run together, and how each holds a."""
+    group = k
+    while True:
+        for a_in_registers in (True, False):
+            per_product = WORK + (n + 1 if a_in_registers else 2)
+            if 3 * k + group * per_product <= len(POOL):
+                return group, a_in_registers
+        group //= 2
+
+
+def emit_product(m, n: int, ptrs, regs, a_in_registers: bool):
+    """Column-wise product of one pair; every term is MUL/UMULH and one ADDS/ADCS/ADC chain."""
+    a_ptr, b_ptr, r_ptr = ptrs
+    acc, (lo, hi), rest = regs[:3], regs[3:5], regs[5:]
+    if a_in_registers:
+        a, tb = rest[:n], rest[n]
+        for i in range(0, n - 1, 2):
+            if i:
+                m.LDP_offset(a[i], a[i + 1], a_ptr, 8 * i)
+            else:
+                m.LDP(a[i], a[i + 1], a_ptr)
+        if n % 2:
+            m.LDR_offset(a[n - 1], a_ptr, 8 * (n - 1))
+    else:
+        a, (ta, tb) = None, rest[:2]
+
+    def load(reg, ptr, limb):
+        if limb:
+            m.LDR_offset(reg, ptr, 8 * limb)
+        else:
+            m.LDR(reg, ptr)
+
+    for k in range(2 * n - 1):
+        c0, c1, c2 = acc[k % 3], acc[(k + 1) % 3], acc[(k + 2) % 3]
+        terms = [(i, k - i) for i in range(max(0, k - n + 1), min(k, n - 1) + 1)]
+        for idx, (i, j) in enumerate(terms):
+            if a is None:
+                load(ta, a_ptr, i)
+            load(tb, b_ptr, j)
+            ai = ta if a is None else a[i]
+            if k == 0:
+                # Column 0 has one term: it is the accumulator
+                m.MUL(c0, ai, tb)
+                m.UMULH(c1, ai, tb)
+                continue
+            m.MUL(lo, ai, tb)
+            m.UMULH(hi, ai, tb)
+            fresh = idx == 0
+            m.ADDS(c0, c0, lo)
+            # c1 has not been written yet in column 1; c2 starts from the first carry
+            m.ADCS(c1, "xzr" if k == 1 and fresh else c1, hi)
+            if k < 2 * n - 2:   # the top column cannot carry out
+                m.ADC(c2, "xzr" if fresh else c2, "xzr")
+        if k < 2 * n - 2:
+            if k:
+                m.STR_offset(c0, r_ptr, 8 * k)
+            else:
+                m.STR(c0, r_ptr)
+        else:
+            m.STP_offset(c0, c1, r_ptr, 8 * k)
+
+
+def create_mul_interleaved(bits: int, k: int):
+    """mul{bits}x{bits}_x{k}(a0, b0, r0, ..., a{k-1}, b{k-1}, r{k-1}): k independent products."""
+    if bits % 64 or not 2 <= bits // 64 <= 8:
+        raise ValueError(f"interleaved multiplication supports 128 to 512 bits in whole limbs, not {bits}")
+    if k not in WAYS:
+        raise ValueError(f"interleave factor must be one of {WAYS}, not {k}")
+    n = bits // 64
+    group, a_in_registers = plan(n, k)
+    ptrs = [tuple(POOL[3 * c:3 * c + 3]) for c in range(k)]
+    per_product = WORK + (n + 1 if a_in_registers else 2)
+    work = [POOL[3 * k + g * per_product:3 * k + (g + 1) * per_product] for g in range(group)]
+    saved = _callee_saved([r for regs in work for r in regs])
+
+    with ASMCode(label=f"mul{bits}x{bits}_x{k}") as f:
+        if k > 2:
+            f.comment("arguments 9-12 are on the stack")
+            f.LDP(x_reg(8), x_reg(9), "sp")
+            f.LDP_offset(x_reg(10), x_reg(11), "sp", 16)
+        for r0, r1 in saved:
+            f.STP_pre(r0, r1, "sp", -16)
+        f.comment(f"{group} of {k} products at a time, a {'in registers' if a_in_registers else 'loaded per term'}")
+        for first in range(0, k, group):
+            streams = [record(lambda s, c=c: emit_product(s, n, ptrs[c], work[c - first], a_in_registers))
+                       for c in range(first, first + group)]
+            for inst in interleave(streams):
+                f.emit(inst)
+        for r0, r1 in reversed(saved):
+            f.LDP_post(r0, r1, "sp", 16)
+    return f
+
+
+def main():
+    print("=== Interleaved Multiplication Generator ===")
+    out = BackgroundCode()
+    with out:
+        for bits in SIZES:
+            for k in WAYS:
+                create_mul_interleaved(bits, k)
+    out.export_to_file("mul_interleave.s")
+    for bits in SIZES:
+        for k in WAYS[1:]:
+            group, a_in_registers = plan(bits // 64, k)
+            print(f"✓ mul{bits}x{bits}_x{k}: {group} products interleaved, "
+                  f"a {'in registers' if a_in_registers else 'loaded per term'}")
+    print("✓ mulNxN_x1: one product at a time, the baseline")
+    print("✓ Assembly exported to: mul_interleave.s")
+    print("Run 'make run-interleave' to check against GMP and time k products interleaved vs one at a time.")
+
+
+if __name__ == "__main__":
+    main()
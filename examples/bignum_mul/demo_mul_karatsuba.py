@@ -0,0 +1,331 @@
+#!/usr/bin/env python3
+"""
+Karatsuba multiplication generator for 512-bit and larger operands.
+
+    void mulNxN_karatsuba(const uint64_t a[n], const uint64_t b[n], uint64_t r[2n])
+
+Each level splits a = a1·B^h + a0, b = b1·B^h + b0 (B = 2^64, h = ceil(n/2))
+and forms three half-size products instead of four:
+
+    z0 = a0·b0                  written to r[0, 2h)
+    z2 = a1·b1                  written to r[2h, 2n)
+    t  = |a0 - a1| · |b0 - b1|  written to stack scratch
+    r += (z0 + z2 ∓ t) · B^h    t subtracted when a0 - a1 and b0 - b1 have equal signs
+
+The differences are taken with SUBS/SBCS, their borrows turned into masks
+with CSETM and the absolute values formed as (d ^ m) - m, so no step
+branches on the data. The middle term adds (t ^ s) with carry-in s & 1,
+which is z0 + z2 - t when s is all ones and z0 + z2 + t otherwise.
+Odd sizes split unevenly, so any n works; the Toom-3 generator relies on
+this for its (k+1)-limb pointwise products.
+
+Recursion stops at `threshold` limbs or after `depth` levels. The base
+case is a product-scanning (column-wise) schoolbook multiply with both
+operands and a 4-register rotating accumulator in registers, so it
+accepts at most 8 limbs.
+
+Registers: x0-x2 hold a, b and r throughout; x19-x28 are saved on entry;
+the scratch area below them is addressed from sp.
+
+Usage:
+    python demo_mul_karatsuba.py [threshold [depth]]
+"""
+
+import sys
+
+from armasmgen import BackgroundCode, ASMCode, x_reg
+
+A_PTR, B_PTR, R_PTR = x_reg(0), x_reg(1), x_reg(2)
+
+# Base case: operands, accumulator and product registers
+OPS_A = [x_reg(i) for i in range(19, 27)]
+OPS_B = [x_reg(i) for i in range(3, 11)]
+ACC = [x_reg(11), x_reg(12), x_reg(13), x_reg(28)]
+LO, HI = x_reg(14), x_reg(15)
+
+# Linear passes: data, masks and walking pointers
+T0, T1, T2, T3 = x_reg(3), x_reg(4), x_reg(5), x_reg(6)
+MASK, SIGN = x_reg(11), x_reg(12)
+P0, P1, P2 = x_reg(16), x_reg(17), x_reg(27)
+
+MAX_BASECASE = len(OPS_A)
+SIZES = (512, 1024, 2048, 4096)
+
+
+# ═══════════════════════════════════════════════════════════════
+# Recursion plan: n limbs split into a low half of ceil(n/2) limbs
+# and a high half of floor(n/2) limbs
+# ═══════════════════════════════════════════════════════════════
+
+def split(n: int, threshold: int, depth) -> bool:
+    """Whether an n-limb product is split into three half-size products."""
+    return n > threshold and (depth is None or depth > 0)
+
+
+def _next(depth):
+    return None if depth is None else depth - 1
+
+
+def base_limbs(n: int, threshold: int, depth=None) -> int:
+    """Largest base case an n-limb product reaches."""
+    while split(n, threshold, depth):
+        n, depth = (n + 1) // 2, _next(depth)
+    return n
+
+
+def products(n: int, threshold: int, depth=None) -> int:
+    """MUL/UMULH pairs executed for one n-limb product."""
+    if not split(n, threshold, depth):
+        return n * n
+    h, deeper = (n + 1) // 2, _next(depth)
+    return 2 * products(h, threshold, deeper) + products(n // 2, threshold, deeper)
+
+
+def scratch_limbs(n: int, threshold: int, depth=None) -> int:
+    """|a0-a1|, |b0-b1|, t (n+1 limbs) and the sign word, plus the deepest level below."""
+    if not split(n, threshold, depth):
+        return 0
+    h = (n + 1) // 2
+    return 4 * h + 2 + scratch_limbs(h, threshold, _next(depth))
+
+
+# ═══════════════════════════════════════════════════════════════
+# Emission helpers; an operand is (base register, byte offset)
+# ═══════════════════════════════════════════════════════════════
+
+def pointer(m, operand, reg):
+    """Copy of the operand's address that a pass may advance."""
+    base, offset = operand
+    while True:
+        step = min(offset, 4095)
+        m.ADD_imm(reg, base, step)
+        base, offset = reg, offset - step
+        if not offset:
+            return reg
+
+
+def address(m, operand, reg):
+    """Register holding the operand's address (the base itself at offset 0)."""
+    return operand[0] if operand[1] == 0 else pointer(m, operand, reg)
+
+
+def at(operand, limbs: int):
+    return operand[0], operand[1] + 8 * limbs
+
+
+def _ldp(m, r0, r1, base, offset):
+    if offset:
+        m.LDP_offset(r0, r1, base, offset)
+    else:
+        m.LDP(r0, r1, base)
+
+
+def _stp(m, r0, r1, base, offset):
+    if offset:
+        m.STP_offset(r0, r1, base, offset)
+    else:
+        m.STP(r0, r1, base)
+
+
+def limb_chunks(length: int, *bounds):
+    """(start, width) pieces of [0, length) in pairs where possible, never straddling a bound."""
+    i = 0
+    while i < length:
+        width = 2 if i + 1 < length and all((i < b) == (i + 1 < b) for b in bounds) else 1
+        yield i, width
+        i += width
+
+
+def limb_pass(m, op: str, dst, length: int, x, x_len: int, y=None, y_len: int = 0, *,
+              flip=None, chained: bool = False):
+    """
+    dst[0, length) = x + y or x - y (op "add" / "sub") as one carry chain.
+
+    x and y are zero-extended past x_len and y_len; y may instead be a
+    register added to every limb. With flip, every limb of x (extension
+    included) is XORed with that register first. chained continues the
+    carry already in the flags. dst may be x itself.
+    """
+    first, last = ("ADDS", "ADCS") if op == "add" else ("SUBS", "SBCS")
+    from_memory = isinstance(y, tuple)
+    px = pointer(m, x, P0) if x_len else None
+    py = pointer(m, y, P1) if from_memory and y_len else None
+    pd = pointer(m, dst, P2)
+    for i, width in limb_chunks(length, x_len, y_len if from_memory else 0):
+        xs, ys = [T0, T1][:width], [T2, T3][:width]
+        if i < x_len:
+            load_limbs(m, xs, px)
+            xv = xs
+            for reg in xs if flip else ():
+                m.EOR(reg, reg, flip)
+        else:
+            xv = [flip or "xzr"] * width
+        if from_memory and i < y_len:
+            load_limbs(m, ys, py)
+            yv = ys
+        else:
+            yv = [y if y is not None and not from_memory else "xzr"] * width
+        for j in range(width):
+            getattr(m, last if chained or i + j else first)(xs[j], xv[j], yv[j])
+        store_limbs(m, xs, pd)
+
+
+def load_limbs(m, regs, ptr):
+    if len(regs) == 2:
+        m.LDP_post(regs[0], regs[1], ptr, 16)
+    else:
+        m.LDR_post(regs[0], ptr, 8)
+
+
+def store_limbs(m, regs, ptr):
+    if len(regs) == 2:
+        m.STP_post(regs[0], regs[1], ptr, 16)
+    else:
+        m.STR_post(regs[0], ptr, 8)
+
+
+def abs_diff(m, d, x, x_len: int, y, y_len: int, mask):
+    """d[0, x_len) = |x - y| for y no longer than x; mask = all ones if x < y."""
+    limb_pass(m, "sub", d, x_len, x, x_len, y, y_len)
+    m.CSETM(mask, "cc")
+    # (d ^ mask) - mask: unchanged for mask = 0, negated for mask = ~0
+    limb_pass(m, "sub", d, x_len, d, x_len, mask, flip=mask)
+
+
+def emit_basecase(m, n: int, a, b, r):
+    """r[0, 2n) = a[0, n) · b[0, n), column by column with a rotating accumulator."""
+    if not 1 <= n <= MAX_BASECASE:
+        raise ValueError(f"base case of {n} limbs does not fit in registers (at most {MAX_BASECASE})")
+    for regs, operand in ((OPS_A, a), (OPS_B, b)):
+        base = address(m, operand, P0)
+        for i in range(0, n - 1, 2):
+            _ldp(m, regs[i], regs[i + 1], base, 8 * i)
+        if n == 1:
+            m.LDR(regs[0], base)
+        elif n % 2:
+            m.LDR_offset(regs[n - 1], base, 8 * (n - 1))
+    out = address(m, r, P1)
+
+    # Column k sums a[i]·b[k-i] into (c0, c1, c2); c0 is then limb k of the result.
+    # Four registers rotate so limbs k-1 and k are still intact for one STP after odd k.
+    for k in range(2 * n - 1):
+        c0, c1, c2 = ACC[k % 4], ACC[(k + 1) % 4], ACC[(k + 2) % 4]
+        terms = [(i, k - i) for i in range(max(0, k - n + 1), min(k, n - 1) + 1)]
+        for idx, (i, j) in enumerate(terms):
+            if k == 0:
+                m.MUL(c0, OPS_A[0], OPS_B[0])
+                m.UMULH(c1, OPS_A[0], OPS_B[0])
+                continue
+            m.MUL(LO, OPS_A[i], OPS_B[j])
+            m.UMULH(HI, OPS_A[i], OPS_B[j])
+            m.ADDS(c0, c0, LO)
+            # c1 has not been written yet in column 1; c2 starts from the first carry
+            m.ADCS(c1, "xzr" if k == 1 and idx == 0 else c1, HI)
+            if k < 2 * n - 2:   # the top column cannot carry out
+                m.ADC(c2, "xzr" if idx == 0 else c2, "xzr")
+        if k % 2:
+            _stp(m, ACC[(k - 1) % 4], c0, out, 8 * (k - 1))
+    last = 2 * n - 2
+    _stp(m, ACC[last % 4], ACC[(last + 1) % 4], out, 8 * last)
+
+
+def emit_karatsuba(m, n: int, a, b, r, scratch: int, threshold: int, depth=None):
+    """r[0, 2n) = a[0, n) · b[0, n); stack scratch from sp + scratch upwards."""
+    if not split(n, threshold, depth):
+        emit_basecase(m, n, a, b, r)
+        return
+    h, l = (n + 1) // 2, n // 2
+    da, db, t = ("sp", scratch), ("sp", scratch + 8 * h), ("sp", scratch + 16 * h)
+    sign = ("sp", scratch + 8 * (4 * h + 1))
+    below, deeper = scratch + 8 * (4 * h + 2), _next(depth)
+
+    m.comment(f"{n}-limb Karatsuba: z0 = a0*b0")
+    emit_karatsuba(m, h, a, b, r, below, threshold, deeper)
+    m.comment(f"{n}-limb Karatsuba: z2 = a1*b1")
+    emit_karatsuba(m, l, at(a, h), at(b, h), at(r, 2 * h), below, threshold, deeper)
+
+    m.comment(f"{n}-limb Karatsuba: t = |a0-a1|*|b0-b1|")
+    abs_diff(m, da, a, h, at(a, h), l, MASK)
+    m.MOV(SIGN, MASK)
+    abs_diff(m, db, b, h, at(b, h), l, MASK)
+    # All ones when (a0-a1)(b0-b1) >= 0, i.e. when t is to be subtracted
+    m.EON(SIGN, SIGN, MASK)
+    m.STR(SIGN, address(m, sign, P0))
+    emit_karatsuba(m, h, da, db, t, below, threshold, deeper)
+
+    m.comment(f"{n}-limb Karatsuba: r += (z0 + z2 -+ t) << {64 * h}")
+    m.LDR(SIGN, address(m, sign, P0))
+    m.CMN(SIGN, SIGN)
+    # t = (t ^ s) + (s & 1) + z0 = z0 -+ t, sign-extended into t[2h]
+    limb_pass(m, "add", t, 2 * h + 1, t, 2 * h, r, 2 * h, flip=SIGN, chained=True)
+    # The middle term a0·b1 + a1·b0 is non-negative and fits 2h + 1 limbs
+    limb_pass(m, "add", t, 2 * h + 1, t, 2 * h + 1, at(r, 2 * h), 2 * l)
+    # Add it at limb h and carry to the top; limbs of t past r's end are zero
+    span = h + 2 * l
+    limb_pass(m, "add", at(r, h), span, at(r, h), span, t, min(2 * h + 1, span))
+
+
+def enter_frame(m, frame: int):
+    """Save x19-x28 and reserve frame bytes of scratch below them."""
+    saved = [x_reg(i) for i in range(19, 29)]
+    for lo in range(0, len(saved), 2):
+        m.STP_pre(saved[lo], saved[lo + 1], "sp", -16)
+    _adjust_sp(m, frame, release=False)
+
+
+def leave_frame(m, frame: int):
+    _adjust_sp(m, frame, release=True)
+    saved = [x_reg(i) for i in range(19, 29)]
+    for lo in range(len(saved) - 2, -1, -2):
+        m.LDP_post(saved[lo], saved[lo + 1], "sp", 16)
+
+
+def _adjust_sp(m, size: int, release: bool):
+    while size:
+        step = min(size, 4080)
+        (m.ADD_imm if release else m.SUB_imm)("sp", "sp", step)
+        size -= step
+
+
+def create_mul_karatsuba(bits: int, threshold: int = 4, depth=None):
+    """mul{bits}x{bits}_karatsuba(a, b, r): r[0, 2n) = a[0, n) · b[0, n), n = bits / 64."""
+    if bits % 64:
+        raise ValueError("operand size must be a multiple of 64 bits")
+    if threshold < 1:
+        raise ValueError("threshold must be at least one limb")
+    n = bits // 64
+    base_limbs_n = base_limbs(n, threshold, depth)
+    if base_limbs_n > MAX_BASECASE:
+        raise ValueError(f"{bits}-bit product bottoms out in a {base_limbs_n}-limb base case; "
+                         f"at most {MAX_BASECASE} limbs fit in registers (lower threshold or raise depth)")
+    frame = (8 * scratch_limbs(n, threshold, depth) + 15) & ~15
+
+    with ASMCode(label=f"mul{bits}x{bits}_karatsuba") as f:
+        enter_frame(f, frame)
+        emit_karatsuba(f, n, (A_PTR, 0), (B_PTR, 0), (R_PTR, 0), 0, threshold, depth)
+        leave_frame(f, frame)
+    return f
+
+
+def main():
+    threshold = int(sys.argv[1]) if len(sys.argv) > 1 else 4
+    depth = int(sys.argv[2]) if len(sys.argv) > 2 else None
+
+    print("=== Karatsuba Multiplication Generator ===")
+    out = BackgroundCode()
+    with out:
+        for bits in SIZES:
+            n = bits // 64
+            create_mul_karatsuba(bits, threshold, depth)
+            count = products(n, threshold, depth)
+            print(f"  mul{bits}x{bits}_karatsuba: {base_limbs(n, threshold, depth)}-limb base case, "
+                  f"{count} products vs {n * n} schoolbook ({100 * (n * n - count) // (n * n)}% fewer), "
+                  f"{8 * scratch_limbs(n, threshold, depth)} bytes of scratch")
+
+    out.export_to_file("mul_karatsuba.s")
+    print("✓ Exported to mul_karatsuba.s")
+    print("Run 'make run-karatsuba' to verify against GMP.")
+
+
+if __name__ == "__main__":
+    main()
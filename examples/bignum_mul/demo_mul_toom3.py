@@ -0,0 +1,338 @@
+#!/usr/bin/env python3
+"""
+Toom-Cook-3 multiplication generator for 1536- to 8192-bit operands.
+
+    void mulNxN_toom3(const uint64_t a[n], const uint64_t b[n], uint64_t r[2n])
+
+The operands are split into three pieces of k = ceil(n/3) limbs (the top
+piece gets the remaining n - 2k), a(x) = a0 + a1·x + a2·x², and the
+product polynomial is recovered from five pointwise products:
+
+    v0   = a(0)·b(0)       = a0·b0                 written to r[0, 2k)
+    vinf = a(∞)·b(∞)       = a2·b2                 written to r[4k, 2n)
+    v1   = a(1)·b(1)       (a0 + a1 + a2)·(...)    k+1 limbs each side
+    vm1  = a(-1)·b(-1)     |a0 - a1 + a2|·|...|    sign kept as a mask
+    v2   = a(2)·b(2)       (a0 + 2a1 + 4a2)·(...)
+
+The pointwise products use the Karatsuba kernel of demo_mul_karatsuba.py
+(and its schoolbook base case below `threshold` limbs). Interpolation
+follows Bodrato's sequence, in which every intermediate is non-negative:
+
+    v2  = (v2 - vm1) / 3        exact: multiply by 3^-1 mod 2^64 = 0xAAAAAAAAAAAAAAAB
+    vm1 = (v1 - vm1) / 2        c1 + c3
+    v1  = v1 - v0               c1 + c2 + c3 + c4
+    v2  = (v2 - v1) / 2         c3 + 2·c4
+    v1  = v1 - vm1 - vinf       c2
+    v2  = v2 - 2·vinf           c3
+    vm1 = vm1 - v2              c1
+
+after which r = v0 + c1·B^k + c2·B^2k + c3·B^3k + vinf·B^4k. Everything is
+straight-line: the sign of vm1 enters v2 - vm1 and v1 - vm1 through the
+(t ^ s) + (s & 1) trick rather than a branch.
+
+Besides mul_toom3.s the script writes bench_mul_toom3.c, a driver that
+checks each size against GMP's mpn_mul_n and times both.
+
+Usage:
+    python demo_mul_toom3.py [threshold [depth]]
+"""
+
+import sys
+
+from armasmgen import BackgroundCode, ASMCode, x_reg
+from demo_mul_karatsuba import (
+    A_PTR, B_PTR, R_PTR, T0, T1, T2, T3, MASK, SIGN, P0, P2, MAX_BASECASE,
+    emit_karatsuba, limb_pass, abs_diff, pointer, address, at,
+    enter_frame, leave_frame, base_limbs, products, scratch_limbs, limb_chunks, load_limbs, store_limbs,
+)
+
+SIZES = (1536, 2048, 3072, 4096, 6144, 8192)
+
+# Exact division by 3 and shifts
+INV3, THREE, CARRY, HI = x_reg(7), x_reg(8), x_reg(9), x_reg(10)
+Q0, Q1 = x_reg(7), x_reg(8)
+
+
+def pieces(n: int):
+    """(k, k2): size of the two low pieces and of the top piece."""
+    k = (n + 2) // 3
+    if n - 2 * k < 1:
+        raise ValueError(f"{n} limbs are too few to split in three")
+    return k, n - 2 * k
+
+
+def toom3_products(n: int, threshold: int, depth=None) -> int:
+    k, k2 = pieces(n)
+    return (products(k, threshold, depth) + products(k2, threshold, depth)
+            + 3 * products(k + 1, threshold, depth))
+
+
+def toom3_scratch_limbs(n: int, threshold: int, depth=None) -> int:
+    """Six evaluated operands, three products of 2k+2 limbs, the sign word and the kernels' scratch."""
+    k, k2 = pieces(n)
+    below = max(scratch_limbs(size, threshold, depth) for size in (k, k2, k + 1))
+    return 6 * (k + 1) + 3 * (2 * k + 2) + 1 + below
+
+
+def divexact_by3(m, operand, length: int):
+    """operand[0, length) /= 3, exact; q = (u - c)·3^-1 and c = hi(q·3) + borrow, low limb first."""
+    m.MOVZ(INV3, 0xAAAB)
+    for shift in (16, 32, 48):
+        m.MOVK(INV3, 0xAAAA, shift)
+    m.MOVZ(THREE, 3)
+    m.MOV(CARRY, "xzr")
+    src, dst = pointer(m, operand, P0), pointer(m, operand, P2)
+    for _, width in limb_chunks(length):
+        regs = [T0, T1][:width]
+        load_limbs(m, regs, src)
+        for reg in regs:
+            m.SUBS(reg, reg, CARRY)
+            m.MUL(reg, reg, INV3)
+            m.UMULH(HI, reg, THREE)
+            m.CINC(CARRY, HI, "cc")
+        store_limbs(m, regs, dst)
+
+
+def shift_right_1(m, operand, length: int):
+    """operand[0, length) >>= 1, exact (the value is even)."""
+    src, dst = pointer(m, operand, P0), pointer(m, operand, P2)
+    prev = T3
+    m.LDR_post(prev, src, 8)
+    for idx, (_, width) in enumerate(limb_chunks(length - 1)):
+        regs = [(T0, T1), (T2, T3)][idx % 2][:width]
+        load_limbs(m, regs, src)
+        outs = [Q0, Q1][:width]
+        for out, lo, hi in zip(outs, [prev] + list(regs), regs):
+            m.EXTR(out, hi, lo, 1)
+        store_limbs(m, outs, dst)
+        prev = regs[-1]
+    m.LSR(Q0, prev, 1)
+    m.STR_post(Q0, dst, 8)
+
+
+def emit_toom3(m, n: int, a, b, r, scratch: int, threshold: int, depth=None):
+    """r[0, 2n) = a[0, n) · b[0, n); stack scratch from sp + scratch upwards."""
+    k, k2 = pieces(n)
+    k1, wide = k + 1, 2 * k + 2
+    ea1, eb1, eam, ebm, ea2, eb2 = (("sp", scratch + 8 * k1 * i) for i in range(6))
+    v1, vm1, v2 = (("sp", scratch + 8 * (6 * k1 + i * wide)) for i in range(3))
+    sign = ("sp", scratch + 8 * (6 * k1 + 3 * wide))
+    below = sign[1] + 8
+
+    m.comment(f"{n}-limb Toom-3: evaluate at 1, -1 and 2 ({k}+{k}+{k2} limbs)")
+    for x, e1, em, e2 in ((a, ea1, eam, ea2), (b, eb1, ebm, eb2)):
+        x0, x1, x2 = x, at(x, k), at(x, 2 * k)
+        limb_pass(m, "add", e1, k1, x0, k, x2, k2)           # x0 + x2
+        abs_diff(m, em, e1, k1, x1, k, MASK)                 # |x0 - x1 + x2|
+        if x is a:
+            m.MOV(SIGN, MASK)
+        else:
+            # All ones when vm1 = x(-1)·y(-1) is non-negative
+            m.EON(SIGN, SIGN, MASK)
+        limb_pass(m, "add", e1, k1, e1, k1, x1, k)           # x0 + x1 + x2
+        limb_pass(m, "add", e2, k1, e1, k1, x2, k2)          # 2·(x(1) + x2) - x0 = x0 + 2x1 + 4x2
+        limb_pass(m, "add", e2, k1, e2, k1, e2, k1)
+        limb_pass(m, "sub", e2, k1, e2, k1, x0, k)
+    m.STR(SIGN, address(m, sign, P0))
+
+    m.comment(f"{n}-limb Toom-3: pointwise products")
+    emit_karatsuba(m, k, a, b, r, below, threshold, depth)
+    emit_karatsuba(m, k2, at(a, 2 * k), at(b, 2 * k), at(r, 4 * k), below, threshold, depth)
+    emit_karatsuba(m, k1, ea1, eb1, v1, below, threshold, depth)
+    emit_karatsuba(m, k1, eam, ebm, vm1, below, threshold, depth)
+    emit_karatsuba(m, k1, ea2, eb2, v2, below, threshold, depth)
+
+    m.comment(f"{n}-limb Toom-3: interpolate")
+    v0, vinf = r, at(r, 4 * k)
+    m.LDR(SIGN, address(m, sign, P0))
+    m.CMN(SIGN, SIGN)
+    limb_pass(m, "add", v2, wide, vm1, wide, v2, wide, flip=SIGN, chained=True)
+    divexact_by3(m, v2, wide)
+    m.LDR(SIGN, address(m, sign, P0))
+    m.CMN(SIGN, SIGN)
+    limb_pass(m, "add", vm1, wide, vm1, wide, v1, wide, flip=SIGN, chained=True)
+    shift_right_1(m, vm1, wide)
+    limb_pass(m, "sub", v1, wide, v1, wide, v0, 2 * k)
+    limb_pass(m, "sub", v2, wide, v2, wide, v1, wide)
+    shift_right_1(m, v2, wide)
+    limb_pass(m, "sub", v1, wide, v1, wide, vm1, wide)
+    limb_pass(m, "sub", v1, wide, v1, wide, vinf, 2 * k2)
+    limb_pass(m, "sub", v2, wide, v2, wide, vinf, 2 * k2)
+    limb_pass(m, "sub", v2, wide, v2, wide, vinf, 2 * k2)
+    limb_pass(m, "sub", vm1, wide, vm1, wide, v2, wide)
+
+    m.comment(f"{n}-limb Toom-3: r += c1·B^k + c2·B^2k + c3·B^3k")
+    gap = pointer(m, at(r, 2 * k), P2)
+    for _ in range(k):
+        m.STP_post("xzr", "xzr", gap, 16)
+    for i, coeff in ((1, vm1), (2, v1), (3, v2)):
+        span = 2 * n - i * k
+        limb_pass(m, "add", at(r, i * k), span, at(r, i * k), span, coeff, min(wide, span))
+
+
+def create_mul_toom3(bits: int, threshold: int = 4, depth=None):
+    """mul{bits}x{bits}_toom3(a, b, r): r[0, 2n) = a[0, n) · b[0, n), n = bits / 64."""
+    if bits % 64:
+        raise ValueError("operand size must be a multiple of 64 bits")
+    if threshold < 1:
+        raise ValueError("threshold must be at least one limb")
+    n = bits // 64
+    k, _ = pieces(n)
+    if base_limbs(k + 1, threshold, depth) > MAX_BASECASE:
+        raise ValueError(f"{bits}-bit Toom-3 bottoms out in a {base_limbs(k + 1, threshold, depth)}-limb "
+                         f"base case; at most {MAX_BASECASE} limbs fit in registers")
+    frame = (8 * toom3_scratch_limbs(n, threshold, depth) + 15) & ~15
+
+    with ASMCode(label=f"mul{bits}x{bits}_toom3") as f:
+        enter_frame(f, frame)
+        emit_toom3(f, n, (A_PTR, 0), (B_PTR, 0), (R_PTR, 0), 0, threshold, depth)
+        leave_frame(f, frame)
+    return f
+
+
+def write_driver(path: str, sizes=SIZES):
+    """C driver: GMP cross-check and timing of every generated size against mpn_mul_n."""
+    externs = "\n".join(
+        f"extern void mul{bits}x{bits}_toom3(const uint64_t *a, const uint64_t *b, uint64_t *r);"
+        for bits in sizes)
+    table = "\n".join(f'    {{ {bits}, mul{bits}x{bits}_toom3 }},' for bits in sizes)
+    max_limbs = max(sizes) // 64
+    with open(path, "w") as out:
+        out.write(f"""// Generated by demo_mul_toom3.py: Toom-3 multipliers checked and timed against GMP
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdlib.h>
+#include <time.h>
+#include <gmp.h>
+
+{externs}
+
+typedef void (*mul_fn)(const uint64_t *, const uint64_t *, uint64_t *);
+
+static const struct {{
+    int bits;
+    mul_fn mul;
+}} sizes[] = {{
+{table}
+}};
+
+#define MAX_LIMBS {max_limbs}
+#define CHECKS 500
+
+static uint64_t random_uint64(void) {{
+    return ((uint64_t)rand() << 62) ^ ((uint64_t)rand() << 31) ^ (uint64_t)rand();
+}}
+
+static double now_ns(void) {{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}}
+
+// Random operands, with every fourth pair all ones or zero-padded to reach the carry edge cases
+static void fill(uint64_t *a, uint64_t *b, int n, int t) {{
+    for (int i = 0; i < n; i++) {{
+        a[i] = random_uint64();
+        b[i] = random_uint64();
+    }}
+    if (t % 4 == 1) {{
+        memset(a, 0xFF, 8 * n);
+    }} else if (t % 4 == 2) {{
+        memset(b, 0xFF, 8 * n);
+        memset(a, 0, 8 * (n / 3));
+    }}
+}}
+
+static int check(mul_fn mul, int n) {{
+    uint64_t a[MAX_LIMBS], b[MAX_LIMBS], r[2 * MAX_LIMBS + 1];
+    mp_limb_t expected[2 * MAX_LIMBS];
+    int passed = 0;
+    for (int t = 0; t < CHECKS; t++) {{
+        fill(a, b, n, t);
+        r[2 * n] = 0x5A5A5A5A5A5A5A5AULL;
+        mul(a, b, r);
+        mpn_mul_n(expected, (const mp_limb_t *)a, (const mp_limb_t *)b, n);
+        passed += memcmp(r, expected, 16 * n) == 0 && r[2 * n] == 0x5A5A5A5A5A5A5A5AULL;
+    }}
+    return passed;
+}}
+
+static double time_ns(mul_fn mul, int n, int iterations) {{
+    uint64_t a[MAX_LIMBS], b[MAX_LIMBS], r[2 * MAX_LIMBS];
+    fill(a, b, n, 0);
+    double start = now_ns();
+    for (int i = 0; i < iterations; i++) {{
+        mul(a, b, r);
+        a[0] ^= r[n];   // keep the calls dependent
+    }}
+    return (now_ns() - start) / iterations;
+}}
+
+static void gmp_mul(const uint64_t *a, const uint64_t *b, uint64_t *r, int n) {{
+    mpn_mul_n((mp_limb_t *)r, (const mp_limb_t *)a, (const mp_limb_t *)b, n);
+}}
+
+static double time_gmp_ns(int n, int iterations) {{
+    uint64_t a[MAX_LIMBS], b[MAX_LIMBS], r[2 * MAX_LIMBS];
+    fill(a, b, n, 0);
+    double start = now_ns();
+    for (int i = 0; i < iterations; i++) {{
+        gmp_mul(a, b, r, n);
+        a[0] ^= r[n];
+    }}
+    return (now_ns() - start) / iterations;
+}}
+
+int main(void) {{
+    int failures = 0;
+    srand((unsigned int)time(NULL));
+
+    printf("Toom-3 Multiplication vs GMP mpn_mul_n\\n");
+    printf("======================================\\n");
+    printf("%6s  %10s  %12s  %12s  %7s\\n", "bits", "checks", "toom3 ns", "mpn_mul_n ns", "ratio");
+
+    for (size_t s = 0; s < sizeof sizes / sizeof sizes[0]; s++) {{
+        int n = sizes[s].bits / 64;
+        int passed = check(sizes[s].mul, n);
+        int iterations = 20000000 / (n * n) + 1000;
+        double ours = time_ns(sizes[s].mul, n, iterations);
+        double gmp = time_gmp_ns(n, iterations);
+        printf("%6d  %5d/%-4d  %12.1f  %12.1f  %6.2fx\\n",
+               sizes[s].bits, passed, CHECKS, ours, gmp, gmp / ours);
+        failures += CHECKS - passed;
+    }}
+
+    if (failures == 0) {{
+        printf("🎉 ALL TESTS PASSED! 🎉\\n");
+        return 0;
+    }}
+    printf("❌ %d PRODUCTS DIFFER FROM GMP ❌\\n", failures);
+    return 1;
+}}
+""")
+
+
+def main():
+    threshold = int(sys.argv[1]) if len(sys.argv) > 1 else 4
+    depth = int(sys.argv[2]) if len(sys.argv) > 2 else None
+
+    print("=== Toom-3 Multiplication Generator ===")
+    out = BackgroundCode()
+    with out:
+        for bits in SIZES:
+            n = bits // 64
+            create_mul_toom3(bits, threshold, depth)
+            count = toom3_products(n, threshold, depth)
+            print(f"  mul{bits}x{bits}_toom3: {count} products vs {products(n, threshold, depth)} "
+                  f"Karatsuba and {n * n} schoolbook, "
+                  f"{8 * toom3_scratch_limbs(n, threshold, depth)} bytes of scratch")
+
+    out.export_to_file("mul_toom3.s")
+    write_driver("bench_mul_toom3.c")
+    print("✓ Exported to mul_toom3.s and bench_mul_toom3.c")
+    print("Run 'make run-toom3' to check and time against GMP.")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,167 @@
+#!/usr/bin/env python3
+"""
+NEON multi-precision multiplication: k independent products in the lanes of
+the vector registers, radix 2^w with w = 32, 29 or 26.
+
+    void neon_mul256_r29_x4(const uint32_t *a, const uint32_t *b, uint32_t *r)
+
+Operands are transposed: limb i of bignum l sits at a[k·i + l], one 32-bit
+lane each, so one LDR fills limb i of all k operands. The result has 2n
+limbs in the same layout, every limb below 2^w.
+
+The multiplies are UMULL/UMLAL (2 x 32 -> 2 x 64-bit lanes); for k = 4 the
+upper two lanes go through UMULL2/UMLAL2 into a second accumulator. Column
+c of the product sums a[i]·b[c-i] in a 64-bit lane, then one carry
+normalization step splits it:
+
+    acc += carry;  carry = acc >> w;  limb = acc & (2^w - 1)
+
+w = 32 uses the whole lane for one product, so each UMLAL is followed by
+USRA/AND to move the high half into the next column's carry. With
+w = 29 or 26 the products are at most 2^58 or 2^52 and a column
+accumulates all its products lazily, one UMLAL each, normalizing once.
+The generator checks that no column can overflow its lane.
+
+This uses the SIMD units the scalar MUL/UMULH path leaves idle; it pays
+off where products come in batches of k and the radix conversion is
+amortized (make run-neon-mul times it against Comba).
+
+Usage:
+    python3 demo_neon_mul.py
+"""
+
+from armasmgen.builder import ASMCode, BackgroundCode
+from armasmgen.register import VECTOR_POOL, d_reg, x_reg
+
+from demo_mul_fixed import create_mul_comba
+
+NEON_SIZES = (128, 256)
+RADICES = (32, 29, 26)
+WAYS = (2, 4)
+
+
+
+def limbs(bits: int, w: int) -> int:
+    return -(-bits // w)
+
+
+def check_lanes(n: int, w: int):
+    """Raise if a column plus its incoming carry can exceed a 64-bit lane."""
+    if w == 32:
+        return      # normalized after every product
+    top, carry = (1 << w) - 1, 0
+    for c in range(2 * n - 1):
+        column = (min(c, 2 * n - 2 - c) + 1) * top * top + carry
+        if column >> 64:
+            raise ValueError(f"radix 2^{w} column {c} of a {n}-limb product overflows 64 bits")
+        carry = column >> w
+
+
+def emit_store(m, reg, ptr, offset, state):
+    """STR at ptr + offset, stepping ptr by 256 when the offset outgrows the immediate."""
+    while offset - state["bumped"] > 255:
+        m.ADD_imm(ptr, ptr, 256)
+        state["bumped"] += 256
+    m.STR_vector_offset(reg, ptr, offset - state["bumped"])
+
+
+def create_neon_mul(bits: int, w: int, k: int):
+    """neon_mul{bits}_r{w}_x{k}(a, b, r): k products of transposed radix-2^w operands."""
+    if w not in RADICES:
+        raise ValueError(f"radix must be 2^w for w in {RADICES}, not 2^{w}")
+    if k not in WAYS:
+        raise ValueError(f"lane count must be one of {WAYS}, not {k}")
+    n = limbs(bits, w)
+    check_lanes(n, w)
+    halves = k // 2
+    per_half = 3 if w == 32 else 2          # acc, carry (and next-column carry for w = 32)
+    need = 2 * n + halves * per_half + 2    # operands, accumulators, mask, output
+    if need > len(VECTOR_POOL):
+        raise ValueError(f"{bits}-bit radix 2^{w} x{k} needs {need} vector registers, {len(VECTOR_POOL)} exist")
+
+    pool = iter(VECTOR_POOL[:need])
+    a = [next(pool) for _ in range(n)]
+    b = [next(pool) for _ in range(n)]
+    acc = [next(pool) for _ in range(halves)]
+    carry = [next(pool) for _ in range(halves)]
+    nxt = [next(pool) for _ in range(halves)] if w == 32 else None
+    mask, out = next(pool), next(pool)
+    saved = sorted({r.number for r in VECTOR_POOL[:need]} & set(range(8, 16)))
+    saved = [(f"d{saved[i]}", f"d{saved[i] + 1}") for i in range(0, len(saved), 2)]
+
+    ptr_a, ptr_b, ptr_r = x_reg(0), x_reg(1), x_reg(2)
+    step = 4 * k                            # bytes per transposed limb
+    lane = (lambda r: r) if k == 4 else (lambda r: d_reg(r.number))
+
+    def multiply(h, first, x, y):
+        # Half 0 takes lanes 0-1 (umull), half 1 lanes 2-3 (umull2, from the 4S view)
+        narrow = (lambda r: r.s2) if h == 0 else (lambda r: r.s4)
+        (f.VUMULL if first else f.VUMLAL)(acc[h].d2, narrow(x), narrow(y))
+
+    def store(limb_regs, c):
+        f.VXTN(out.s2, limb_regs[0].d2)
+        if k == 4:
+            f.VXTN(out.s4, limb_regs[1].d2)
+        emit_store(f, lane(out), ptr_r, step * c, state)
+
+    state = {"bumped": 0}
+    with ASMCode(label=f"neon_mul{bits}_r{w}_x{k}") as f:
+        for r0, r1 in saved:
+            f.STP_pre(r0, r1, "sp", -16)
+        for i in range(n):
+            f.LDR_vector_offset(lane(a[i]), ptr_a, step * i)
+            f.LDR_vector_offset(lane(b[i]), ptr_b, step * i)
+        f.MOVZ(x_reg(3), ((1 << w) - 1) & 0xFFFF)
+        f.MOVK(x_reg(3), ((1 << w) - 1) >> 16, 16)
+        f.VDUP(mask.d2, x_reg(3))
+
+        for c in range(2 * n - 1):
+            terms = [(i, c - i) for i in range(max(0, c - n + 1), min(c, n - 1) + 1)]
+            for idx, (i, j) in enumerate(terms):
+                for h in range(halves):
+                    multiply(h, idx == 0, a[i], b[j])
+                    if w == 32:
+                        # Keep acc below 2^32 so the next UMLAL cannot wrap
+                        if idx == 0:
+                            f.VUSHR(nxt[h].d2, acc[h].d2, 32)
+                        else:
+                            f.VUSRA(nxt[h].d2, acc[h].d2, 32)
+                        f.VAND(acc[h].b16, acc[h].b16, mask.b16)
+            # Carry normalization: the column keeps w bits, the rest moves up
+            for h in range(halves):
+                if c:
+                    f.VADD(acc[h].d2, acc[h].d2, carry[h].d2)
+                if w == 32:
+                    if c:       # column 0 is already below 2^32
+                        f.VUSRA(nxt[h].d2, acc[h].d2, 32)
+                    carry[h], nxt[h] = nxt[h], carry[h]
+                else:
+                    f.VUSHR(carry[h].d2, acc[h].d2, w)
+                    f.VAND(acc[h].b16, acc[h].b16, mask.b16)
+            store(acc, c)       # XTN keeps the low 32 bits: for w = 32 that is the mask
+        store(carry, 2 * n - 1)
+
+        for r0, r1 in reversed(saved):
+            f.LDP_post(r0, r1, "sp", 16)
+    return f
+
+
+def main():
+    print("=== NEON Radix-2^w Multiplication Generator ===")
+    out = BackgroundCode()
+    with out:
+        for bits in NEON_SIZES:
+            for w in RADICES:
+                for k in WAYS:
+                    create_neon_mul(bits, w, k)
+            create_mul_comba(bits)      # scalar baseline
+    out.export_to_file("neon_mul.s")
+    for bits in NEON_SIZES:
+        print(f"✓ neon_mul{bits}_r{{32,29,26}}_x{{2,4}}: "
+              f"{', '.join(str(limbs(bits, w)) for w in RADICES)} limbs; mul{bits}x{bits}_comba as baseline")
+    print("✓ Assembly exported to: neon_mul.s")
+    print("Run 'make run-neon-mul' to check against GMP and time k lanes against k Comba calls.")
+
+
+if __name__ == "__main__":
+    main()
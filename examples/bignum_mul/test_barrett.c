@@ -0,0 +1,278 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdlib.h>
+#include <time.h>
+#include <gmp.h>
+
+// Global test counters
+int total_tests = 0;
+int passed_tests = 0;
+
+// Barrett reductions generated by demo_barrett.py: r = x mod m, mu = floor(2^(128n) / m)
+typedef void (*barrett_fn)(uint64_t *r, const uint64_t *x, const uint64_t *m, const uint64_t *mu);
+
+extern void barrett_2(uint64_t *, const uint64_t *, const uint64_t *, const uint64_t *);
+extern void barrett_3(uint64_t *, const uint64_t *, const uint64_t *, const uint64_t *);
+extern void barrett_4(uint64_t *, const uint64_t *, const uint64_t *, const uint64_t *);
+extern void barrett_6(uint64_t *, const uint64_t *, const uint64_t *, const uint64_t *);
+extern void barrett_8(uint64_t *, const uint64_t *, const uint64_t *, const uint64_t *);
+
+// Montgomery multipliers from demo_montmul.py, for the timing comparison
+typedef void (*montmul_fn)(uint64_t *r, const uint64_t *a, const uint64_t *b, const uint64_t *m, uint64_t n0inv);
+
+extern void montmul_4(uint64_t *, const uint64_t *, const uint64_t *, const uint64_t *, uint64_t);
+extern void montmul_6(uint64_t *, const uint64_t *, const uint64_t *, const uint64_t *, uint64_t);
+extern void montmul_8(uint64_t *, const uint64_t *, const uint64_t *, const uint64_t *, uint64_t);
+
+#define MAX_LIMBS 8
+#define RANDOM_MODULI 20
+#define REDUCTIONS_PER_MODULUS 50
+#define GUARD 0x5A5A5A5A5A5A5A5AULL
+
+// Generate random 64-bit number
+uint64_t random_uint64() {
+    return ((uint64_t)rand() << 62) ^ ((uint64_t)rand() << 31) ^ (uint64_t)rand();
+}
+
+// -m^-1 mod 2^64 for odd m[0], by Newton iteration (each step doubles the correct bits)
+uint64_t neg_inverse(uint64_t m0) {
+    uint64_t inv = m0;              // correct to 3 bits for odd m0
+    for (int i = 0; i < 5; i++) {
+        inv *= 2 - m0 * inv;
+    }
+    return -inv;
+}
+
+// mu = floor(2^(128n) / m), n + 1 limbs
+void barrett_mu(uint64_t *mu, const uint64_t *m, int n) {
+    mpz_t zm, zmu;
+    mpz_inits(zm, zmu, NULL);
+    mpz_import(zm, n, -1, sizeof(uint64_t), 0, 0, m);
+    mpz_set_ui(zmu, 1);
+    mpz_mul_2exp(zmu, zmu, 128 * n);
+    mpz_tdiv_q(zmu, zmu, zm);
+    memset(mu, 0, 8 * (n + 1));
+    mpz_export(mu, NULL, -1, sizeof(uint64_t), 0, 0, zmu);
+    mpz_clears(zm, zmu, NULL);
+}
+
+// Compare one reduction against GMP; the guard limb catches writes past r[n)
+int check_barrett(barrett_fn barrett, int n, const uint64_t *x, const uint64_t *m) {
+    uint64_t result[MAX_LIMBS + 1], expected[MAX_LIMBS], mu[MAX_LIMBS + 1];
+    mpz_t zx, zm;
+
+    mpz_inits(zx, zm, NULL);
+    mpz_import(zx, 2 * n, -1, sizeof(uint64_t), 0, 0, x);
+    mpz_import(zm, n, -1, sizeof(uint64_t), 0, 0, m);
+    mpz_mod(zx, zx, zm);
+    memset(expected, 0, 8 * n);
+    mpz_export(expected, NULL, -1, sizeof(uint64_t), 0, 0, zx);
+    mpz_clears(zx, zm, NULL);
+
+    barrett_mu(mu, m, n);
+    result[n] = GUARD;
+    barrett(result, x, m, mu);
+
+    total_tests++;
+    if (memcmp(result, expected, 8 * n) == 0 && result[n] == GUARD) {
+        passed_tests++;
+        return 1;
+    }
+    return 0;
+}
+
+// Random n-limb modulus above 2^(64(n-1)); odd when Montgomery needs it
+void random_modulus(uint64_t *m, int n, int odd) {
+    for (int i = 0; i < n; i++) {
+        m[i] = random_uint64();
+    }
+    m[n - 1] |= 1;
+    m[0] |= odd;
+    if (m[n - 1] == 1) {
+        m[0] |= 1;
+    }
+}
+
+void run_edge_cases(const char *name, barrett_fn barrett, int n) {
+    uint64_t x[2 * MAX_LIMBS], m[MAX_LIMBS];
+    int before = passed_tests, count = 0;
+
+    printf("\n========================================\n");
+    printf("%s Edge Cases\n", name);
+    printf("========================================\n");
+
+    // Moduli at both ends of the range, and one with a small top limb (mu at its largest)
+    for (int k = 0; k < 3; k++) {
+        if (k == 0) {
+            memset(m, 0xFF, sizeof m);
+        } else {
+            memset(m, 0, sizeof m);
+            m[0] = 1;
+            m[n - 1] = k == 1 ? 1 : 3;
+        }
+
+        memset(x, 0xFF, sizeof x);
+        count++; if (!check_barrett(barrett, n, x, m)) printf("FAIL: modulus %d, x = 2^(128n) - 1\n", k);
+        memset(x, 0, sizeof x);
+        count++; if (!check_barrett(barrett, n, x, m)) printf("FAIL: modulus %d, x = 0\n", k);
+        memcpy(x, m, 8 * n); x[0]--;
+        count++; if (!check_barrett(barrett, n, x, m)) printf("FAIL: modulus %d, x = m - 1\n", k);
+        x[0]++;
+        count++; if (!check_barrett(barrett, n, x, m)) printf("FAIL: modulus %d, x = m\n", k);
+
+        // (m - 1)² and m·(2^(64n) - 1): the largest remainder and an exact multiple
+        uint64_t a[MAX_LIMBS], b[MAX_LIMBS];
+        memcpy(a, m, sizeof a); a[0]--;
+        mpn_mul_n((mp_limb_t *)x, (const mp_limb_t *)a, (const mp_limb_t *)a, n);
+        count++; if (!check_barrett(barrett, n, x, m)) printf("FAIL: modulus %d, x = (m - 1)^2\n", k);
+        memset(b, 0xFF, sizeof b);
+        mpn_mul_n((mp_limb_t *)x, (const mp_limb_t *)m, (const mp_limb_t *)b, n);
+        count++; if (!check_barrett(barrett, n, x, m)) printf("FAIL: modulus %d, x = m * (2^(64n) - 1)\n", k);
+    }
+
+    printf("Edge cases: %d/%d passed\n", passed_tests - before, count);
+}
+
+void run_random_tests(const char *name, barrett_fn barrett, int n) {
+    uint64_t x[2 * MAX_LIMBS], m[MAX_LIMBS];
+    int random_passed = 0, total = 0;
+
+    printf("\n========================================\n");
+    printf("%s Random Tests (%d moduli × %d reductions)\n", name, RANDOM_MODULI, REDUCTIONS_PER_MODULUS);
+    printf("========================================\n");
+
+    for (int k = 0; k < RANDOM_MODULI; k++) {
+        random_modulus(m, n, k % 2);
+        // Every fourth modulus has a one-bit top limb, where the quotient estimate is weakest
+        if (k % 4 == 3) {
+            m[n - 1] = 1;
+        }
+        for (int t = 0; t < REDUCTIONS_PER_MODULUS; t++) {
+            for (int i = 0; i < 2 * n; i++) {
+                x[i] = random_uint64();
+            }
+            total++;
+            if (check_barrett(barrett, n, x, m)) {
+                random_passed++;
+            } else if (total - random_passed <= 10) {   // report the first few failures only
+                printf("FAIL: modulus %d, reduction %d\n", k, t);
+            }
+        }
+    }
+
+    printf("Random tests: %d/%d random tests passed\n", random_passed, total);
+}
+
+// Modular multiplication three ways: mpn_mul_n + Barrett, Montgomery, and mpz_mul + mpz_mod
+void run_benchmark(const char *name, barrett_fn barrett, montmul_fn montmul, int n) {
+    uint64_t a[MAX_LIMBS], b[MAX_LIMBS], m[MAX_LIMBS], mu[MAX_LIMBS + 1], x[2 * MAX_LIMBS];
+    const int iterations = 1000000;
+    struct timespec start, end;
+    double ns[4];
+    mpz_t za, zb, zm;
+
+    random_modulus(m, n, 1);
+    barrett_mu(mu, m, n);
+    for (int i = 0; i < n; i++) {
+        a[i] = random_uint64();
+        b[i] = random_uint64();
+    }
+    m[n - 1] |= 0x8000000000000000ULL;   // a, b < m
+    a[n - 1] >>= 1;
+    b[n - 1] >>= 1;
+
+    // Reduction alone
+    mpn_mul_n((mp_limb_t *)x, (const mp_limb_t *)a, (const mp_limb_t *)b, n);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < iterations; i++) {
+        barrett(x, x, m, mu);       // x[0, n) feeds the next call
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    ns[0] = ((end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec)) / iterations;
+
+    // Chains of dependent modular multiplications
+    uint64_t r[MAX_LIMBS];
+    memcpy(r, a, sizeof r);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < iterations; i++) {
+        mpn_mul_n((mp_limb_t *)x, (const mp_limb_t *)r, (const mp_limb_t *)b, n);
+        barrett(r, x, m, mu);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    ns[1] = ((end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec)) / iterations;
+
+    uint64_t n0inv = neg_inverse(m[0]);
+    memcpy(r, a, sizeof r);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < iterations; i++) {
+        montmul(r, r, b, m, n0inv);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    ns[2] = ((end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec)) / iterations;
+
+    mpz_inits(za, zb, zm, NULL);
+    mpz_import(za, n, -1, sizeof(uint64_t), 0, 0, a);
+    mpz_import(zb, n, -1, sizeof(uint64_t), 0, 0, b);
+    mpz_import(zm, n, -1, sizeof(uint64_t), 0, 0, m);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < iterations; i++) {
+        mpz_mul(za, za, zb);
+        mpz_mod(za, za, zm);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    ns[3] = ((end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec)) / iterations;
+    mpz_clears(za, zb, zm, NULL);
+
+    printf("%-22s %8.1f %10.1f %10.1f %10.1f\n", name, ns[0], ns[1], ns[2], ns[3]);
+}
+
+int main() {
+    static const struct {
+        const char *name;
+        barrett_fn barrett;
+        montmul_fn montmul;     // NULL where there is no Montgomery kernel of that size
+        int limbs;
+    } sizes[] = {
+        { "barrett_2 (128-bit)", barrett_2, NULL,      2 },
+        { "barrett_3 (192-bit)", barrett_3, NULL,      3 },
+        { "barrett_4 (256-bit)", barrett_4, montmul_4, 4 },
+        { "barrett_6 (384-bit)", barrett_6, montmul_6, 6 },
+        { "barrett_8 (512-bit)", barrett_8, montmul_8, 8 },
+    };
+    const size_t count = sizeof sizes / sizeof sizes[0];
+
+    printf("Barrett Reduction Test Suite with GMP Verification\n");
+    printf("==================================================\n");
+
+    srand((unsigned int)time(NULL));
+
+    for (size_t s = 0; s < count; s++) {
+        run_edge_cases(sizes[s].name, sizes[s].barrett, sizes[s].limbs);
+        run_random_tests(sizes[s].name, sizes[s].barrett, sizes[s].limbs);
+    }
+
+    printf("\n========================================\n");
+    printf("Timing (ns per call)\n");
+    printf("========================================\n");
+    printf("%-22s %8s %10s %10s %10s\n", "", "reduce", "mul+barr", "montmul", "mpz_mod");
+    for (size_t s = 0; s < count; s++) {
+        if (sizes[s].montmul) {
+            run_benchmark(sizes[s].name, sizes[s].barrett, sizes[s].montmul, sizes[s].limbs);
+        }
+    }
+
+    printf("\n=== Final Test Summary ===\n");
+    printf("Total tests run: %d\n", total_tests);
+    printf("Tests passed:    %d\n", passed_tests);
+    printf("Tests failed:    %d\n", total_tests - passed_tests);
+    printf("Success rate:    %.2f%%\n", (double)passed_tests / total_tests * 100.0);
+
+    if (passed_tests == total_tests) {
+        printf("🎉 ALL TESTS PASSED! 🎉\n");
+        return 0;
+    } else {
+        printf("❌ SOME TESTS FAILED ❌\n");
+        return 1;
+    }
+}
@@ -0,0 +1,357 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdlib.h>
+#include <time.h>
+#include <gmp.h>
+
+// Global test counters
+int total_tests = 0;
+int passed_tests = 0;
+
+// Field kernels generated by demo_field.py; p256 and p384 mul/sqr/reduce carry a factor R^-1, R = 2^(64n)
+typedef void (*binary_fn)(uint64_t *r, const uint64_t *a, const uint64_t *b);
+typedef void (*unary_fn)(uint64_t *r, const uint64_t *a);
+
+#define DECLARE_FIELD(f) \
+    extern void f##_add(uint64_t *, const uint64_t *, const uint64_t *); \
+    extern void f##_sub(uint64_t *, const uint64_t *, const uint64_t *); \
+    extern void f##_mul(uint64_t *, const uint64_t *, const uint64_t *); \
+    extern void f##_sqr(uint64_t *, const uint64_t *); \
+    extern void f##_reduce(uint64_t *, const uint64_t *);
+
+DECLARE_FIELD(secp256k1)
+DECLARE_FIELD(p25519)
+DECLARE_FIELD(p256)
+DECLARE_FIELD(p384)
+
+// Radix 2^51: five limbs below 2^52 in, five limbs below 2^52 out
+extern void p25519_mul51(uint64_t r[5], const uint64_t a[5], const uint64_t b[5]);
+extern void p25519_sqr51(uint64_t r[5], const uint64_t a[5]);
+
+#define MAX_LIMBS 6
+#define RANDOM_TESTS 1000
+#define GUARD 0x5A5A5A5A5A5A5A5AULL
+
+typedef struct {
+    const char *name;
+    const char *p_hex;
+    int limbs;
+    int montgomery;
+    binary_fn add, sub, mul;
+    unary_fn sqr, reduce;
+} field_t;
+
+static const field_t fields[] = {
+    { "secp256k1", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFC2F", 4, 0,
+      secp256k1_add, secp256k1_sub, secp256k1_mul, secp256k1_sqr, secp256k1_reduce },
+    { "p25519", "7FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFED", 4, 0,
+      p25519_add, p25519_sub, p25519_mul, p25519_sqr, p25519_reduce },
+    { "p256", "FFFFFFFF00000001000000000000000000000000FFFFFFFFFFFFFFFFFFFFFFFF", 4, 1,
+      p256_add, p256_sub, p256_mul, p256_sqr, p256_reduce },
+    { "p384", "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFFFF0000000000000000FFFFFFFF", 6, 1,
+      p384_add, p384_sub, p384_mul, p384_sqr, p384_reduce },
+};
+
+// Generate random 64-bit number
+uint64_t random_uint64() {
+    return ((uint64_t)rand() << 62) ^ ((uint64_t)rand() << 31) ^ (uint64_t)rand();
+}
+
+void to_limbs(uint64_t *x, int n, const mpz_t z) {
+    memset(x, 0, 8 * n);
+    mpz_export(x, NULL, -1, sizeof(uint64_t), 0, 0, z);
+}
+
+// p, and R^-1 mod p for the Montgomery fields (1 otherwise)
+void field_constants(const field_t *f, mpz_t p, mpz_t rinv) {
+    mpz_set_str(p, f->p_hex, 16);
+    mpz_set_ui(rinv, 1);
+    if (f->montgomery) {
+        mpz_mul_2exp(rinv, rinv, 64 * f->limbs);
+        mpz_invert(rinv, rinv, p);
+    }
+}
+
+// Compare one kernel result with the expected value; the guard limb catches writes past r[n)
+int check_result(const uint64_t *result, const mpz_t expected, int n) {
+    uint64_t want[MAX_LIMBS];
+    to_limbs(want, n, expected);
+    total_tests++;
+    if (memcmp(result, want, 8 * n) == 0 && result[n] == GUARD) {
+        passed_tests++;
+        return 1;
+    }
+    return 0;
+}
+
+// Run add, sub, mul, sqr on (a, b) and reduce on x; returns the number of failures
+int check_field(const field_t *f, const uint64_t *a, const uint64_t *b, const uint64_t *x) {
+    int n = f->limbs, failures = 0;
+    uint64_t r[MAX_LIMBS + 1];
+    mpz_t p, rinv, za, zb, zx, e;
+
+    mpz_inits(p, rinv, za, zb, zx, e, NULL);
+    field_constants(f, p, rinv);
+    mpz_import(za, n, -1, sizeof(uint64_t), 0, 0, a);
+    mpz_import(zb, n, -1, sizeof(uint64_t), 0, 0, b);
+    mpz_import(zx, 2 * n, -1, sizeof(uint64_t), 0, 0, x);
+
+    r[n] = GUARD; f->add(r, a, b);
+    mpz_add(e, za, zb); mpz_mod(e, e, p);
+    failures += !check_result(r, e, n);
+
+    r[n] = GUARD; f->sub(r, a, b);
+    mpz_sub(e, za, zb); mpz_mod(e, e, p);
+    failures += !check_result(r, e, n);
+
+    r[n] = GUARD; f->mul(r, a, b);
+    mpz_mul(e, za, zb); mpz_mul(e, e, rinv); mpz_mod(e, e, p);
+    failures += !check_result(r, e, n);
+
+    r[n] = GUARD; f->sqr(r, a);
+    mpz_mul(e, za, za); mpz_mul(e, e, rinv); mpz_mod(e, e, p);
+    failures += !check_result(r, e, n);
+
+    r[n] = GUARD; f->reduce(r, x);
+    mpz_mul(e, zx, rinv); mpz_mod(e, e, p);
+    failures += !check_result(r, e, n);
+
+    mpz_clears(p, rinv, za, zb, zx, e, NULL);
+    return failures;
+}
+
+// Random a, b < p; x is a·b for the Montgomery fields (reduce needs x < p·R), any 2n limbs otherwise
+void random_operands(const field_t *f, uint64_t *a, uint64_t *b, uint64_t *x) {
+    int n = f->limbs;
+    uint64_t t[2 * MAX_LIMBS];
+    mpz_t p, rinv, z;
+
+    mpz_inits(p, rinv, z, NULL);
+    field_constants(f, p, rinv);
+    for (int i = 0; i < 2 * n; i++) {
+        t[i] = random_uint64();
+    }
+    mpz_import(z, n, -1, sizeof(uint64_t), 0, 0, t);
+    mpz_mod(z, z, p);
+    to_limbs(a, n, z);
+    mpz_import(z, n, -1, sizeof(uint64_t), 0, 0, t + n);
+    mpz_mod(z, z, p);
+    to_limbs(b, n, z);
+    if (f->montgomery) {
+        mpn_mul_n((mp_limb_t *)x, (const mp_limb_t *)a, (const mp_limb_t *)b, n);
+    } else {
+        for (int i = 0; i < 2 * n; i++) {
+            x[i] = random_uint64();
+        }
+    }
+    mpz_clears(p, rinv, z, NULL);
+}
+
+void run_edge_cases(const field_t *f) {
+    int n = f->limbs, before = passed_tests, count = 0;
+    uint64_t v[5][MAX_LIMBS], x[2 * MAX_LIMBS];
+    mpz_t p, rinv, z;
+
+    printf("\n========================================\n");
+    printf("%s Edge Cases\n", f->name);
+    printf("========================================\n");
+
+    // 0, 1, p - 1, p - 2 and p / 2 against each other: sums and differences land on 0 and p
+    mpz_inits(p, rinv, z, NULL);
+    field_constants(f, p, rinv);
+    mpz_set_ui(z, 0);    to_limbs(v[0], n, z);
+    mpz_set_ui(z, 1);    to_limbs(v[1], n, z);
+    mpz_sub_ui(z, p, 1); to_limbs(v[2], n, z);
+    mpz_sub_ui(z, p, 2); to_limbs(v[3], n, z);
+    mpz_tdiv_q_2exp(z, p, 1); to_limbs(v[4], n, z);
+
+    for (int i = 0; i < 5; i++) {
+        for (int j = 0; j < 5; j++) {
+            // x = v[i]·v[j] < p², or 2^(128n) - 1 for the pseudo-Mersenne fields
+            if (f->montgomery || (i + j) % 2) {
+                mpn_mul_n((mp_limb_t *)x, (const mp_limb_t *)v[i], (const mp_limb_t *)v[j], n);
+            } else {
+                memset(x, 0xFF, sizeof x);
+            }
+            count += 5;
+            if (check_field(f, v[i], v[j], x)) {
+                printf("FAIL: edge operands %d, %d\n", i, j);
+            }
+        }
+    }
+    mpz_clears(p, rinv, z, NULL);
+
+    printf("Edge cases: %d/%d passed\n", passed_tests - before, count);
+}
+
+void run_random_tests(const field_t *f) {
+    uint64_t a[MAX_LIMBS], b[MAX_LIMBS], x[2 * MAX_LIMBS];
+    int before = passed_tests, reported = 0;
+
+    printf("\n========================================\n");
+    printf("%s Random Tests (%d × add/sub/mul/sqr/reduce)\n", f->name, RANDOM_TESTS);
+    printf("========================================\n");
+
+    for (int t = 0; t < RANDOM_TESTS; t++) {
+        random_operands(f, a, b, x);
+        if (check_field(f, a, b, x) && reported++ < 10) {   // report the first few failures only
+            printf("FAIL: random test %d\n", t);
+        }
+    }
+
+    printf("Random tests: %d/%d random tests passed\n", passed_tests - before, 5 * RANDOM_TESTS);
+}
+
+// Radix 2^51: the value of r must match a·b mod p and every limb must stay below 2^52
+int check_radix51(const uint64_t *a, const uint64_t *b, int square) {
+    uint64_t r[6];
+    mpz_t p, za, zb, zr;
+    int ok = 1;
+
+    mpz_inits(p, za, zb, zr, NULL);
+    mpz_set_str(p, fields[1].p_hex, 16);
+    for (int i = 4; i >= 0; i--) {
+        mpz_mul_2exp(za, za, 51); mpz_add_ui(za, za, a[i]);
+        mpz_mul_2exp(zb, zb, 51); mpz_add_ui(zb, zb, b[i]);
+    }
+
+    r[5] = GUARD;
+    if (square) {
+        p25519_sqr51(r, a);
+        mpz_set(zb, za);
+    } else {
+        p25519_mul51(r, a, b);
+    }
+    for (int i = 4; i >= 0; i--) {
+        ok &= r[i] < (1ULL << 52);
+        mpz_mul_2exp(zr, zr, 51); mpz_add_ui(zr, zr, r[i]);
+    }
+    mpz_mul(za, za, zb);
+    mpz_sub(zr, zr, za);
+    ok &= mpz_divisible_p(zr, p) && r[5] == GUARD;
+    mpz_clears(p, za, zb, zr, NULL);
+
+    total_tests++;
+    passed_tests += ok;
+    return ok;
+}
+
+void run_radix51_tests() {
+    uint64_t a[5], b[5];
+    int before = passed_tests, count = 0;
+
+    printf("\n========================================\n");
+    printf("p25519 Radix 2^51 Tests\n");
+    printf("========================================\n");
+
+    // Largest allowed limbs: the column sums are at their widest
+    for (int i = 0; i < 5; i++) {
+        a[i] = b[i] = (1ULL << 52) - 1;
+    }
+    count += 2;
+    if (!check_radix51(a, b, 0) || !check_radix51(a, b, 1)) {
+        printf("FAIL: limbs 2^52 - 1\n");
+    }
+
+    for (int t = 0; t < RANDOM_TESTS; t++) {
+        for (int i = 0; i < 5; i++) {
+            a[i] = random_uint64() >> 12;
+            b[i] = random_uint64() >> 12;
+        }
+        count += 2;
+        if ((!check_radix51(a, b, 0) || !check_radix51(a, b, 1)) && count - (passed_tests - before) <= 10) {
+            printf("FAIL: random test %d\n", t);
+        }
+    }
+
+    printf("Radix 2^51: %d/%d passed\n", passed_tests - before, count);
+}
+
+void run_benchmark(const field_t *f) {
+    uint64_t a[MAX_LIMBS], b[MAX_LIMBS], x[2 * MAX_LIMBS];
+    const int iterations = 1000000;
+    struct timespec start, end;
+    double ns[3];
+
+    random_operands(f, a, b, x);
+
+    // Chains of dependent calls, so each one waits for the last
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < iterations; i++) f->mul(a, a, b);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    ns[0] = ((end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec)) / iterations;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < iterations; i++) f->sqr(a, a);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    ns[1] = ((end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec)) / iterations;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < iterations; i++) f->add(a, a, b);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    ns[2] = ((end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec)) / iterations;
+
+    printf("%-9s  mul %6.1f ns   sqr %6.1f ns   add %5.1f ns\n", f->name, ns[0], ns[1], ns[2]);
+}
+
+void run_radix51_benchmark() {
+    uint64_t a[5], b[5];
+    const int iterations = 1000000;
+    struct timespec start, end;
+    double ns[2];
+
+    for (int i = 0; i < 5; i++) {
+        a[i] = random_uint64() >> 13;
+        b[i] = random_uint64() >> 13;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < iterations; i++) p25519_mul51(a, a, b);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    ns[0] = ((end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec)) / iterations;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < iterations; i++) p25519_sqr51(a, a);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    ns[1] = ((end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec)) / iterations;
+
+    printf("%-9s  mul %6.1f ns   sqr %6.1f ns   (radix 2^51)\n", "p25519", ns[0], ns[1]);
+}
+
+int main() {
+    const size_t count = sizeof fields / sizeof fields[0];
+
+    printf("Named-Prime Field Arithmetic Test Suite with GMP Verification\n");
+    printf("==============================================================\n");
+
+    srand((unsigned int)time(NULL));
+
+    for (size_t s = 0; s < count; s++) {
+        run_edge_cases(&fields[s]);
+        run_random_tests(&fields[s]);
+    }
+    run_radix51_tests();
+
+    printf("\n========================================\n");
+    printf("Timing\n");
+    printf("========================================\n");
+    for (size_t s = 0; s < count; s++) {
+        run_benchmark(&fields[s]);
+    }
+    run_radix51_benchmark();
+
+    printf("\n=== Final Test Summary ===\n");
+    printf("Total tests run: %d\n", total_tests);
+    printf("Tests passed:    %d\n", passed_tests);
+    printf("Tests failed:    %d\n", total_tests - passed_tests);
+    printf("Success rate:    %.2f%%\n", (double)passed_tests / total_tests * 100.0);
+
+    if (passed_tests == total_tests) {
+        printf("🎉 ALL TESTS PASSED! 🎉\n");
+        return 0;
+    } else {
+        printf("❌ SOME TESTS FAILED ❌\n");
+        return 1;
+    }
+}
@@ -0,0 +1,231 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdlib.h>
+#include <time.h>
+#include <gmp.h>
+
+// Global test counters
+int total_tests = 0;
+int passed_tests = 0;
+
+// Montgomery multipliers generated by demo_montmul.py: r = a·b·2^(-64n) mod m
+typedef void (*montmul_fn)(uint64_t *r, const uint64_t *a, const uint64_t *b, const uint64_t *m, uint64_t n0inv);
+
+extern void montmul_4(uint64_t *, const uint64_t *, const uint64_t *, const uint64_t *, uint64_t);
+extern void montmul_6(uint64_t *, const uint64_t *, const uint64_t *, const uint64_t *, uint64_t);
+extern void montmul_8(uint64_t *, const uint64_t *, const uint64_t *, const uint64_t *, uint64_t);
+extern void montmul_12(uint64_t *, const uint64_t *, const uint64_t *, const uint64_t *, uint64_t);
+extern void montmul_16(uint64_t *, const uint64_t *, const uint64_t *, const uint64_t *, uint64_t);
+extern void montmul_32(uint64_t *, const uint64_t *, const uint64_t *, const uint64_t *, uint64_t);
+extern void montmul_48(uint64_t *, const uint64_t *, const uint64_t *, const uint64_t *, uint64_t);
+extern void montmul_64(uint64_t *, const uint64_t *, const uint64_t *, const uint64_t *, uint64_t);
+
+#define MAX_LIMBS 64
+#define RANDOM_MODULI 20
+#define PRODUCTS_PER_MODULUS 50
+
+// Generate random 64-bit number
+uint64_t random_uint64() {
+    return ((uint64_t)rand() << 62) ^ ((uint64_t)rand() << 31) ^ (uint64_t)rand();
+}
+
+// -m^-1 mod 2^64 for odd m[0], by Newton iteration (each step doubles the correct bits)
+uint64_t neg_inverse(uint64_t m0) {
+    uint64_t inv = m0;              // correct to 3 bits for odd m0
+    for (int i = 0; i < 5; i++) {
+        inv *= 2 - m0 * inv;
+    }
+    return -inv;
+}
+
+// x mod m for an n-limb x, via GMP
+void reduce(uint64_t *x, const uint64_t *m, int n) {
+    mpz_t zx, zm;
+    mpz_inits(zx, zm, NULL);
+    mpz_import(zx, n, -1, sizeof(uint64_t), 0, 0, x);
+    mpz_import(zm, n, -1, sizeof(uint64_t), 0, 0, m);
+    mpz_mod(zx, zx, zm);
+    memset(x, 0, 8 * n);
+    mpz_export(x, NULL, -1, sizeof(uint64_t), 0, 0, zx);
+    mpz_clears(zx, zm, NULL);
+}
+
+// Compare one Montgomery product against GMP; the guard limb catches writes past r[n)
+int check_montmul(montmul_fn montmul, int n, const uint64_t *a, const uint64_t *b, const uint64_t *m) {
+    uint64_t result[MAX_LIMBS + 1], expected[MAX_LIMBS];
+    mpz_t za, zb, zm, zr;
+
+    mpz_inits(za, zb, zm, zr, NULL);
+    mpz_import(za, n, -1, sizeof(uint64_t), 0, 0, a);
+    mpz_import(zb, n, -1, sizeof(uint64_t), 0, 0, b);
+    mpz_import(zm, n, -1, sizeof(uint64_t), 0, 0, m);
+
+    // expected = a·b·R^-1 mod m with R = 2^(64n)
+    mpz_set_ui(zr, 1);
+    mpz_mul_2exp(zr, zr, 64 * n);
+    mpz_invert(zr, zr, zm);
+    mpz_mul(zr, zr, za);
+    mpz_mul(zr, zr, zb);
+    mpz_mod(zr, zr, zm);
+    memset(expected, 0, 8 * n);
+    mpz_export(expected, NULL, -1, sizeof(uint64_t), 0, 0, zr);
+    mpz_clears(za, zb, zm, zr, NULL);
+
+    result[n] = 0x5A5A5A5A5A5A5A5AULL;
+    montmul(result, a, b, m, neg_inverse(m[0]));
+
+    total_tests++;
+    if (memcmp(result, expected, 8 * n) == 0 && result[n] == 0x5A5A5A5A5A5A5A5AULL) {
+        passed_tests++;
+        return 1;
+    }
+    return 0;
+}
+
+void random_modulus(uint64_t *m, int n, int full_top) {
+    for (int i = 0; i < n; i++) {
+        m[i] = random_uint64();
+    }
+    m[0] |= 1;
+    if (full_top) {
+        m[n - 1] |= 0x8000000000000000ULL;
+    }
+}
+
+void run_edge_cases(const char *name, montmul_fn montmul, int n) {
+    uint64_t a[MAX_LIMBS], b[MAX_LIMBS], m[MAX_LIMBS];
+    int before = passed_tests, count = 0;
+
+    printf("\n========================================\n");
+    printf("%s Edge Cases\n", name);
+    printf("========================================\n");
+
+    // m = 2^(64n) - 1: every intermediate has all-ones limbs
+    memset(m, 0xFF, sizeof m);
+    memcpy(a, m, sizeof a); a[0]--;
+    memcpy(b, a, sizeof b);
+    count++; if (!check_montmul(montmul, n, a, b, m)) printf("FAIL: (m-1)² mod 2^(64n)-1\n");
+
+    // m = 2^(64n-1) + 1, the smallest full-size modulus
+    memset(m, 0, sizeof m);
+    m[0] = 1; m[n - 1] = 0x8000000000000000ULL;
+    memcpy(a, m, sizeof a); a[0] = 0;
+    memset(b, 0, sizeof b);
+    count++; if (!check_montmul(montmul, n, a, b, m)) printf("FAIL: (m-1)·0\n");
+    b[0] = 1;
+    count++; if (!check_montmul(montmul, n, a, b, m)) printf("FAIL: (m-1)·1\n");
+    memcpy(b, a, sizeof b);
+    count++; if (!check_montmul(montmul, n, a, b, m)) printf("FAIL: (m-1)²\n");
+
+    // Small modulus in a wide representation: the top limbs of m are zero
+    random_modulus(m, n, 0);
+    for (int i = n / 2; i < n; i++) {
+        m[i] = 0;
+    }
+    memcpy(a, m, sizeof a); a[0]--;
+    memcpy(b, a, sizeof b);
+    count++; if (!check_montmul(montmul, n, a, b, m)) printf("FAIL: half-width modulus\n");
+
+    printf("Edge cases: %d/%d passed\n", passed_tests - before, count);
+}
+
+void run_random_tests(const char *name, montmul_fn montmul, int n) {
+    uint64_t a[MAX_LIMBS], b[MAX_LIMBS], m[MAX_LIMBS];
+    int random_passed = 0, total = 0;
+
+    printf("\n========================================\n");
+    printf("%s Random Tests (%d moduli × %d products)\n", name, RANDOM_MODULI, PRODUCTS_PER_MODULUS);
+    printf("========================================\n");
+
+    for (int k = 0; k < RANDOM_MODULI; k++) {
+        // Half the moduli have the top bit set, the others are any odd n-limb number
+        random_modulus(m, n, k % 2 == 0);
+        for (int t = 0; t < PRODUCTS_PER_MODULUS; t++) {
+            for (int i = 0; i < n; i++) {
+                a[i] = random_uint64();
+                b[i] = random_uint64();
+            }
+            reduce(a, m, n);
+            reduce(b, m, n);
+            total++;
+            if (check_montmul(montmul, n, a, b, m)) {
+                random_passed++;
+            } else if (total - random_passed <= 10) {   // report the first few failures only
+                printf("FAIL: modulus %d, product %d\n", k, t);
+            }
+        }
+    }
+
+    printf("Random tests: %d/%d random tests passed\n", random_passed, total);
+}
+
+void run_benchmark(const char *name, montmul_fn montmul, int n) {
+    uint64_t a[MAX_LIMBS], m[MAX_LIMBS];
+    const int iterations = n <= 16 ? 1000000 : 100000;
+    struct timespec start, end;
+
+    random_modulus(m, n, 1);
+    for (int i = 0; i < n; i++) {
+        a[i] = random_uint64();
+    }
+    reduce(a, m, n);
+    uint64_t n0inv = neg_inverse(m[0]);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < iterations; i++) {
+        montmul(a, a, a, m, n0inv);     // a chain of squarings: each call depends on the last
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double ns = ((end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec)) / iterations;
+    printf("%s: %.1f ns per call\n", name, ns);
+}
+
+int main() {
+    static const struct {
+        const char *name;
+        montmul_fn montmul;
+        int limbs;
+    } sizes[] = {
+        { "montmul_4  (256-bit)",  montmul_4,  4 },
+        { "montmul_6  (384-bit)",  montmul_6,  6 },
+        { "montmul_8  (512-bit)",  montmul_8,  8 },
+        { "montmul_12 (768-bit)",  montmul_12, 12 },
+        { "montmul_16 (1024-bit)", montmul_16, 16 },
+        { "montmul_32 (2048-bit)", montmul_32, 32 },
+        { "montmul_48 (3072-bit)", montmul_48, 48 },
+        { "montmul_64 (4096-bit)", montmul_64, 64 },
+    };
+    const size_t count = sizeof sizes / sizeof sizes[0];
+
+    printf("Montgomery Multiplication Test Suite with GMP Verification\n");
+    printf("===========================================================\n");
+
+    srand((unsigned int)time(NULL));
+
+    for (size_t s = 0; s < count; s++) {
+        run_edge_cases(sizes[s].name, sizes[s].montmul, sizes[s].limbs);
+        run_random_tests(sizes[s].name, sizes[s].montmul, sizes[s].limbs);
+    }
+
+    printf("\n========================================\n");
+    printf("Timing\n");
+    printf("========================================\n");
+    for (size_t s = 0; s < count; s++) {
+        run_benchmark(sizes[s].name, sizes[s].montmul, sizes[s].limbs);
+    }
+
+    printf("\n=== Final Test Summary ===\n");
+    printf("Total tests run: %d\n", total_tests);
+    printf("Tests passed:    %d\n", passed_tests);
+    printf("Tests failed:    %d\n", total_tests - passed_tests);
+    printf("Success rate:    %.2f%%\n", (double)passed_tests / total_tests * 100.0);
+
+    if (passed_tests == total_tests) {
+        printf("🎉 ALL TESTS PASSED! 🎉\n");
+        return 0;
+    } else {
+        printf("❌ SOME TESTS FAILED ❌\n");
+        return 1;
+    }
+}
@@ -0,0 +1,317 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdlib.h>
+#include <time.h>
+#include <gmp.h>
+
+// Global test counters
+int total_tests = 0;
+int passed_tests = 0;
+
+// N-limb primitives generated by demo_mpn.py (GMP mpn argument order, carry/borrow in the return value)
+extern uint64_t add_n(uint64_t *r, const uint64_t *u, const uint64_t *v, size_t n);
+extern uint64_t sub_n(uint64_t *r, const uint64_t *u, const uint64_t *v, size_t n);
+extern int64_t cmp_n(const uint64_t *u, const uint64_t *v, size_t n);
+extern uint64_t neg_n(uint64_t *r, const uint64_t *u, size_t n);
+extern uint64_t add_1(uint64_t *r, const uint64_t *u, size_t n, uint64_t v);
+extern uint64_t sub_1(uint64_t *r, const uint64_t *u, size_t n, uint64_t v);
+extern uint64_t cnd_add_n(uint64_t c, uint64_t *r, const uint64_t *u, const uint64_t *v, size_t n);
+extern uint64_t cnd_sub_n(uint64_t c, uint64_t *r, const uint64_t *u, const uint64_t *v, size_t n);
+
+// Multiply rows and basecases, same ABI as GMP's mpn_mul_1, ..., mpn_sqr_basecase
+extern uint64_t mul_1(uint64_t *r, const uint64_t *u, size_t n, uint64_t v);
+extern uint64_t addmul_1(uint64_t *r, const uint64_t *u, size_t n, uint64_t v);
+extern uint64_t submul_1(uint64_t *r, const uint64_t *u, size_t n, uint64_t v);
+extern void mul_basecase(uint64_t *r, const uint64_t *u, size_t un, const uint64_t *v, size_t vn);
+extern void sqr_basecase(uint64_t *r, const uint64_t *u, size_t n);
+
+#define MAX_LIMBS 1024
+#define MAX_BASECASE 128
+#define RANDOM_TESTS 200
+#define GUARD 0x5A5A5A5A5A5A5A5AULL
+
+// Generate random 64-bit number
+uint64_t random_uint64() {
+    return ((uint64_t)rand() << 62) ^ ((uint64_t)rand() << 31) ^ (uint64_t)rand();
+}
+
+// Operand patterns: random limbs, all ones (carries run the full length), zero, or u itself
+enum { RANDOM, ONES, ZERO, SAME };
+
+void fill(uint64_t *x, size_t n, int pattern, const uint64_t *u) {
+    for (size_t i = 0; i < n; i++) {
+        x[i] = pattern == RANDOM ? random_uint64() : pattern == ONES ? ~0ULL : pattern == ZERO ? 0 : u[i];
+    }
+}
+
+int report(int ok, const char *op, size_t n, int pattern) {
+    total_tests++;
+    if (ok) {
+        passed_tests++;
+    } else {
+        printf("FAIL: %s, n = %zu, pattern %d\n", op, n, pattern);
+    }
+    return ok;
+}
+
+// Every primitive on one (u, v) pair against GMP; r gets a guard limb, and one more call runs in place
+void check_all(const uint64_t *u, const uint64_t *v, size_t n, int pattern) {
+    static uint64_t r[MAX_LIMBS + 1], e[MAX_LIMBS + 1], w[MAX_LIMBS];
+    uint64_t c, ce, s = random_uint64();
+
+    r[n] = GUARD; c = add_n(r, u, v, n);
+    ce = n ? mpn_add_n(e, u, v, n) : 0;
+    report(c == ce && !memcmp(r, e, 8 * n) && r[n] == GUARD, "add_n", n, pattern);
+
+    r[n] = GUARD; c = sub_n(r, u, v, n);
+    ce = n ? mpn_sub_n(e, u, v, n) : 0;
+    report(c == ce && !memcmp(r, e, 8 * n) && r[n] == GUARD, "sub_n", n, pattern);
+
+    int sign = n ? mpn_cmp(u, v, n) : 0;
+    report(cmp_n(u, v, n) == (sign > 0) - (sign < 0), "cmp_n", n, pattern);
+
+    r[n] = GUARD; c = neg_n(r, u, n);
+    ce = n ? mpn_neg(e, u, n) : 0;
+    report(c == ce && !memcmp(r, e, 8 * n) && r[n] == GUARD, "neg_n", n, pattern);
+
+    for (uint64_t cnd = 0; cnd < 2; cnd++) {
+        r[n] = GUARD; c = cnd_add_n(cnd * s, r, u, v, n);
+        ce = n ? mpn_cnd_add_n(cnd, e, u, v, n) : 0;
+        report(c == ce && !memcmp(r, e, 8 * n) && r[n] == GUARD, "cnd_add_n", n, pattern);
+
+        r[n] = GUARD; c = cnd_sub_n(cnd * s, r, u, v, n);
+        ce = n ? mpn_cnd_sub_n(cnd, e, u, v, n) : 0;
+        report(c == ce && !memcmp(r, e, 8 * n) && r[n] == GUARD, "cnd_sub_n", n, pattern);
+    }
+
+    if (n == 0) {
+        return;
+    }
+    uint64_t small = pattern == ONES ? 1 : v[0];
+    r[n] = GUARD; c = add_1(r, u, n, small);
+    ce = mpn_add_1(e, u, n, small);
+    report(c == ce && !memcmp(r, e, 8 * n) && r[n] == GUARD, "add_1", n, pattern);
+
+    r[n] = GUARD; c = sub_1(r, u, n, small);
+    ce = mpn_sub_1(e, u, n, small);
+    report(c == ce && !memcmp(r, e, 8 * n) && r[n] == GUARD, "sub_1", n, pattern);
+
+    // In place: r = u
+    memcpy(w, u, 8 * n);
+    c = add_n(w, w, v, n);
+    ce = mpn_add_n(e, u, v, n);
+    report(c == ce && !memcmp(w, e, 8 * n), "add_n in place", n, pattern);
+}
+
+// Multiply rows on top of a random r, and both basecases, against GMP (n >= 1)
+void check_multiply(const uint64_t *u, const uint64_t *v, size_t n, int pattern) {
+    static uint64_t r[2 * MAX_LIMBS + 1], e[2 * MAX_LIMBS + 1], w[MAX_LIMBS];
+    uint64_t c, ce, s = v[0];
+
+    fill(w, n, RANDOM, NULL);
+    memcpy(r, w, 8 * n); memcpy(e, w, 8 * n); r[n] = GUARD;
+    c = addmul_1(r, u, n, s);
+    ce = mpn_addmul_1(e, u, n, s);
+    report(c == ce && !memcmp(r, e, 8 * n) && r[n] == GUARD, "addmul_1", n, pattern);
+
+    memcpy(r, w, 8 * n); memcpy(e, w, 8 * n); r[n] = GUARD;
+    c = submul_1(r, u, n, s);
+    ce = mpn_submul_1(e, u, n, s);
+    report(c == ce && !memcmp(r, e, 8 * n) && r[n] == GUARD, "submul_1", n, pattern);
+
+    r[n] = GUARD;
+    c = mul_1(r, u, n, s);
+    ce = mpn_mul_1(e, u, n, s);
+    report(c == ce && !memcmp(r, e, 8 * n) && r[n] == GUARD, "mul_1", n, pattern);
+
+    // In place, which GMP allows for mul_1
+    memcpy(w, u, 8 * n);
+    c = mul_1(w, w, n, s);
+    report(c == ce && !memcmp(w, e, 8 * n), "mul_1 in place", n, pattern);
+
+    if (n > MAX_BASECASE) {
+        return;
+    }
+    size_t vn = 1 + random_uint64() % n;
+    r[n + vn] = GUARD;
+    mul_basecase(r, u, n, v, vn);
+    mpn_mul(e, u, n, v, vn);
+    report(!memcmp(r, e, 8 * (n + vn)) && r[n + vn] == GUARD, "mul_basecase", n, pattern);
+
+    r[2 * n] = GUARD;
+    sqr_basecase(r, u, n);
+    mpn_sqr(e, u, n);
+    report(!memcmp(r, e, 16 * n) && r[2 * n] == GUARD, "sqr_basecase", n, pattern);
+}
+
+void run_tests() {
+    static uint64_t u[MAX_LIMBS], v[MAX_LIMBS];
+    int before = passed_tests, count = total_tests;
+
+    printf("\n========================================\n");
+    printf("Every Length 0-70 and Pattern\n");
+    printf("========================================\n");
+
+    // Every remainder mod 4 against every block count up to 17
+    for (size_t n = 0; n <= 70; n++) {
+        for (int pu = RANDOM; pu <= ZERO; pu++) {
+            for (int pv = RANDOM; pv <= SAME; pv++) {
+                fill(u, n, pu, NULL);
+                fill(v, n, pv, u);
+                check_all(u, v, n, 4 * pu + pv);
+                if (n) {
+                    check_multiply(u, v, n, 4 * pu + pv);
+                }
+            }
+        }
+    }
+    printf("Lengths 0-70: %d/%d passed\n", passed_tests - before, total_tests - count);
+
+    printf("\n========================================\n");
+    printf("Random Tests (%d tests, up to %d limbs)\n", RANDOM_TESTS, MAX_LIMBS);
+    printf("========================================\n");
+    before = passed_tests, count = total_tests;
+    for (int t = 0; t < RANDOM_TESTS; t++) {
+        size_t n = 1 + random_uint64() % MAX_LIMBS;
+        fill(u, n, RANDOM, NULL);
+        fill(v, n, t % 3 ? RANDOM : SAME, u);
+        // A run of all-ones limbs from a random position, so a carry travels across blocks
+        for (size_t i = random_uint64() % n; i < n && t % 2; i++) {
+            u[i] = ~0ULL;
+        }
+        check_all(u, v, n, t % 3 ? RANDOM : SAME);
+        check_multiply(u, v, n, t % 3 ? RANDOM : SAME);
+    }
+    printf("Random tests: %d/%d random tests passed\n", passed_tests - before, total_tests - count);
+}
+
+void run_benchmark() {
+    static uint64_t u[MAX_LIMBS], v[MAX_LIMBS], r[MAX_LIMBS];
+    static const size_t lengths[] = { 4, 16, 64, 256, 1024 };
+    struct timespec start, end;
+
+    fill(u, MAX_LIMBS, RANDOM, NULL);
+    fill(v, MAX_LIMBS, RANDOM, NULL);
+
+    printf("%-6s %12s %12s %12s %12s\n", "n", "add_n", "mpn_add_n", "sub_n", "mpn_sub_n");
+    for (size_t l = 0; l < sizeof lengths / sizeof lengths[0]; l++) {
+        size_t n = lengths[l];
+        const long iterations = 64000000 / (n + 16);
+        double ns[4];
+        uint64_t sink = 0;
+
+        for (int which = 0; which < 4; which++) {
+            clock_gettime(CLOCK_MONOTONIC, &start);
+            for (long i = 0; i < iterations; i++) {
+                switch (which) {
+                    case 0: sink += add_n(r, u, v, n); break;
+                    case 1: sink += mpn_add_n(r, u, v, n); break;
+                    case 2: sink += sub_n(r, u, v, n); break;
+                    case 3: sink += mpn_sub_n(r, u, v, n); break;
+                }
+            }
+            clock_gettime(CLOCK_MONOTONIC, &end);
+            ns[which] = ((end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec)) / iterations;
+        }
+        printf("%-6zu %9.1f ns %9.1f ns %9.1f ns %9.1f ns%s\n", n, ns[0], ns[1], ns[2], ns[3], sink == 42 ? " " : "");
+    }
+}
+
+// Multiply rows per limb and basecases per limb product; cycles too when the clock is known
+void run_multiply_benchmark(double ghz) {
+    static uint64_t u[MAX_LIMBS], v[MAX_LIMBS], r[2 * MAX_LIMBS];
+    static const size_t lengths[] = { 4, 16, 64, 256, 1024 };
+    static const size_t squares[] = { 4, 8, 16, 32 };
+    const char *unit = ghz > 0 ? "c/limb" : "ns/limb";
+    struct timespec start, end;
+
+    fill(u, MAX_LIMBS, RANDOM, NULL);
+    fill(v, MAX_LIMBS, RANDOM, NULL);
+
+    printf("%-6s %14s %14s %14s %14s %14s %14s   (%s)\n", "n", "mul_1", "mpn_mul_1",
+           "addmul_1", "mpn_addmul_1", "submul_1", "mpn_submul_1", unit);
+    for (size_t l = 0; l < sizeof lengths / sizeof lengths[0]; l++) {
+        size_t n = lengths[l];
+        const long iterations = 32000000 / (n + 16);
+        double per[6];
+        uint64_t sink = 0;
+
+        for (int which = 0; which < 6; which++) {
+            clock_gettime(CLOCK_MONOTONIC, &start);
+            for (long i = 0; i < iterations; i++) {
+                switch (which) {
+                    case 0: sink += mul_1(r, u, n, v[0]); break;
+                    case 1: sink += mpn_mul_1(r, u, n, v[0]); break;
+                    case 2: sink += addmul_1(r, u, n, v[0]); break;
+                    case 3: sink += mpn_addmul_1(r, u, n, v[0]); break;
+                    case 4: sink += submul_1(r, u, n, v[0]); break;
+                    case 5: sink += mpn_submul_1(r, u, n, v[0]); break;
+                }
+            }
+            clock_gettime(CLOCK_MONOTONIC, &end);
+            per[which] = ((end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec)) / iterations / n;
+            per[which] *= ghz > 0 ? ghz : 1;
+        }
+        printf("%-6zu %14.2f %14.2f %14.2f %14.2f %14.2f %14.2f%s\n", n,
+               per[0], per[1], per[2], per[3], per[4], per[5], sink == 42 ? " " : "");
+    }
+
+    // mpn_mul/mpn_sqr leave their basecase at GMP's Toom-2 thresholds (tens of limbs), so the last rows may not be like for like
+    printf("\n%-6s %14s %14s %14s %14s   (%s per limb product)\n", "n", "mul_basecase", "mpn_mul",
+           "sqr_basecase", "mpn_sqr", ghz > 0 ? "cycles" : "ns");
+    for (size_t l = 0; l < sizeof squares / sizeof squares[0]; l++) {
+        size_t n = squares[l];
+        const long iterations = 32000000 / (n * n + 16);
+        double per[4];
+
+        for (int which = 0; which < 4; which++) {
+            clock_gettime(CLOCK_MONOTONIC, &start);
+            for (long i = 0; i < iterations; i++) {
+                switch (which) {
+                    case 0: mul_basecase(r, u, n, v, n); break;
+                    case 1: mpn_mul(r, u, n, v, n); break;
+                    case 2: sqr_basecase(r, u, n); break;
+                    case 3: mpn_sqr(r, u, n); break;
+                }
+            }
+            clock_gettime(CLOCK_MONOTONIC, &end);
+            per[which] = ((end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec)) / iterations / (n * n);
+            per[which] *= ghz > 0 ? ghz : 1;
+        }
+        printf("%-6zu %14.3f %14.3f %14.3f %14.3f\n", n, per[0], per[1], per[2], per[3]);
+    }
+}
+
+int main(int argc, char **argv) {
+    // Optional core clock in GHz, to report cycles instead of nanoseconds
+    double ghz = argc > 1 ? atof(argv[1]) : 0;
+
+    printf("N-Limb Primitive Test Suite with GMP Verification\n");
+    printf("=================================================\n");
+
+    srand((unsigned int)time(NULL));
+
+    run_tests();
+
+    printf("\n========================================\n");
+    printf("Timing (ns per call)\n");
+    printf("========================================\n");
+    run_benchmark();
+    printf("\n");
+    run_multiply_benchmark(ghz);
+
+    printf("\n=== Final Test Summary ===\n");
+    printf("Total tests run: %d\n", total_tests);
+    printf("Tests passed:    %d\n", passed_tests);
+    printf("Tests failed:    %d\n", total_tests - passed_tests);
+    printf("Success rate:    %.2f%%\n", (double)passed_tests / total_tests * 100.0);
+
+    if (passed_tests == total_tests) {
+        printf("🎉 ALL TESTS PASSED! 🎉\n");
+        return 0;
+    } else {
+        printf("❌ SOME TESTS FAILED ❌\n");
+        return 1;
+    }
+}
@@ -0,0 +1,157 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdlib.h>
+#include <time.h>
+#include <gmp.h>
+
+typedef void (*mul_batch_fn)(size_t count, const uint64_t *a, const uint64_t *b, uint64_t *r);
+typedef void (*mul_fn)(const uint64_t *a, const uint64_t *b, uint64_t *r);
+
+#define DECLARE(bits)                                                                               \
+    extern void mul##bits##x##bits##_batch(size_t count, const uint64_t *a, const uint64_t *b, uint64_t *r); \
+    extern void mul##bits##x##bits##_comba(const uint64_t *a, const uint64_t *b, uint64_t *r);
+
+DECLARE(128)
+DECLARE(256)
+DECLARE(384)
+DECLARE(512)
+
+#define ENTRY(bits) { #bits "x" #bits, (bits) / 64, mul##bits##x##bits##_batch, mul##bits##x##bits##_comba }
+
+static const struct {
+    const char *name;
+    int limbs;
+    mul_batch_fn batch;
+    mul_fn single;
+} sizes[] = { ENTRY(128), ENTRY(256), ENTRY(384), ENTRY(512) };
+
+#define NSIZES (int)(sizeof sizes / sizeof sizes[0])
+#define MAX_LIMBS 8
+#define MAX_BATCH (1 << 20)
+#define PRODUCTS_PER_POINT (1 << 22)
+#define GUARD 0x5A5A5A5A5A5A5A5AULL
+
+// Global test counters
+int total_tests = 0;
+int passed_tests = 0;
+
+// Generate random 64-bit number
+uint64_t random_uint64() {
+    return ((uint64_t)rand() << 62) ^ ((uint64_t)rand() << 31) ^ (uint64_t)rand();
+}
+
+// Every product of a batch against mpn_mul_n, and the limb past the last result untouched
+void run_tests() {
+    static const size_t counts[] = { 0, 1, 2, 3, 4, 7, 8, 9, 17, 100, 1000 };
+    static uint64_t a[1000 * MAX_LIMBS], b[1000 * MAX_LIMBS], r[2000 * MAX_LIMBS + 1];
+    mp_limb_t expected[2 * MAX_LIMBS];
+
+    printf("\n========================================\n");
+    printf("Batches of 0 to 1000 products\n");
+    printf("========================================\n");
+
+    for (int s = 0; s < NSIZES; s++) {
+        int n = sizes[s].limbs;
+        int passed = 0, total = 0;
+        for (size_t c = 0; c < sizeof counts / sizeof counts[0]; c++) {
+            size_t count = counts[c];
+            for (size_t i = 0; i < count * n; i++) {
+                a[i] = c % 3 == 1 ? ~0ULL : random_uint64();
+                b[i] = c % 3 == 1 ? ~0ULL : random_uint64();
+            }
+            r[2 * n * count] = GUARD;
+            sizes[s].batch(count, a, b, r);
+            int ok = r[2 * n * count] == GUARD;
+            for (size_t i = 0; i < count; i++) {
+                mpn_mul_n(expected, (const mp_limb_t *)(a + n * i), (const mp_limb_t *)(b + n * i), n);
+                ok &= memcmp(r + 2 * n * i, expected, 16 * n) == 0;
+            }
+            passed += ok;
+            total++;
+            if (!ok) {
+                printf("FAIL: %s, batch of %zu\n", sizes[s].name, count);
+            }
+        }
+        total_tests += total;
+        passed_tests += passed;
+        printf("%s: %d/%d batches passed\n", sizes[s].name, passed, total);
+    }
+}
+
+// ns per product: one batch call of count products against count calls of the Comba kernel
+void run_benchmark() {
+    uint64_t *a = malloc(sizeof(uint64_t) * MAX_BATCH * MAX_LIMBS);
+    uint64_t *b = malloc(sizeof(uint64_t) * MAX_BATCH * MAX_LIMBS);
+    uint64_t *r = malloc(sizeof(uint64_t) * MAX_BATCH * 2 * MAX_LIMBS);
+    struct timespec start, end;
+
+    if (!a || !b || !r) {
+        printf("Benchmark skipped: cannot allocate %d-product batches\n", MAX_BATCH);
+        free(a);
+        free(b);
+        free(r);
+        return;
+    }
+    for (size_t i = 0; i < (size_t)MAX_BATCH * MAX_LIMBS; i++) {
+        a[i] = random_uint64();
+        b[i] = random_uint64();
+    }
+
+    printf("\n========================================\n");
+    printf("ns per product: batch call vs one call per product\n");
+    printf("========================================\n");
+
+    for (int s = 0; s < NSIZES; s++) {
+        int n = sizes[s].limbs;
+        printf("\n%s\n%10s %10s %10s %8s\n", sizes[s].name, "batch", "batch", "calls", "gain");
+        for (size_t count = 1; count <= MAX_BATCH; count *= 4) {
+            size_t repeats = PRODUCTS_PER_POINT / count;
+
+            clock_gettime(CLOCK_MONOTONIC, &start);
+            for (size_t k = 0; k < repeats; k++) {
+                sizes[s].batch(count, a, b, r);
+            }
+            clock_gettime(CLOCK_MONOTONIC, &end);
+            double batch = ((end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec)) / (repeats * count);
+
+            clock_gettime(CLOCK_MONOTONIC, &start);
+            for (size_t k = 0; k < repeats; k++) {
+                for (size_t i = 0; i < count; i++) {
+                    sizes[s].single(a + n * i, b + n * i, r + 2 * n * i);
+                }
+            }
+            clock_gettime(CLOCK_MONOTONIC, &end);
+            double calls = ((end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec)) / (repeats * count);
+
+            printf("%10zu %10.2f %10.2f %7.2fx\n", count, batch, calls, calls / batch);
+        }
+    }
+    free(a);
+    free(b);
+    free(r);
+}
+
+int main() {
+    printf("Batched Multiplication Test Suite with GMP Verification\n");
+    printf("=======================================================\n");
+
+    srand((unsigned int)time(NULL));
+
+    run_tests();
+    run_benchmark();
+
+    printf("\n=== Final Test Summary ===\n");
+    printf("Total tests run: %d\n", total_tests);
+    printf("Tests passed:    %d\n", passed_tests);
+    printf("Tests failed:    %d\n", total_tests - passed_tests);
+    printf("Success rate:    %.2f%%\n", (double)passed_tests / total_tests * 100.0);
+
+    if (passed_tests == total_tests) {
+        printf("🎉 ALL TESTS PASSED! 🎉\n");
+        return 0;
+    } else {
+        printf("❌ SOME TESTS FAILED ❌\n");
+        return 1;
+    }
+}
@@ -14,6 +14,19 @@ extern void mul128x128(uint64_t a[2], uint64_t b[2], uint64_t result[4]);
 extern void mul256x256(uint64_t a[4], uint64_t b[4], uint64_t result[8]);
 extern void mul512x512(uint64_t a[8], uint64_t b[8], uint64_t result[16]);
 
+// Product-scanning (Comba) versions of the same sizes
+extern void mul128x128_comba(uint64_t a[2], uint64_t b[2], uint64_t result[4]);
+extern void mul256x256_comba(uint64_t a[4], uint64_t b[4], uint64_t result[8]);
+extern void mul512x512_comba(uint64_t a[8], uint64_t b[8], uint64_t result[16]);
+
+// Dedicated squarings: each off-diagonal product computed once and doubled
+extern void sqr128(uint64_t a[2], uint64_t result[4]);
+extern void sqr256(uint64_t a[4], uint64_t result[8]);
+extern void sqr512(uint64_t a[8], uint64_t result[16]);
+
+typedef void (*mul_fn)(uint64_t *, uint64_t *, uint64_t *);
+typedef void (*sqr_fn)(uint64_t *, uint64_t *);
+
 // Helper function to print a 128-bit number
 void print_uint128(const char* name, uint64_t high, uint64_t low) {
     printf("%s = 0x%016llx%016llx\n", name, high, low);
@@ -697,6 +710,208 @@ void run_512_bit_tests() {
     test_512_multiplication("512-bit Test 7: High Bits Set", a7, b7);
 }
 
+// Compare a Comba product against GMP's mpn_mul_n; the guard limb catches writes past r[2n)
+int test_comba_silent(mul_fn mul, int n, uint64_t *a, uint64_t *b) {
+    uint64_t result[17];
+    mp_limb_t expected[16];
+
+    result[2 * n] = 0x5A5A5A5A5A5A5A5AULL;
+    mul(a, b, result);
+    mpn_mul_n(expected, (const mp_limb_t *)a, (const mp_limb_t *)b, n);
+
+    total_tests++;
+    int passed = memcmp(result, expected, 16 * n) == 0 && result[2 * n] == 0x5A5A5A5A5A5A5A5AULL;
+    if (passed) {
+        passed_tests++;
+    }
+    return passed;
+}
+
+static const struct {
+    const char *name;
+    mul_fn operand_scanning;
+    mul_fn comba;
+    int limbs;
+} comba_sizes[] = {
+    { "128×128→256",   mul128x128, mul128x128_comba, 2 },
+    { "256×256→512",   mul256x256, mul256x256_comba, 4 },
+    { "512×512→1024",  mul512x512, mul512x512_comba, 8 },
+};
+
+void run_comba_tests() {
+    for (size_t s = 0; s < sizeof comba_sizes / sizeof comba_sizes[0]; s++) {
+        mul_fn mul = comba_sizes[s].comba;
+        int n = comba_sizes[s].limbs;
+        uint64_t a[8], b[8];
+        int before = passed_tests, count = 0;
+
+        printf("\n========================================\n");
+        printf("%s Comba Tests\n", comba_sizes[s].name);
+        printf("========================================\n");
+
+        // Zero, one and all-ones operands
+        memset(a, 0, sizeof a); memset(b, 0xFF, sizeof b);
+        count++; if (!test_comba_silent(mul, n, a, b)) printf("FAIL: zero × max\n");
+        a[0] = 1;
+        count++; if (!test_comba_silent(mul, n, a, b)) printf("FAIL: one × max\n");
+        memset(a, 0xFF, sizeof a);
+        count++; if (!test_comba_silent(mul, n, a, b)) printf("FAIL: max × max\n");
+
+        // Single bits at every limb boundary land in every column
+        for (int i = 0; i < n; i++) {
+            for (int j = 0; j < n; j++) {
+                memset(a, 0, sizeof a); memset(b, 0, sizeof b);
+                a[i] = 0x8000000000000000ULL;
+                b[j] = 0xFFFFFFFFFFFFFFFFULL;
+                count++; if (!test_comba_silent(mul, n, a, b)) printf("FAIL: a[%d] × b[%d]\n", i, j);
+            }
+        }
+
+        for (int t = 0; t < 100; t++) {
+            for (int i = 0; i < n; i++) {
+                a[i] = random_uint64();
+                b[i] = random_uint64();
+            }
+            count++; if (!test_comba_silent(mul, n, a, b)) printf("FAIL: random test %d\n", t);
+        }
+
+        printf("Comba tests: %d/%d passed\n", passed_tests - before, count);
+    }
+}
+
+// Time operand scanning against product scanning on the same inputs
+double time_mul(mul_fn mul, uint64_t *a, uint64_t *b, uint64_t *result, int iterations) {
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < iterations; i++) {
+        mul(a, b, result);
+        a[0] ^= result[0];      // keep the calls dependent so none are hoisted
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return ((end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec)) / iterations;
+}
+
+void run_comba_benchmark() {
+    const int iterations = 1000000;
+
+    printf("\n========================================\n");
+    printf("Operand Scanning vs Comba (ns per call)\n");
+    printf("========================================\n");
+    printf("%-16s %16s %10s %9s\n", "size", "operand scanning", "Comba", "speedup");
+
+    for (size_t s = 0; s < sizeof comba_sizes / sizeof comba_sizes[0]; s++) {
+        uint64_t a[8], b[8], result[16];
+        for (int i = 0; i < 8; i++) {
+            a[i] = random_uint64();
+            b[i] = random_uint64();
+        }
+        double scanning = time_mul(comba_sizes[s].operand_scanning, a, b, result, iterations);
+        double comba = time_mul(comba_sizes[s].comba, a, b, result, iterations);
+        printf("%-16s %16.2f %10.2f %8.2fx\n", comba_sizes[s].name, scanning, comba, scanning / comba);
+    }
+}
+
+// Compare a square against GMP's mpn_sqr; the guard limb catches writes past r[2n)
+int test_sqr_silent(sqr_fn sqr, int n, uint64_t *a) {
+    uint64_t result[17];
+    mp_limb_t expected[16];
+
+    result[2 * n] = 0x5A5A5A5A5A5A5A5AULL;
+    sqr(a, result);
+    mpn_sqr(expected, (const mp_limb_t *)a, n);
+
+    total_tests++;
+    int passed = memcmp(result, expected, 16 * n) == 0 && result[2 * n] == 0x5A5A5A5A5A5A5A5AULL;
+    if (passed) {
+        passed_tests++;
+    }
+    return passed;
+}
+
+static const struct {
+    const char *name;
+    sqr_fn sqr;
+    mul_fn mul;
+    int limbs;
+} sqr_sizes[] = {
+    { "128→256",   sqr128, mul128x128_comba, 2 },
+    { "256→512",   sqr256, mul256x256_comba, 4 },
+    { "512→1024",  sqr512, mul512x512_comba, 8 },
+};
+
+void run_sqr_tests() {
+    for (size_t s = 0; s < sizeof sqr_sizes / sizeof sqr_sizes[0]; s++) {
+        sqr_fn sqr = sqr_sizes[s].sqr;
+        int n = sqr_sizes[s].limbs;
+        uint64_t a[8];
+        int before = passed_tests, count = 0;
+
+        printf("\n========================================\n");
+        printf("%s Squaring Tests\n", sqr_sizes[s].name);
+        printf("========================================\n");
+
+        // Zero, one, all ones and the doubled top bit of every off-diagonal product
+        memset(a, 0, sizeof a);
+        count++; if (!test_sqr_silent(sqr, n, a)) printf("FAIL: zero\n");
+        a[0] = 1;
+        count++; if (!test_sqr_silent(sqr, n, a)) printf("FAIL: one\n");
+        memset(a, 0xFF, sizeof a);
+        count++; if (!test_sqr_silent(sqr, n, a)) printf("FAIL: max\n");
+        a[0] = 0xFFFFFFFFFFFFFFFEULL;
+        count++; if (!test_sqr_silent(sqr, n, a)) printf("FAIL: max - 1\n");
+
+        // Two set limbs: a single off-diagonal product plus two diagonal squares
+        for (int i = 0; i < n; i++) {
+            for (int j = i; j < n; j++) {
+                memset(a, 0, sizeof a);
+                a[i] = 0xFFFFFFFFFFFFFFFFULL;
+                a[j] = 0x8000000000000001ULL;
+                count++; if (!test_sqr_silent(sqr, n, a)) printf("FAIL: a[%d], a[%d] set\n", i, j);
+            }
+        }
+
+        for (int t = 0; t < 100; t++) {
+            for (int i = 0; i < n; i++) {
+                a[i] = random_uint64();
+            }
+            count++; if (!test_sqr_silent(sqr, n, a)) printf("FAIL: random test %d\n", t);
+        }
+
+        printf("Squaring tests: %d/%d passed\n", passed_tests - before, count);
+    }
+}
+
+// Time a squaring against the multiplier called with both operands equal
+double time_sqr(sqr_fn sqr, uint64_t *a, uint64_t *result, int iterations) {
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < iterations; i++) {
+        sqr(a, result);
+        a[0] ^= result[0];      // keep the calls dependent so none are hoisted
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return ((end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec)) / iterations;
+}
+
+void run_sqr_benchmark() {
+    const int iterations = 1000000;
+
+    printf("\n========================================\n");
+    printf("Squaring vs mul(a, a) (ns per call)\n");
+    printf("========================================\n");
+    printf("%-16s %10s %10s %9s\n", "size", "mul(a, a)", "sqr(a)", "speedup");
+
+    for (size_t s = 0; s < sizeof sqr_sizes / sizeof sqr_sizes[0]; s++) {
+        uint64_t a[8], result[16];
+        for (int i = 0; i < 8; i++) {
+            a[i] = random_uint64();
+        }
+        double mul = time_mul(sqr_sizes[s].mul, a, a, result, iterations);
+        double sqr = time_sqr(sqr_sizes[s].sqr, a, result, iterations);
+        printf("%-16s %10.2f %10.2f %8.2fx\n", sqr_sizes[s].name, mul, sqr, mul / sqr);
+    }
+}
+
 int main() {
     printf("Combined Bignum Multiplication Test Suite with GMP Verification\n");
     printf("==============================================================\n");
@@ -723,6 +938,14 @@ int main() {
     run_256_bit_random_tests();
     run_512_bit_random_tests();
     
+    // Product scanning: correctness, then a comparison with operand scanning
+    run_comba_tests();
+    run_comba_benchmark();
+    
+    // Dedicated squaring against GMP, then against mul(a, a)
+    run_sqr_tests();
+    run_sqr_benchmark();
+    
     printf("\n=== Final Test Summary ===\n");
     printf("Total tests run: %d\n", total_tests);
     printf("Tests passed:    %d\n", passed_tests);
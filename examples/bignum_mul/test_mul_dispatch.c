@@ -0,0 +1,93 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdlib.h>
+#include <time.h>
+#include <gmp.h>
+
+#include "mul_dispatch.h"
+
+// Global test counters
+int total_tests = 0;
+int passed_tests = 0;
+
+#define MAX_LIMBS (MUL_DISPATCH_MAX + 32)
+#define CHECKS 20
+#define GUARD 0x5A5A5A5A5A5A5A5AULL
+
+// Generate random 64-bit number
+uint64_t random_uint64() {
+    return ((uint64_t)rand() << 62) ^ ((uint64_t)rand() << 31) ^ (uint64_t)rand();
+}
+
+// Random operands, every third pair all ones to run the carries the whole length
+void fill(uint64_t *a, uint64_t *b, size_t n, int t) {
+    for (size_t i = 0; i < n; i++) {
+        a[i] = t % 3 == 1 ? ~0ULL : random_uint64();
+        b[i] = t % 3 == 1 ? ~0ULL : random_uint64();
+    }
+}
+
+// Every n through the table and past its end, against mpn_mul_n
+void run_tests() {
+    static uint64_t a[MAX_LIMBS], b[MAX_LIMBS], r[2 * MAX_LIMBS + 1];
+    static mp_limb_t expected[2 * MAX_LIMBS];
+
+    printf("\n========================================\n");
+    printf("mul_dispatch, 1 to %d limbs\n", MAX_LIMBS);
+    printf("========================================\n");
+
+    for (size_t n = 1; n <= MAX_LIMBS; n++) {
+        int passed = 0;
+        for (int t = 0; t < CHECKS; t++) {
+            fill(a, b, n, t);
+            r[2 * n] = GUARD;
+            mul_dispatch(n, r, a, b);
+            mpn_mul_n(expected, (const mp_limb_t *)a, (const mp_limb_t *)b, n);
+            passed += memcmp(r, expected, 16 * n) == 0 && r[2 * n] == GUARD;
+        }
+        total_tests += CHECKS;
+        passed_tests += passed;
+        if (passed != CHECKS) {
+            printf("FAIL: n = %zu (%s), %d/%d\n", n, n <= MUL_DISPATCH_MAX && mul_table[n] ? "table" : "basecase",
+                   passed, CHECKS);
+        }
+    }
+    printf("Sizes 1-%d: %d/%d passed\n", MAX_LIMBS, passed_tests, total_tests);
+}
+
+void print_thresholds() {
+    printf("Thresholds: comba %zu, karatsuba %zu, toom3 %zu (SIZE_MAX: never chosen)\n",
+           (size_t)MUL_COMBA_THRESHOLD, (size_t)MUL_KARATSUBA_THRESHOLD, (size_t)MUL_TOOM3_THRESHOLD);
+    printf("Table entries:");
+    for (size_t n = 0; n <= MUL_DISPATCH_MAX; n++) {
+        if (mul_table[n]) {
+            printf(" %zu", n);
+        }
+    }
+    printf("\n");
+}
+
+int main() {
+    printf("Multiplication Dispatch Test Suite with GMP Verification\n");
+    printf("========================================================\n");
+
+    srand((unsigned int)time(NULL));
+
+    print_thresholds();
+    run_tests();
+
+    printf("\n=== Final Test Summary ===\n");
+    printf("Total tests run: %d\n", total_tests);
+    printf("Tests passed:    %d\n", passed_tests);
+    printf("Tests failed:    %d\n", total_tests - passed_tests);
+    printf("Success rate:    %.2f%%\n", (double)passed_tests / total_tests * 100.0);
+
+    if (passed_tests == total_tests) {
+        printf("🎉 ALL TESTS PASSED! 🎉\n");
+        return 0;
+    } else {
+        printf("❌ SOME TESTS FAILED ❌\n");
+        return 1;
+    }
+}
@@ -0,0 +1,167 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdlib.h>
+#include <time.h>
+#include <gmp.h>
+
+typedef const uint64_t *in;
+typedef uint64_t *out;
+
+typedef void (*mul_x1_fn)(in, in, out);
+typedef void (*mul_x2_fn)(in, in, out, in, in, out);
+typedef void (*mul_x4_fn)(in, in, out, in, in, out, in, in, out, in, in, out);
+
+#define DECLARE(bits)                                                               \
+    extern void mul##bits##x##bits##_x1(in, in, out);                               \
+    extern void mul##bits##x##bits##_x2(in, in, out, in, in, out);                  \
+    extern void mul##bits##x##bits##_x4(in, in, out, in, in, out, in, in, out, in, in, out);
+
+DECLARE(128)
+DECLARE(256)
+DECLARE(384)
+DECLARE(512)
+
+#define ENTRY(bits) { #bits "x" #bits, (bits) / 64, mul##bits##x##bits##_x1, \
+                      mul##bits##x##bits##_x2, mul##bits##x##bits##_x4 }
+
+static const struct {
+    const char *name;
+    int limbs;
+    mul_x1_fn x1;
+    mul_x2_fn x2;
+    mul_x4_fn x4;
+} sizes[] = { ENTRY(128), ENTRY(256), ENTRY(384), ENTRY(512) };
+
+#define NSIZES (int)(sizeof sizes / sizeof sizes[0])
+#define MAX_LIMBS 8
+#define WAYS 4
+#define CHECKS 1000
+#define GUARD 0x5A5A5A5A5A5A5A5AULL
+
+// Global test counters
+int total_tests = 0;
+int passed_tests = 0;
+
+// Generate random 64-bit number
+uint64_t random_uint64() {
+    return ((uint64_t)rand() << 62) ^ ((uint64_t)rand() << 31) ^ (uint64_t)rand();
+}
+
+// k operand pairs; every fourth check runs all ones through the carries
+void fill(uint64_t a[][MAX_LIMBS], uint64_t b[][MAX_LIMBS], int n, int t) {
+    for (int c = 0; c < WAYS; c++) {
+        for (int i = 0; i < n; i++) {
+            a[c][i] = t % 4 == 1 ? ~0ULL : random_uint64();
+            b[c][i] = t % 4 == 1 ? ~0ULL : random_uint64();
+        }
+    }
+}
+
+// Every product of one call against mpn_mul_n, with a guard limb past each result
+int check(uint64_t a[][MAX_LIMBS], uint64_t b[][MAX_LIMBS], uint64_t r[][2 * MAX_LIMBS + 1], int n, int k) {
+    mp_limb_t expected[2 * MAX_LIMBS];
+    int ok = 1;
+    for (int c = 0; c < k; c++) {
+        mpn_mul_n(expected, (const mp_limb_t *)a[c], (const mp_limb_t *)b[c], n);
+        ok &= memcmp(r[c], expected, 16 * n) == 0 && r[c][2 * n] == GUARD;
+    }
+    return ok;
+}
+
+void run_tests() {
+    static uint64_t a[WAYS][MAX_LIMBS], b[WAYS][MAX_LIMBS], r[WAYS][2 * MAX_LIMBS + 1];
+
+    printf("\n========================================\n");
+    printf("One, two and four products per call\n");
+    printf("========================================\n");
+
+    for (int s = 0; s < NSIZES; s++) {
+        int n = sizes[s].limbs;
+        int passed[3] = { 0, 0, 0 };
+        for (int t = 0; t < CHECKS; t++) {
+            fill(a, b, n, t);
+            for (int c = 0; c < WAYS; c++) {
+                r[c][2 * n] = GUARD;
+            }
+            sizes[s].x1(a[0], b[0], r[0]);
+            passed[0] += check(a, b, r, n, 1);
+            sizes[s].x2(a[0], b[0], r[0], a[1], b[1], r[1]);
+            passed[1] += check(a, b, r, n, 2);
+            sizes[s].x4(a[0], b[0], r[0], a[1], b[1], r[1], a[2], b[2], r[2], a[3], b[3], r[3]);
+            passed[2] += check(a, b, r, n, 4);
+        }
+        total_tests += 3 * CHECKS;
+        passed_tests += passed[0] + passed[1] + passed[2];
+        printf("%s: x1 %d/%d, x2 %d/%d, x4 %d/%d\n", sizes[s].name,
+               passed[0], CHECKS, passed[1], CHECKS, passed[2], CHECKS);
+    }
+}
+
+// Four independent products per iteration: four x1 calls, two x2 calls, one x4 call
+void run_benchmark() {
+    static uint64_t a[WAYS][MAX_LIMBS], b[WAYS][MAX_LIMBS], r[WAYS][2 * MAX_LIMBS + 1];
+    const int iterations = 1000000;
+    struct timespec start, end;
+    double ns[3];
+
+    printf("\n========================================\n");
+    printf("ns per product (four independent products per iteration)\n");
+    printf("========================================\n");
+    printf("%-10s %8s %8s %8s %10s\n", "size", "x1", "x2", "x4", "x4 gain");
+
+    for (int s = 0; s < NSIZES; s++) {
+        int n = sizes[s].limbs;
+        fill(a, b, n, 0);
+
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for (int i = 0; i < iterations; i++) {
+            for (int c = 0; c < WAYS; c++) {
+                sizes[s].x1(a[c], b[c], r[c]);
+            }
+        }
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        ns[0] = ((end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec)) / iterations / WAYS;
+
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for (int i = 0; i < iterations; i++) {
+            sizes[s].x2(a[0], b[0], r[0], a[1], b[1], r[1]);
+            sizes[s].x2(a[2], b[2], r[2], a[3], b[3], r[3]);
+        }
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        ns[1] = ((end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec)) / iterations / WAYS;
+
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for (int i = 0; i < iterations; i++) {
+            sizes[s].x4(a[0], b[0], r[0], a[1], b[1], r[1], a[2], b[2], r[2], a[3], b[3], r[3]);
+        }
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        ns[2] = ((end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec)) / iterations / WAYS;
+
+        printf("%-10s %8.2f %8.2f %8.2f %9.2fx\n", sizes[s].name, ns[0], ns[1], ns[2], ns[0] / ns[2]);
+    }
+}
+
+int main() {
+    printf("Interleaved Multiplication Test Suite with GMP Verification\n");
+    printf("===========================================================\n");
+
+    srand((unsigned int)time(NULL));
+
+    run_tests();
+    run_benchmark();
+
+    printf("\n=== Final Test Summary ===\n");
+    printf("Total tests run: %d\n", total_tests);
+    printf("Tests passed:    %d\n", passed_tests);
+    printf("Tests failed:    %d\n", total_tests - passed_tests);
+    printf("Success rate:    %.2f%%\n", (double)passed_tests / total_tests * 100.0);
+
+    if (passed_tests == total_tests) {
+        printf("🎉 ALL TESTS PASSED! 🎉\n");
+        return 0;
+    } else {
+        printf("❌ SOME TESTS FAILED ❌\n");
+        return 1;
+    }
+}
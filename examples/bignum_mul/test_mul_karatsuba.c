@@ -0,0 +1,161 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdlib.h>
+#include <time.h>
+#include <gmp.h>
+
+// Global test counters
+int total_tests = 0;
+int passed_tests = 0;
+
+// Karatsuba multipliers generated by demo_mul_karatsuba.py
+extern void mul512x512_karatsuba(const uint64_t a[8], const uint64_t b[8], uint64_t result[16]);
+extern void mul1024x1024_karatsuba(const uint64_t a[16], const uint64_t b[16], uint64_t result[32]);
+extern void mul2048x2048_karatsuba(const uint64_t a[32], const uint64_t b[32], uint64_t result[64]);
+extern void mul4096x4096_karatsuba(const uint64_t a[64], const uint64_t b[64], uint64_t result[128]);
+
+typedef void (*mul_fn)(const uint64_t *, const uint64_t *, uint64_t *);
+
+#define MAX_LIMBS 64
+#define RANDOM_TESTS 1000
+
+// Generate random 64-bit number
+uint64_t random_uint64() {
+    return ((uint64_t)rand() << 62) ^ ((uint64_t)rand() << 31) ^ (uint64_t)rand();
+}
+
+// Compare one product against GMP's mpn_mul_n; the guard limb catches writes past r[2n)
+int check_product(mul_fn mul, int n, const uint64_t *a, const uint64_t *b) {
+    uint64_t result[2 * MAX_LIMBS + 1];
+    mp_limb_t expected[2 * MAX_LIMBS];
+
+    result[2 * n] = 0x5A5A5A5A5A5A5A5AULL;
+    mul(a, b, result);
+    mpn_mul_n(expected, (const mp_limb_t *)a, (const mp_limb_t *)b, n);
+
+    total_tests++;
+    if (memcmp(result, expected, 16 * n) == 0 && result[2 * n] == 0x5A5A5A5A5A5A5A5AULL) {
+        passed_tests++;
+        return 1;
+    }
+    return 0;
+}
+
+// Operand with halves ordered so that the Karatsuba difference at the top level has a chosen sign
+void fill_ordered(uint64_t *x, int n, int low_half_larger) {
+    int h = n / 2;
+    for (int i = 0; i < n; i++) {
+        x[i] = random_uint64();
+    }
+    // Decide the comparison in the most significant limb of each half
+    x[h - 1] = low_half_larger ? (x[h - 1] | 0x8000000000000000ULL) : (x[h - 1] & 0x7FFFFFFFFFFFFFFFULL);
+    x[n - 1] = low_half_larger ? (x[n - 1] & 0x7FFFFFFFFFFFFFFFULL) : (x[n - 1] | 0x8000000000000000ULL);
+}
+
+void run_edge_cases(const char *name, mul_fn mul, int n) {
+    uint64_t a[MAX_LIMBS], b[MAX_LIMBS];
+    int before = passed_tests, count = 0;
+
+    printf("\n========================================\n");
+    printf("%s Edge Cases\n", name);
+    printf("========================================\n");
+
+    // Zero, one, all ones
+    memset(a, 0, sizeof a); memset(b, 0xFF, sizeof b);
+    count++; if (!check_product(mul, n, a, b)) printf("FAIL: zero × max\n");
+    a[0] = 1;
+    count++; if (!check_product(mul, n, a, b)) printf("FAIL: one × max\n");
+    memset(a, 0xFF, sizeof a);
+    count++; if (!check_product(mul, n, a, b)) printf("FAIL: max × max\n");
+
+    // Equal halves: both differences are zero
+    for (int i = 0; i < n / 2; i++) {
+        a[i] = a[i + n / 2] = random_uint64();
+        b[i] = b[i + n / 2] = random_uint64();
+    }
+    count++; if (!check_product(mul, n, a, b)) printf("FAIL: equal halves\n");
+
+    // Single bits at every limb boundary
+    for (int i = 0; i < n; i++) {
+        memset(a, 0, sizeof a); memset(b, 0, sizeof b);
+        a[i] = 0x8000000000000000ULL;
+        b[n - 1 - i] = 1;
+        count++; if (!check_product(mul, n, a, b)) printf("FAIL: single bits at limb %d\n", i);
+    }
+
+    // All four sign combinations of the middle term, with all-ones lower limbs for long carries
+    for (int sa = 0; sa < 2; sa++) {
+        for (int sb = 0; sb < 2; sb++) {
+            fill_ordered(a, n, sa);
+            fill_ordered(b, n, sb);
+            count++; if (!check_product(mul, n, a, b)) printf("FAIL: signs (%d, %d)\n", sa, sb);
+            for (int i = 0; i < n - 1; i++) {
+                a[i] = b[i] = 0xFFFFFFFFFFFFFFFFULL;
+            }
+            count++; if (!check_product(mul, n, a, b)) printf("FAIL: signs (%d, %d) with all-ones lower limbs\n", sa, sb);
+        }
+    }
+
+    printf("Edge cases: %d/%d passed\n", passed_tests - before, count);
+}
+
+void run_random_tests(const char *name, mul_fn mul, int n) {
+    uint64_t a[MAX_LIMBS], b[MAX_LIMBS];
+    int random_passed = 0;
+
+    printf("\n========================================\n");
+    printf("%s Random Tests (%d tests)\n", name, RANDOM_TESTS);
+    printf("========================================\n");
+
+    for (int t = 0; t < RANDOM_TESTS; t++) {
+        for (int i = 0; i < n; i++) {
+            a[i] = random_uint64();
+            b[i] = random_uint64();
+        }
+        if (check_product(mul, n, a, b)) {
+            random_passed++;
+        } else if (t + 1 - random_passed <= 10) {   // report the first few failures only
+            printf("FAIL: random test %d\n", t);
+        }
+    }
+
+    printf("Random tests: %d/%d random tests passed\n", random_passed, RANDOM_TESTS);
+}
+
+int main() {
+    static const struct {
+        const char *name;
+        mul_fn mul;
+        int limbs;
+    } sizes[] = {
+        { "512×512→1024 Karatsuba",   mul512x512_karatsuba,   8 },
+        { "1024×1024→2048 Karatsuba", mul1024x1024_karatsuba, 16 },
+        { "2048×2048→4096 Karatsuba", mul2048x2048_karatsuba, 32 },
+        { "4096×4096→8192 Karatsuba", mul4096x4096_karatsuba, 64 },
+    };
+
+    printf("Karatsuba Multiplication Test Suite with GMP Verification\n");
+    printf("==========================================================\n");
+
+    srand((unsigned int)time(NULL));
+
+    for (size_t s = 0; s < sizeof sizes / sizeof sizes[0]; s++) {
+        run_edge_cases(sizes[s].name, sizes[s].mul, sizes[s].limbs);
+        run_random_tests(sizes[s].name, sizes[s].mul, sizes[s].limbs);
+    }
+
+    printf("\n=== Final Test Summary ===\n");
+    printf("Total tests run: %d\n", total_tests);
+    printf("Tests passed:    %d\n", passed_tests);
+    printf("Tests failed:    %d\n", total_tests - passed_tests);
+    printf("Success rate:    %.2f%%\n", (double)passed_tests / total_tests * 100.0);
+
+    if (passed_tests == total_tests) {
+        printf("🎉 ALL TESTS PASSED! 🎉\n");
+        return 0;
+    } else {
+        printf("❌ SOME TESTS FAILED ❌\n");
+        return 1;
+    }
+}
@@ -0,0 +1,205 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdlib.h>
+#include <time.h>
+#include <gmp.h>
+
+typedef void (*neon_mul_fn)(const uint32_t *a, const uint32_t *b, uint32_t *r);
+typedef void (*mul_fn)(const uint64_t *a, const uint64_t *b, uint64_t *r);
+
+#define DECLARE(bits, w)                                                               \
+    extern void neon_mul##bits##_r##w##_x2(const uint32_t *a, const uint32_t *b, uint32_t *r); \
+    extern void neon_mul##bits##_r##w##_x4(const uint32_t *a, const uint32_t *b, uint32_t *r);
+
+DECLARE(128, 32)
+DECLARE(128, 29)
+DECLARE(128, 26)
+DECLARE(256, 32)
+DECLARE(256, 29)
+DECLARE(256, 26)
+
+extern void mul128x128_comba(const uint64_t *a, const uint64_t *b, uint64_t *r);
+extern void mul256x256_comba(const uint64_t *a, const uint64_t *b, uint64_t *r);
+
+#define ENTRY(bits, w, k) { "neon_mul" #bits "_r" #w "_x" #k, bits, w, k, neon_mul##bits##_r##w##_x##k }
+
+static const struct {
+    const char *name;
+    int bits;
+    int radix;      // limbs of radix 2^radix, one per 32-bit lane
+    int ways;
+    neon_mul_fn mul;
+} kernels[] = {
+    ENTRY(128, 32, 2), ENTRY(128, 32, 4), ENTRY(128, 29, 2), ENTRY(128, 29, 4), ENTRY(128, 26, 2), ENTRY(128, 26, 4),
+    ENTRY(256, 32, 2), ENTRY(256, 32, 4), ENTRY(256, 29, 2), ENTRY(256, 29, 4), ENTRY(256, 26, 2), ENTRY(256, 26, 4),
+};
+
+#define NKERNELS (int)(sizeof kernels / sizeof kernels[0])
+#define MAX_WORDS 4                 // 64-bit words of the largest operand
+#define MAX_LIMBS 10                // radix-2^w limbs of the largest operand
+#define WAYS 4
+#define CHECKS 2000
+#define GUARD 0x5A5A5A5AU
+
+// Global test counters
+int total_tests = 0;
+int passed_tests = 0;
+
+// Generate random 64-bit number
+uint64_t random_uint64() {
+    return ((uint64_t)rand() << 62) ^ ((uint64_t)rand() << 31) ^ (uint64_t)rand();
+}
+
+int limb_count(int bits, int w) {
+    return (bits + w - 1) / w;
+}
+
+// Bits [pos, pos + w) of x (words 64-bit limbs, zero beyond)
+uint32_t get_bits(const uint64_t *x, int words, int pos, int w) {
+    uint64_t v = 0;
+    int word = pos / 64, shift = pos % 64;
+    if (word < words) {
+        v = x[word] >> shift;
+        if (shift && word + 1 < words) {
+            v |= x[word + 1] << (64 - shift);
+        }
+    }
+    return (uint32_t)(v & ((1ULL << w) - 1));
+}
+
+// Lane `lane` of a transposed radix-2^w operand from words 64-bit limbs
+void to_radix(uint32_t *t, const uint64_t *x, int words, int w, int k, int lane) {
+    for (int i = 0; i < limb_count(64 * words, w); i++) {
+        t[k * i + lane] = get_bits(x, words, w * i, w);
+    }
+}
+
+// Back to 64-bit limbs; 0 if a limb is not below 2^w or sets bits above the words
+int from_radix(uint64_t *x, int words, const uint32_t *t, int limbs, int w, int k, int lane) {
+    memset(x, 0, 8 * words);
+    for (int i = 0; i < limbs; i++) {
+        uint64_t v = t[k * i + lane];
+        int pos = w * i;
+        if (w < 32 && v >> w) {
+            return 0;
+        }
+        if (pos >= 64 * words || (pos + w > 64 * words && v >> (64 * words - pos))) {
+            if (v) {
+                return 0;       // the product does not fit: a limb above the top word is set
+            }
+            continue;
+        }
+        x[pos / 64] |= v << (pos % 64);
+        if (pos % 64 && pos / 64 + 1 < words) {
+            x[pos / 64 + 1] |= v >> (64 - pos % 64);
+        }
+    }
+    return 1;
+}
+
+void run_tests() {
+    uint64_t a[WAYS][MAX_WORDS], b[WAYS][MAX_WORDS], got[2 * MAX_WORDS];
+    mp_limb_t expected[2 * MAX_WORDS];
+    uint32_t ta[WAYS * MAX_LIMBS], tb[WAYS * MAX_LIMBS], tr[WAYS * 2 * MAX_LIMBS + 1];
+
+    printf("\n========================================\n");
+    printf("NEON lanes against mpn_mul_n\n");
+    printf("========================================\n");
+
+    for (int s = 0; s < NKERNELS; s++) {
+        int words = kernels[s].bits / 64, w = kernels[s].radix, k = kernels[s].ways;
+        int n = limb_count(kernels[s].bits, w);
+        int passed = 0;
+        for (int t = 0; t < CHECKS; t++) {
+            for (int l = 0; l < k; l++) {
+                for (int i = 0; i < words; i++) {
+                    a[l][i] = t % 4 == 1 ? ~0ULL : random_uint64();
+                    b[l][i] = t % 4 == 1 ? ~0ULL : random_uint64();
+                }
+                to_radix(ta, a[l], words, w, k, l);
+                to_radix(tb, b[l], words, w, k, l);
+            }
+            tr[2 * n * k] = GUARD;
+            kernels[s].mul(ta, tb, tr);
+            int ok = tr[2 * n * k] == GUARD;
+            for (int l = 0; l < k; l++) {
+                mpn_mul_n(expected, (const mp_limb_t *)a[l], (const mp_limb_t *)b[l], words);
+                ok &= from_radix(got, 2 * words, tr, 2 * n, w, k, l) && memcmp(got, expected, 16 * words) == 0;
+            }
+            passed += ok;
+        }
+        total_tests += CHECKS;
+        passed_tests += passed;
+        printf("%-22s %2d limbs: %d/%d passed\n", kernels[s].name, n, passed, CHECKS);
+    }
+}
+
+// ns per product: one NEON call covers k products; the baseline is one Comba call each
+void run_benchmark() {
+    static uint64_t a[MAX_WORDS], b[MAX_WORDS], r[2 * MAX_WORDS];
+    static uint32_t ta[WAYS * MAX_LIMBS], tb[WAYS * MAX_LIMBS], tr[WAYS * 2 * MAX_LIMBS];
+    const int iterations = 2000000;
+    struct timespec start, end;
+
+    printf("\n========================================\n");
+    printf("ns per product (radix conversion not included)\n");
+    printf("========================================\n");
+
+    for (int i = 0; i < MAX_WORDS; i++) {
+        a[i] = random_uint64();
+        b[i] = random_uint64();
+    }
+    for (int i = 0; i < WAYS * MAX_LIMBS; i++) {
+        ta[i] = (uint32_t)rand() & 0x3FFFFFF;
+        tb[i] = (uint32_t)rand() & 0x3FFFFFF;
+    }
+
+    for (int bits = 128; bits <= 256; bits *= 2) {
+        mul_fn comba = bits == 128 ? mul128x128_comba : mul256x256_comba;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for (int i = 0; i < iterations; i++) {
+            comba(a, b, r);
+        }
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        double scalar = ((end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec)) / iterations;
+        printf("\nmul%dx%d_comba          %8.2f\n", bits, bits, scalar);
+
+        for (int s = 0; s < NKERNELS; s++) {
+            if (kernels[s].bits != bits) {
+                continue;
+            }
+            clock_gettime(CLOCK_MONOTONIC, &start);
+            for (int i = 0; i < iterations; i++) {
+                kernels[s].mul(ta, tb, tr);
+            }
+            clock_gettime(CLOCK_MONOTONIC, &end);
+            double ns = ((end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec)) / iterations / kernels[s].ways;
+            printf("%-22s %8.2f  (%.2fx Comba)\n", kernels[s].name, ns, scalar / ns);
+        }
+    }
+}
+
+int main() {
+    printf("NEON Radix-2^w Multiplication Test Suite with GMP Verification\n");
+    printf("==============================================================\n");
+
+    srand((unsigned int)time(NULL));
+
+    run_tests();
+    run_benchmark();
+
+    printf("\n=== Final Test Summary ===\n");
+    printf("Total tests run: %d\n", total_tests);
+    printf("Tests passed:    %d\n", passed_tests);
+    printf("Tests failed:    %d\n", total_tests - passed_tests);
+    printf("Success rate:    %.2f%%\n", (double)passed_tests / total_tests * 100.0);
+
+    if (passed_tests == total_tests) {
+        printf("🎉 ALL TESTS PASSED! 🎉\n");
+        return 0;
+    } else {
+        printf("❌ SOME TESTS FAILED ❌\n");
+        return 1;
+    }
+}
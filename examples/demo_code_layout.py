@@ -0,0 +1,69 @@
+#!/usr/bin/env python3
+"""
+Code Layout Demo - ArmAsmGen
+
+Generates the mpn_addmul_1-style row loop
+
+    uint64_t addmul_1(uint64_t *rp, const uint64_t *up, size_t n, uint64_t v)
+        rp[0..n) += up[0..n) * v, returns the carry limb
+
+with a placement policy: the function lives in .text.hot with a
+fetch-aligned entry, the loop head is aligned when it costs at most a
+few nops, and the n == 0 early exit is moved out of line to .text.unlikely.
+
+Features demonstrated:
+- ASMCode(label=..., align=policy, section=HOT)
+- Loop heads inheriting the policy (.p2align N,,max_skip)
+- ColdBlock for rarely taken paths
+
+Usage:
+    python examples/demo_code_layout.py [fetch16|fetch32|fetch64]
+"""
+
+import sys
+
+from armasmgen import BackgroundCode, ASMCode, ColdBlock, Loop, x_reg
+from armasmgen.layout import FETCH16, FETCH32, FETCH64, HOT
+
+POLICIES = {"fetch16": FETCH16, "fetch32": FETCH32, "fetch64": FETCH64}
+
+
+def create_addmul_1(policy, name: str = "addmul_1_hot"):
+    """Row loop rp[] += up[] * v placed according to the policy."""
+    rp, up, n, v = x_reg(0), x_reg(1), x_reg(2), x_reg(3)
+    a, r, lo, hi, carry = x_reg(4), x_reg(5), x_reg(6), x_reg(7), x_reg(8)
+
+    with ASMCode(label=name, align=policy, section=HOT) as f:
+        f.CBZ(n, f"{name}_empty")
+        f.MOV(carry, "xzr")
+        with Loop(n, label=f"{name}_row", unroll=2) as lp:
+            lp.LDR_post(a, up, 8)
+            lp.LDR(r, rp)
+            lp.MUL(lo, a, v)
+            lp.UMULH(hi, a, v)
+            lp.ADDS(lo, lo, r)
+            lp.ADCS(hi, hi, "xzr")
+            lp.ADDS(lo, lo, carry)
+            lp.ADCS(carry, hi, "xzr")
+            lp.STR_post(lo, rp, 8)
+        f.MOV(x_reg(0), carry)
+        with ColdBlock(label=f"{name}_empty") as c:
+            c.MOV(x_reg(0), "xzr")
+            c.RET()
+    return f
+
+
+def main():
+    policy = POLICIES[sys.argv[1] if len(sys.argv) > 1 else "fetch32"]
+
+    f = BackgroundCode()
+    with f:
+        create_addmul_1(policy)
+
+    f.stdout()
+    f.export_to_file("addmul_1_layout.s")
+    print("\n✓ Exported to addmul_1_layout.s")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,86 @@
+#!/usr/bin/env python3
+"""
+Loop Unrolling Demo - ArmAsmGen
+
+Generates an mpn_addmul_1-style row loop
+
+    uint64_t addmul_1(uint64_t *rp, const uint64_t *up, size_t n, uint64_t v)
+        rp[0..n) += up[0..n) * v, returns the carry limb
+
+for several unroll factors, so a benchmark can pick the best one per core.
+
+Features demonstrated:
+- Loop(counter, label=..., unroll=k) with a runtime trip count
+- Post-index pointer increments folded into one update per unrolled iteration
+- Remainder loop for trip counts not divisible by k
+- Peeled remainder when the trip count is known at generation time
+
+Usage:
+    python examples/demo_loop_unroll.py [unroll ...]
+"""
+
+import sys
+from typing import Optional
+
+from armasmgen import BackgroundCode, ASMCode, Loop, x_reg
+
+
+def create_addmul_1(unroll: int, name: Optional[str] = None):
+    """Row loop rp[] += up[] * v with the given unroll factor."""
+    name = name or f"addmul_1_u{unroll}"
+    rp, up, n, v = x_reg(0), x_reg(1), x_reg(2), x_reg(3)
+    a, r, lo, hi, carry = x_reg(4), x_reg(5), x_reg(6), x_reg(7), x_reg(8)
+
+    with ASMCode(label=name) as f:
+        f.MOV(carry, "xzr")
+        with Loop(n, label=f"{name}_row", unroll=unroll) as lp:
+            lp.LDR_post(a, up, 8)
+            lp.LDR(r, rp)
+            lp.MUL(lo, a, v)
+            lp.UMULH(hi, a, v)
+            lp.ADDS(lo, lo, r)
+            lp.ADCS(hi, hi, "xzr")
+            lp.ADDS(lo, lo, carry)
+            lp.ADCS(carry, hi, "xzr")
+            lp.STR_post(lo, rp, 8)
+        f.MOV(x_reg(0), carry)
+    return f
+
+
+def create_addmul_4(unroll: int):
+    """Same row loop with a trip count of 4 fixed at generation time (remainder peeled)."""
+    rp, up, n, v = x_reg(0), x_reg(1), x_reg(2), x_reg(3)
+    a, r, lo, hi, carry = x_reg(4), x_reg(5), x_reg(6), x_reg(7), x_reg(8)
+
+    with ASMCode(label=f"addmul_4_u{unroll}") as f:
+        f.MOV(carry, "xzr")
+        with Loop(n, 4, label=f"addmul_4_u{unroll}_row", unroll=unroll) as lp:
+            lp.LDR_post(a, up, 8)
+            lp.LDR(r, rp)
+            lp.MUL(lo, a, v)
+            lp.UMULH(hi, a, v)
+            lp.ADDS(lo, lo, r)
+            lp.ADCS(hi, hi, "xzr")
+            lp.ADDS(lo, lo, carry)
+            lp.ADCS(carry, hi, "xzr")
+            lp.STR_post(lo, rp, 8)
+        f.MOV(x_reg(0), carry)
+    return f
+
+
+def main():
+    factors = [int(k) for k in sys.argv[1:]] or [1, 2, 4, 8]
+
+    f = BackgroundCode()
+    with f:
+        for k in factors:
+            create_addmul_1(k)
+        create_addmul_4(3)
+
+    f.stdout()
+    f.export_to_file("addmul_1_unrolled.s")
+    print(f"\n✓ Exported unroll factors {factors} to addmul_1_unrolled.s")
+
+
+if __name__ == "__main__":
+    main()
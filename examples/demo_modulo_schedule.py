@@ -0,0 +1,74 @@
+#!/usr/bin/env python3
+"""
+Modulo Scheduling Demo - ArmAsmGen
+
+Software-pipelines the mpn_addmul_1-style row loop
+
+    uint64_t addmul_1(uint64_t *rp, const uint64_t *up, size_t n, uint64_t v)
+        rp[0..n) += up[0..n) * v, returns the carry limb
+
+for several machine models and prints, per model, the initiation interval
+the scheduler reached next to its resource and recurrence lower bounds.
+
+Features demonstrated:
+- Loop(counter, label=..., pipeline=model) with a runtime trip count
+- Prologue / kernel / epilogue generation and a remainder loop
+- Modulo variable expansion into scratch registers
+- MachineModel presets and per-mnemonic overrides
+
+Usage:
+    python examples/demo_modulo_schedule.py [model ...]
+"""
+
+import sys
+from typing import Optional
+
+from armasmgen import BackgroundCode, ASMCode, Loop, x_reg
+from armasmgen.machine import MODELS, OpTiming
+
+
+def create_addmul_1(model, name: Optional[str] = None):
+    """Row loop rp[] += up[] * v, pipelined for the given machine model."""
+    name = name or f"addmul_1_{model.name.replace('-', '_')}"
+    rp, up, n, v = x_reg(0), x_reg(1), x_reg(2), x_reg(3)
+    a, r, lo, hi, carry = x_reg(4), x_reg(5), x_reg(6), x_reg(7), x_reg(8)
+    scratch = [x_reg(i) for i in range(9, 18)]
+
+    with ASMCode(label=name) as f:
+        f.MOV(carry, "xzr")
+        with Loop(n, label=f"{name}_row", pipeline=model, scratch=scratch, noalias=True) as lp:
+            lp.LDR_post(a, up, 8)
+            lp.LDR(r, rp)
+            lp.MUL(lo, a, v)
+            lp.UMULH(hi, a, v)
+            lp.ADDS(lo, lo, r)
+            lp.ADCS(hi, hi, "xzr")
+            lp.ADDS(lo, lo, carry)
+            lp.ADCS(carry, hi, "xzr")
+            lp.STR_post(lo, rp, 8)
+        f.MOV(x_reg(0), carry)
+    return lp.report
+
+
+def main():
+    names = sys.argv[1:] or list(MODELS)
+    models = [MODELS[n] for n in names]
+    # A variant with a slower multiplier shows the recurrence-free loop tracking ResMII
+    models.append(MODELS["cortex-a72"].with_overrides(
+        name="cortex-a72-slowmul", umulh=OpTiming(8, "mul", 6)))
+
+    f = BackgroundCode()
+    with f:
+        reports = [create_addmul_1(m) for m in models]
+
+    print(f"{'model':<22}{'II':>4}{'ResMII':>8}{'RecMII':>8}{'stages':>8}{'MVE':>5}")
+    for rep in reports:
+        print(f"{rep.model:<22}{rep.ii:>4}{rep.res_mii:>8}{rep.rec_mii:>8}"
+              f"{rep.stages:>8}{rep.mve_unroll:>5}")
+
+    f.export_to_file("addmul_1_pipelined.s")
+    print("\n✓ Exported pipelined kernels to addmul_1_pipelined.s")
+
+
+if __name__ == "__main__":
+    main()
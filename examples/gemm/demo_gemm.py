@@ -0,0 +1,481 @@
+#!/usr/bin/env python3
+"""
+GEMM micro-kernel generator: register-blocked C += A·B on packed panels.
+
+    void gemm_f32_8x12(size_t k, const float *a, const float *b, float *c, size_t ldc)
+    void gemm_pack_a_f32_8(size_t k, const float *a, size_t lda, float *packed)
+    void gemm_pack_b_f32_12(size_t k, const float *b, size_t ldb, float *packed)
+
+A kernel adds the MR x NR product of an MR x k panel of A and a k x NR
+panel of B to a column-major tile of C (ldc elements between columns).
+The panels are packed so that the kernel reads both with one post-indexed
+stream each:
+
+    A panel   step s: the MR rows' words of step s, row after row
+    B panel   step s: the NR columns' words of step s, column after column
+
+A step is one k value, or a group of four for the byte types, whose
+products SDOT/UDOT sum in one lane. gemm_pack_a transposes 16-byte chunks
+of MR rows of the row-major A with TRN1/TRN2 (k not a multiple of the
+chunk ends with per-step lane gathers); gemm_pack_b copies or, for the byte
+types, interleaves four rows of B with ST4.
+
+    type  A, B     C          multiply per lane group                  step
+    f32   float    float      FMLA  acc.4S, a.4S, b.S[j]               1
+    s32   int32_t  int32_t    MLA   acc.4S, a.4S, b.S[j]               1
+    s16   int16_t  int32_t    SMLAL/SMLAL2 acc.4S, a.4H/8H, b.H[j]     1
+    s8    int8_t   int32_t    SDOT  acc.4S, a.16B, b.4B[j]             4
+    u8    uint8_t  uint32_t   UDOT  acc.4S, a.16B, b.4B[j]             4
+
+Each of the MR·NR/4 accumulators holds four rows of one column of C and
+stays in a register for the whole k loop; A and B take MR/4 (MR/8 for s16)
+and NR/4 (NR/8) registers per step. The k loop is unrolled (the panel
+loads fold into one post-increment per pointer) or, with --pipeline,
+software-pipelined for the model.
+The byte types need k to be a multiple of 4 (pad A and B with zeros).
+Integer accumulation wraps modulo 2^32.
+
+The report for each kernel comes from the machine model: the resource
+(ResMII) and recurrence (RecMII) bounds of the unrolled k loop give the
+cycles per step, and ops/cycle counts a multiply-add as two. Every shape
+that fits the registers is ranked this way and the best one per type is
+generated; s8/u8 are left out on models without DotProd (cortex-a72).
+
+gemm_kernels.h lists the generated kernels with their packing routines
+for test_gemm.c, which checks them against a scalar reference and times
+a blocked GEMM (make run).
+
+Usage:
+    python3 demo_gemm.py [model] [--unroll U | --pipeline] [--shape TYPE:MRxNR ...]
+"""
+
+import sys
+from dataclasses import dataclass
+
+from armasmgen.builder import ASMCode, BackgroundCode, Loop, record
+from armasmgen.machine import MODELS, NEOVERSE_N1
+from armasmgen.passes.modulo import ModuloSchedule
+from armasmgen.passes.unroll import unroll_body
+from armasmgen.register import VECTOR_POOL, d_reg, x_reg
+
+
+@dataclass(frozen=True)
+class DType:
+    name: str
+    ctype: str          # element of A and B
+    ctype_c: str        # element of C
+    size: int           # bytes per element of A and B
+    group: int          # k values per step (summed in one lane by SDOT/UDOT)
+    lanes: int          # rows of A (and columns of B) per vector register
+    mnemonic: str
+
+    @property
+    def word(self) -> int:
+        """Bytes of one row (or column) per step."""
+        return self.size * self.group
+
+
+DTYPES = {
+    "f32": DType("f32", "float", "float", 4, 1, 4, "fmla"),
+    "s32": DType("s32", "int32_t", "int32_t", 4, 1, 4, "mla"),
+    "s16": DType("s16", "int16_t", "int32_t", 2, 1, 8, "smlal"),
+    "s8": DType("s8", "int8_t", "int32_t", 1, 4, 4, "sdot"),
+    "u8": DType("u8", "uint8_t", "uint32_t", 1, 4, 4, "udot"),
+}
+
+# Shapes the ranking tries: MR and NR in whole vectors up to 16 rows or columns
+MAX_BLOCK = 16
+K_UNROLL = 4
+
+
+K, A, B, C, LDC, COL = x_reg(0), x_reg(1), x_reg(2), x_reg(3), x_reg(4), x_reg(5)
+
+
+@dataclass
+class KernelReport:
+    name: str
+    model: str
+    ops: int            # ops per step of k (a multiply-add counts two)
+    res_mii: int        # cycles per unrolled pass, resource bound
+    rec_mii: int        # cycles per unrolled pass, accumulator recurrence
+    unroll: int
+
+    @property
+    def cycles(self) -> float:
+        """Cycles per step of k."""
+        return max(self.res_mii, self.rec_mii) / self.unroll
+
+    @property
+    def ops_per_cycle(self) -> float:
+        return self.ops / self.cycles
+
+    def __str__(self):
+        return (f"{self.name} ({self.model}): {self.ops} ops per step, {self.cycles:.2f} cycles "
+                f"(ResMII={self.res_mii}, RecMII={self.rec_mii} per {self.unroll} steps), "
+                f"{self.ops_per_cycle:.1f} ops/cycle")
+
+
+def kernel_name(dt: DType, mr: int, nr: int) -> str:
+    return f"gemm_{dt.name}_{mr}x{nr}"
+
+
+def check_shape(dt: DType, mr: int, nr: int):
+    if mr <= 0 or nr <= 0 or mr % 4 or mr % dt.lanes or nr % dt.lanes:
+        raise ValueError(f"{dt.name} blocks need MR and NR in multiples of {dt.lanes}, got {mr}x{nr}")
+    if mr > MAX_BLOCK or nr > MAX_BLOCK:
+        raise ValueError(f"MR and NR are limited to {MAX_BLOCK}, got {mr}x{nr}")
+    need = mr * nr // 4 + mr // dt.lanes + nr // dt.lanes
+    if need > len(VECTOR_POOL):
+        raise ValueError(f"{dt.name} {mr}x{nr} needs {need} vector registers, {len(VECTOR_POOL)} exist")
+
+
+def save_pairs(regs):
+    """Callee-saved d8-d15 among regs, as STP/LDP pairs."""
+    saved = sorted({r.number for r in regs} & set(range(8, 16)))
+    return [(d_reg(n - n % 2), d_reg(n - n % 2 + 1)) for n in sorted({n - n % 2 for n in saved})]
+
+
+def load_panel(m, regs, ptr):
+    """LDP q pairs (LDR q for an odd one), post-indexed; unrolling folds them into one update."""
+    for i in range(0, len(regs) - 1, 2):
+        m.LDP_post(f"q{regs[i].number}", f"q{regs[i + 1].number}", ptr, 32)
+    if len(regs) % 2:
+        m.LDR_post(f"q{regs[-1].number}", ptr, 16)
+
+
+def emit_step(m, dt: DType, a, b, acc):
+    """One step of k: load the A and B words, one multiply per accumulator."""
+    load_panel(m, a, A)
+    load_panel(m, b, B)
+    for j in range(len(acc[0])):
+        src = b[j // dt.lanes]
+        for i, row in enumerate(acc):
+            d = row[j].s4
+            if dt.name == "f32":
+                m.VFMLA(d, a[i].s4, src.s4[j % 4])
+            elif dt.name == "s32":
+                m.VMLA(d, a[i].s4, src.s4[j % 4])
+            elif dt.name == "s16":
+                # Rows 8i..8i+3 in the low half of a[i // 2], 8i+4.. in the high half (smlal2)
+                half = a[i // 2].h4 if i % 2 == 0 else a[i // 2].h8
+                m.VSMLAL(d, half, src.h8[j % 8])
+            else:
+                (m.VSDOT if dt.name == "s8" else m.VUDOT)(d, a[i].b16, src.s4[j % 4])
+
+
+def allocate(dt: DType, mr: int, nr: int):
+    """B registers first (s16 takes its elements from v0-v15), then A, then the accumulators."""
+    pool = iter(VECTOR_POOL)
+    b = [next(pool) for _ in range(nr // dt.lanes)]
+    a = [next(pool) for _ in range(mr // dt.lanes)]
+    acc = [[next(pool) for _ in range(nr)] for _ in range(mr // 4)]
+    return a, b, acc, list(pool)
+
+
+def model_report(dt: DType, mr: int, nr: int, model, unroll: int = K_UNROLL) -> KernelReport:
+    """Cycle bounds of the unrolled k loop under the machine model."""
+    check_shape(dt, mr, nr)
+    a, b, acc, _ = allocate(dt, mr, nr)
+    body = unroll_body(record(lambda s: emit_step(s, dt, a, b, acc)), unroll)
+    res_mii, rec_mii = ModuloSchedule.bounds(body, model, noalias=True)
+    return KernelReport(kernel_name(dt, mr, nr), model.name, 2 * mr * nr * dt.group, res_mii, rec_mii, unroll)
+
+
+def create_gemm_kernel(dt: DType, mr: int, nr: int, unroll: int = K_UNROLL, pipeline=None):
+    """gemm_{type}_{MR}x{NR}(k, a, b, c, ldc): C[MR x NR] += packed A panel · packed B panel."""
+    check_shape(dt, mr, nr)
+    a, b, acc, spare = allocate(dt, mr, nr)
+    flat = [r for row in acc for r in row]
+    if dt.name == "s16":
+        spare = [r for r in spare if r.number < 16]     # renamed B registers stay indexable by H
+    scratch = spare if pipeline else []
+    saved = save_pairs(a + b + flat + scratch)
+    name = kernel_name(dt, mr, nr)
+    loop = dict(pipeline=pipeline, scratch=[str(r) for r in scratch], noalias=True) if pipeline else dict(unroll=unroll)
+
+    with ASMCode(label=name) as f:
+        for r0, r1 in saved:
+            f.STP_pre(r0, r1, "sp", -16)
+        for r in flat:
+            f.VMOVI(r.s4, 0)
+        if dt.group == 4:
+            f.LSR(K, K, 2)             # steps of four k values
+        with Loop(K, label=f"{name}_k", **loop) as lp:
+            emit_step(lp, dt, a, b, acc)
+
+        # C += acc, one column at a time; the A and B registers are free now
+        temps = a + b
+        f.LSL(LDC, LDC, 2)
+        f.MOV(COL, C)
+        for j in range(nr):
+            for i, row in enumerate(acc):
+                t = temps[i % len(temps)]
+                f.LDR_vector_offset(t, COL, 16 * i)
+                if dt.name == "f32":
+                    f.VFADD(t.s4, t.s4, row[j].s4)
+                else:
+                    f.VADD(t.s4, t.s4, row[j].s4)
+                f.STR_vector_offset(t, COL, 16 * i)
+            if j + 1 < nr:
+                f.ADD(COL, COL, LDC)
+
+        for r0, r1 in reversed(saved):
+            f.LDP_post(r0, r1, "sp", 16)
+    return lp.report
+
+
+def transpose(m, rows, spare, esize: int):
+    """
+    Transpose the square matrix of esize-bit words held one row per register
+    (16 / (esize / 8) rows) with log2(rows) rounds of TRN1/TRN2 at doubling
+    element sizes. Two spare registers suffice; returns the registers that
+    hold the columns.
+    """
+    views = {16: "h8", 32: "s4", 64: "d2"}
+    cur, free = list(rows), list(spare)
+    dist = 1
+    while dist < len(cur):
+        nxt = [None] * len(cur)
+        for i in range(len(cur)):
+            if i & dist:
+                continue
+            j = i + dist
+            lo, hi = free.pop(0), free.pop(0)
+            view = views[esize]
+            m.VTRN1(getattr(lo, view), getattr(cur[i], view), getattr(cur[j], view))
+            m.VTRN2(getattr(hi, view), getattr(cur[i], view), getattr(cur[j], view))
+            nxt[i], nxt[j] = lo, hi
+            free += [cur[i], cur[j]]
+        cur, dist, esize = nxt, 2 * dist, 2 * esize
+    return cur
+
+
+def create_pack_a(dt: DType, mr: int):
+    """gemm_pack_a_{type}_{MR}(k, a, lda, packed): MR rows of row-major A into the kernel's A panel."""
+    if mr <= 0 or mr % dt.lanes or mr > MAX_BLOCK:
+        raise ValueError(f"{dt.name} A panels take MR in multiples of {dt.lanes} up to {MAX_BLOCK}, got {mr}")
+    name = f"gemm_pack_a_{dt.name}_{mr}"
+    w = dt.word                     # bytes per row and step
+    per_chunk = 16 // w             # steps per 16-byte chunk of a row, and rows per transpose
+    lda, packed, walk, chunks = x_reg(2), x_reg(3), x_reg(9), x_reg(10)
+    regs = list(VECTOR_POOL[:mr + 2])
+    rows, spare = regs[:mr], regs[mr:]
+    lane = {4: "s4", 2: "h8"}[w]
+
+    with ASMCode(label=name) as f:
+        if dt.size > 1:
+            f.LSL(lda, lda, dt.size.bit_length() - 1)
+        if dt.group == 4:
+            f.LSR(K, K, 2)
+        f.LSR(chunks, K, per_chunk.bit_length() - 1)
+        with Loop(chunks, label=f"{name}_chunk") as lp:
+            lp.MOV(walk, A)
+            for r in rows:
+                lp.LD1(r.b16, walk, lda)
+            lp.ADD_imm(A, A, 16)
+            for blk in range(mr // per_chunk):
+                block = rows[blk * per_chunk:(blk + 1) * per_chunk]
+                cols = transpose(lp, block, spare, 8 * w)
+                spare = [r for r in block + spare if r not in cols][:2]
+                for step, col in enumerate(cols):
+                    lp.STR_vector_offset(col, packed, step * mr * w + 16 * blk)
+            lp.ADD_imm(packed, packed, per_chunk * mr * w)
+
+        # Steps left over from the chunks: gather one word per row
+        f.AND_imm(K, K, per_chunk - 1)
+        with Loop(K, label=f"{name}_tail") as lp:
+            lp.MOV(walk, A)
+            for blk in range(mr // per_chunk):
+                col = rows[blk]
+                for r in range(per_chunk):
+                    lp.LD1(getattr(col, lane)[r], walk, lda)
+                lp.STR_post(f"q{col.number}", packed, 16)
+            lp.ADD_imm(A, A, w)
+
+
+def create_pack_b(dt: DType, nr: int):
+    """gemm_pack_b_{type}_{NR}(k, b, ldb, packed): NR columns of row-major B into the kernel's B panel."""
+    if nr <= 0 or nr % dt.lanes or nr > MAX_BLOCK:
+        raise ValueError(f"{dt.name} B panels take NR in multiples of {dt.lanes} up to {MAX_BLOCK}, got {nr}")
+    name = f"gemm_pack_b_{dt.name}_{nr}"
+    src, ldb, packed, walk = x_reg(1), x_reg(2), x_reg(3), x_reg(9)
+
+    with ASMCode(label=name) as f:
+        if dt.size > 1:
+            f.LSL(ldb, ldb, dt.size.bit_length() - 1)
+        if dt.group == 1:
+            # A step is one row: copy nr elements
+            regs = [r.b16 for r in VECTOR_POOL[:nr * dt.size // 16]]
+            with Loop(K, label=f"{name}_row") as lp:
+                lp.LD1(regs, src, ldb)
+                lp.ST1(regs, packed, 16 * len(regs))
+            return
+
+        # Bytes: a step is four rows; ST4 interleaves them column by column
+        f.LSR(K, K, 2)
+        chunks = [16] * (nr // 16) + [8] * (nr % 16 // 8) + [4] * (nr % 8 // 4)
+        quads = [[VECTOR_POOL[4 * c + t] for t in range(4)] for c in range(len(chunks))]
+        with Loop(K, label=f"{name}_step") as lp:
+            for t in range(4):
+                lp.MOV(walk, src)
+                for size, quad in zip(chunks, quads):
+                    reg = quad[t]
+                    if size == 16:
+                        lp.LD1(reg.b16, walk, 16)
+                    elif size == 8:
+                        lp.LD1(reg.b8, walk, 8)
+                    else:
+                        lp.LD1(reg.s4[0], walk, 4)
+                lp.ADD(src, src, ldb)
+            for size, quad in zip(chunks, quads):
+                if size == 16:
+                    lp.ST4([r.b16 for r in quad], packed, 64)
+                elif size == 8:
+                    lp.ST4([r.b8 for r in quad], packed, 32)
+                else:
+                    for col in range(4):
+                        lp.ST4([r.b16[col] for r in quad], packed, 4)
+
+
+def shapes(dt: DType):
+    """Every MR x NR that fits the vector registers."""
+    out = []
+    for mr in range(max(4, dt.lanes), MAX_BLOCK + 1, max(4, dt.lanes)):
+        for nr in range(dt.lanes, MAX_BLOCK + 1, dt.lanes):
+            try:
+                check_shape(dt, mr, nr)
+            except ValueError:
+                continue
+            out.append((mr, nr))
+    return out
+
+
+def rank(dt: DType, model, unroll: int = K_UNROLL):
+    """Shapes by modeled ops/cycle, ties broken by fewer panel bytes loaded per op."""
+    reports = []
+    for mr, nr in shapes(dt):
+        report = model_report(dt, mr, nr, model, unroll)
+        reports.append(((-round(report.ops_per_cycle, 3), (mr + nr) / (mr * nr)), (mr, nr), report))
+    reports.sort(key=lambda r: r[0])
+    return [(shape, report) for _, shape, report in reports]
+
+
+def write_header(path: str, kernels, model):
+    """gemm_kernels.h: one table entry per kernel for test_gemm.c."""
+    lines = [
+        f"// Generated by demo_gemm.py for {model.name}: the GEMM micro-kernels in gemm.s",
+        "#include <stddef.h>",
+        "#include <stdint.h>",
+        "",
+    ]
+    for dt, mr, nr, _ in kernels:
+        lines += [
+            f"extern void {kernel_name(dt, mr, nr)}(size_t k, const {dt.ctype} *a, const {dt.ctype} *b, "
+            f"{dt.ctype_c} *c, size_t ldc);",
+            f"extern void gemm_pack_a_{dt.name}_{mr}(size_t k, const {dt.ctype} *a, size_t lda, {dt.ctype} *packed);",
+            f"extern void gemm_pack_b_{dt.name}_{nr}(size_t k, const {dt.ctype} *b, size_t ldb, {dt.ctype} *packed);",
+        ]
+    lines += [
+        "",
+        "enum gemm_type { GEMM_F32, GEMM_S32, GEMM_S16, GEMM_S8, GEMM_U8 };",
+        "",
+        "typedef void (*gemm_kernel_fn)(size_t k, const void *a, const void *b, void *c, size_t ldc);",
+        "typedef void (*gemm_pack_fn)(size_t k, const void *src, size_t ld, void *packed);",
+        "",
+        "static const struct gemm_kernel {",
+        "    const char *name;",
+        "    enum gemm_type type;",
+        "    int mr, nr;",
+        "    int step;               // k values per step; k must be a multiple of it",
+        "    double model_ops;       // ops per cycle under the machine model",
+        "    gemm_kernel_fn kernel;",
+        "    gemm_pack_fn pack_a, pack_b;",
+        "} gemm_kernels[] = {",
+    ]
+    for dt, mr, nr, report in kernels:
+        lines.append(
+            f'    {{ "{kernel_name(dt, mr, nr)}", GEMM_{dt.name.upper()}, {mr}, {nr}, {dt.group}, '
+            f"{report.ops_per_cycle:.2f}, (gemm_kernel_fn){kernel_name(dt, mr, nr)}, "
+            f"(gemm_pack_fn)gemm_pack_a_{dt.name}_{mr}, (gemm_pack_fn)gemm_pack_b_{dt.name}_{nr} }},")
+    lines += [
+        "};",
+        "",
+        "#define GEMM_NKERNELS (int)(sizeof gemm_kernels / sizeof gemm_kernels[0])",
+        "",
+    ]
+    with open(path, "w") as fh:
+        fh.write("\n".join(lines))
+
+
+def parse_args(args):
+    model, unroll, pipeline, forced = NEOVERSE_N1, K_UNROLL, False, {}
+    while args:
+        arg = args.pop(0)
+        if arg == "--unroll" and args:
+            unroll = int(args.pop(0))
+        elif arg == "--pipeline":
+            pipeline = True
+        elif arg == "--shape" and args:
+            name, _, shape = args.pop(0).partition(":")
+            mr, _, nr = shape.partition("x")
+            if name not in DTYPES or not mr.isdigit() or not nr.isdigit():
+                raise ValueError(f"--shape takes TYPE:MRxNR with TYPE one of {', '.join(DTYPES)}")
+            forced[name] = (int(mr), int(nr))
+        elif arg in MODELS:
+            model = MODELS[arg]
+        else:
+            raise ValueError(f"usage: demo_gemm.py [{'|'.join(MODELS)}] [--unroll U | --pipeline] [--shape TYPE:MRxNR ...]")
+    for name, (mr, nr) in forced.items():
+        dt = DTYPES[name]
+        if not model.supports(dt.mnemonic):
+            continue
+        try:
+            check_shape(dt, mr, nr)
+        except ValueError as e:
+            raise ValueError(f"--shape: {e}") from None
+        if pipeline:
+            # Schedule the kernel once and drop it: the free registers must cover its MVE scratch
+            try:
+                record(lambda s: create_gemm_kernel(dt, mr, nr, unroll, model))
+            except ValueError as e:
+                raise ValueError(f"--shape {name}:{mr}x{nr} leaves too few free registers for --pipeline: {e}") from None
+    return model, unroll, pipeline, forced
+
+
+def main():
+    try:
+        model, unroll, pipeline, forced = parse_args(sys.argv[1:])
+    except ValueError as e:
+        sys.exit(str(e))
+    print(f"=== GEMM Micro-Kernel Generator ({model.name}) ===")
+    kernels = []
+    for dt in DTYPES.values():
+        if not model.supports(dt.mnemonic):
+            print(f"- {dt.name}: {model.name} has no {dt.mnemonic.upper()}, skipped")
+            continue
+        ranked = rank(dt, model, unroll)
+        mr, nr = forced.get(dt.name, ranked[0][0])
+        report = model_report(dt, mr, nr, model, unroll)
+        kernels.append((dt, mr, nr, report))
+        runners_up = ", ".join(f"{m}x{n} {r.ops_per_cycle:.1f}" for (m, n), r in ranked[:4] if (m, n) != (mr, nr))
+        print(f"✓ {report}")
+        if runners_up:
+            print(f"  next best: {runners_up}")
+
+    out = BackgroundCode()
+    with out:
+        for dt, mr, nr, _ in kernels:
+            schedule = create_gemm_kernel(dt, mr, nr, unroll, model if pipeline else None)
+            if schedule:
+                print(f"  {kernel_name(dt, mr, nr)} k loop: {schedule}")
+            create_pack_a(dt, mr)
+            create_pack_b(dt, nr)
+    out.export_to_file("gemm.s")
+    write_header("gemm_kernels.h", kernels, model)
+    print("✓ Assembly exported to: gemm.s (kernels and their pack_a / pack_b routines)")
+    print("✓ Kernel table written to: gemm_kernels.h")
+    print("Run 'make run' to check the kernels against a scalar reference and time a blocked GEMM.")
+
+
+if __name__ == "__main__":
+    main()
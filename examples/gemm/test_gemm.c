@@ -0,0 +1,229 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "gemm_kernels.h"
+
+#define CHECKS 200
+#define MAX_K 67                    // largest k the checks use
+#define PAD 3                       // extra elements per row/column, so lda/ldb/ldc are not the block size
+#define BENCH_SIZE 512              // the timed GEMM is about BENCH_SIZE^3
+#define GUARD 0x5A5A5A5AU
+
+static const char *type_names[] = { "f32", "s32", "s16", "s8", "u8" };
+
+// Global test counters
+int total_tests = 0;
+int passed_tests = 0;
+
+int elem_size(enum gemm_type t) {
+    return t == GEMM_S16 ? 2 : t == GEMM_S8 || t == GEMM_U8 ? 1 : 4;
+}
+
+// Small values keep the f32 products and sums exact; integers use their full range
+void set_elem(void *p, size_t i, enum gemm_type t) {
+    switch (t) {
+    case GEMM_F32: ((float *)p)[i] = (float)(rand() % 17 - 8); break;
+    case GEMM_S32: ((uint32_t *)p)[i] = (uint32_t)rand() ^ ((uint32_t)rand() << 16); break;
+    case GEMM_S16: ((int16_t *)p)[i] = (int16_t)rand(); break;
+    case GEMM_S8:  ((int8_t *)p)[i] = (int8_t)rand(); break;
+    case GEMM_U8:  ((uint8_t *)p)[i] = (uint8_t)rand(); break;
+    }
+}
+
+// Element i as a 64-bit integer (f32 values are integers)
+int64_t get_elem(const void *p, size_t i, enum gemm_type t) {
+    switch (t) {
+    case GEMM_F32: return (int64_t)((const float *)p)[i];
+    case GEMM_S32: return ((const int32_t *)p)[i];
+    case GEMM_S16: return ((const int16_t *)p)[i];
+    case GEMM_S8:  return ((const int8_t *)p)[i];
+    default:       return ((const uint8_t *)p)[i];
+    }
+}
+
+// c[i + ldc·j] += sum_s a[i·lda + s]·b[s·ldb + j]; integers wrap modulo 2^32 like the kernels
+void gemm_reference(const struct gemm_kernel *g, size_t k, const void *a, size_t lda,
+                    const void *b, size_t ldb, void *c, size_t ldc) {
+    for (int j = 0; j < g->nr; j++) {
+        for (int i = 0; i < g->mr; i++) {
+            int64_t sum = 0;
+            for (size_t s = 0; s < k; s++) {
+                sum += get_elem(a, i * lda + s, g->type) * get_elem(b, s * ldb + j, g->type);
+            }
+            if (g->type == GEMM_F32) {
+                ((float *)c)[i + ldc * j] += (float)sum;
+            } else {
+                ((uint32_t *)c)[i + ldc * j] += (uint32_t)sum;
+            }
+        }
+    }
+}
+
+// The panels the kernel expects: per step, MR (NR) words of `step` elements
+int check_packing(const struct gemm_kernel *g, size_t k, const uint8_t *a, size_t lda,
+                  const uint8_t *b, size_t ldb, const uint8_t *pa, const uint8_t *pb) {
+    int es = elem_size(g->type), w = es * g->step;
+    for (size_t s = 0; s < k / g->step; s++) {
+        for (int i = 0; i < g->mr; i++) {
+            if (memcmp(pa + (s * g->mr + i) * w, a + (i * lda + s * g->step) * es, w) != 0) {
+                return 0;
+            }
+        }
+        for (int j = 0; j < g->nr; j++) {
+            for (int q = 0; q < g->step; q++) {
+                if (memcmp(pb + (s * g->nr + j) * w + q * es, b + ((s * g->step + q) * ldb + j) * es, es) != 0) {
+                    return 0;
+                }
+            }
+        }
+    }
+    return 1;
+}
+
+void run_tests() {
+    static uint8_t a[16 * (MAX_K + PAD) * 4], b[MAX_K * (16 + PAD) * 4];
+    static uint8_t pa[16 * MAX_K * 4], pb[16 * MAX_K * 4];
+    static uint32_t c[(16 + PAD) * 16 + 1], expected[(16 + PAD) * 16];
+
+    printf("\n========================================\n");
+    printf("Packing and kernels against a scalar reference\n");
+    printf("========================================\n");
+
+    for (int n = 0; n < GEMM_NKERNELS; n++) {
+        const struct gemm_kernel *g = &gemm_kernels[n];
+        int passed = 0;
+        for (int t = 0; t < CHECKS; t++) {
+            size_t k = (size_t)(t % (MAX_K + 1)) / g->step * g->step;
+            size_t lda = k + PAD, ldb = g->nr + PAD, ldc = g->mr + PAD;
+            for (size_t i = 0; i < g->mr * lda; i++) {
+                set_elem(a, i, g->type);
+            }
+            for (size_t i = 0; i < k * ldb; i++) {
+                set_elem(b, i, g->type);
+            }
+            for (size_t i = 0; i < ldc * g->nr; i++) {
+                if (g->type == GEMM_F32) {
+                    ((float *)c)[i] = (float)(rand() % 101 - 50);
+                } else {
+                    c[i] = (uint32_t)rand() ^ ((uint32_t)rand() << 16);
+                }
+            }
+            c[ldc * g->nr] = GUARD;
+            memcpy(expected, c, 4 * ldc * g->nr);
+
+            g->pack_a(k, a, lda, pa);
+            g->pack_b(k, b, ldb, pb);
+            g->kernel(k, pa, pb, c, ldc);
+            gemm_reference(g, k, a, lda, b, ldb, expected, ldc);
+
+            passed += check_packing(g, k, a, lda, b, ldb, pa, pb)
+                      && memcmp(c, expected, 4 * ldc * g->nr) == 0 && c[ldc * g->nr] == GUARD;
+        }
+        total_tests += CHECKS;
+        passed_tests += passed;
+        printf("%-16s %-3s %2dx%-2d: %d/%d passed\n", g->name, type_names[g->type], g->mr, g->nr, passed, CHECKS);
+    }
+}
+
+double seconds(struct timespec start, struct timespec end) {
+    return (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) * 1e-9;
+}
+
+// C[M x N] += A[M x K]·B[K x N] from packed panels: every B panel against every A panel
+void run_benchmark(double ghz) {
+    const size_t k = BENCH_SIZE;
+    const int repeats = 5;
+    struct timespec start, end;
+
+    printf("\n========================================\n");
+    printf("GEMM of about %d^3, best of %d (one multiply-add = 2 ops)\n", BENCH_SIZE, repeats);
+    printf("========================================\n");
+    printf("%-16s %6s %6s %10s %10s", "kernel", "M", "N", "GOP/s", "+packing");
+    if (ghz > 0) {
+        printf(" %10s %10s", "ops/cycle", "model");
+    }
+    printf("\n");
+
+    for (int n = 0; n < GEMM_NKERNELS; n++) {
+        const struct gemm_kernel *g = &gemm_kernels[n];
+        size_t m = BENCH_SIZE / g->mr * g->mr, cols = BENCH_SIZE / g->nr * g->nr;
+        int es = elem_size(g->type);
+        uint8_t *a = malloc(m * k * es), *b = malloc(k * cols * es);
+        uint8_t *pa = malloc(m * k * es), *pb = malloc(k * cols * es);
+        uint32_t *c = calloc(m * cols, 4);
+        for (size_t i = 0; i < m * k; i++) {
+            set_elem(a, i, g->type);
+        }
+        for (size_t i = 0; i < k * cols; i++) {
+            set_elem(b, i, g->type);
+        }
+
+        double best = 1e30, best_pack = 1e30;
+        for (int r = 0; r < repeats; r++) {
+            clock_gettime(CLOCK_MONOTONIC, &start);
+            for (size_t i = 0; i < m; i += g->mr) {
+                g->pack_a(k, a + i * k * es, k, pa + i * k * es);
+            }
+            for (size_t j = 0; j < cols; j += g->nr) {
+                g->pack_b(k, b + j * es, cols, pb + j * k * es);
+            }
+            clock_gettime(CLOCK_MONOTONIC, &end);
+            double pack = seconds(start, end);
+
+            clock_gettime(CLOCK_MONOTONIC, &start);
+            for (size_t j = 0; j < cols; j += g->nr) {
+                for (size_t i = 0; i < m; i += g->mr) {
+                    g->kernel(k, pa + i * k * es, pb + j * k * es, c + i + j * m, m);
+                }
+            }
+            clock_gettime(CLOCK_MONOTONIC, &end);
+            double kernel = seconds(start, end);
+            if (kernel < best) {
+                best = kernel;
+            }
+            if (kernel + pack < best_pack) {
+                best_pack = kernel + pack;
+            }
+        }
+
+        double ops = 2.0 * m * cols * k;
+        printf("%-16s %6zu %6zu %10.2f %10.2f", g->name, m, cols, ops / best * 1e-9, ops / best_pack * 1e-9);
+        if (ghz > 0) {
+            printf(" %10.2f %10.2f", ops / best / (ghz * 1e9), g->model_ops);
+        }
+        printf("\n");
+        free(a);
+        free(b);
+        free(pa);
+        free(pb);
+        free(c);
+    }
+}
+
+int main(int argc, char **argv) {
+    printf("GEMM Micro-Kernel Test Suite\n");
+    printf("============================\n");
+
+    double ghz = argc > 1 ? atof(argv[1]) : 0;
+    srand((unsigned int)time(NULL));
+
+    run_tests();
+    run_benchmark(ghz);
+
+    printf("\n=== Final Test Summary ===\n");
+    printf("Total tests run: %d\n", total_tests);
+    printf("Tests passed:    %d\n", passed_tests);
+    printf("Tests failed:    %d\n", total_tests - passed_tests);
+    printf("Success rate:    %.2f%%\n", (double)passed_tests / total_tests * 100.0);
+
+    if (passed_tests == total_tests) {
+        printf("🎉 ALL TESTS PASSED! 🎉\n");
+        return 0;
+    } else {
+        printf("❌ SOME TESTS FAILED ❌\n");
+        return 1;
+    }
+}
@@ -0,0 +1,279 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "memops.h"
+
+#define MAX_N 1100                  // every n up to here is checked (all size classes and the first loop passes)
+#define MAX_OFFSET 15               // and from every misalignment of dst and src
+#define GUARD 64                    // bytes before and after each range that must not change
+#define MAX_BENCH (64 << 20)
+#define RANDOM_CALLS 4096           // calls per pass of the random-size benchmarks
+
+// libc through pointers, so the compiler neither inlines nor drops the calls it is timed against
+typedef void *(*copy_fn)(void *, const void *, size_t);
+typedef void *(*set_fn)(void *, int, size_t);
+typedef int (*cmp_fn)(const void *, const void *, size_t);
+static copy_fn volatile libc_memcpy = memcpy;
+static set_fn volatile libc_memset = memset;
+static cmp_fn volatile libc_memcmp = memcmp;
+
+// Global test counters
+int total_tests = 0;
+int passed_tests = 0;
+
+void fill_random(uint8_t *p, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        p[i] = (uint8_t)rand();
+    }
+}
+
+int sign(int x) {
+    return (x > 0) - (x < 0);
+}
+
+// dst = buffer + GUARD + offset; everything outside [dst, dst + n) must keep its random bytes
+int check_copy(uint8_t *dst_buf, uint8_t *src_buf, uint8_t *expected, size_t n, size_t dst_off, size_t src_off) {
+    size_t total = n + 2 * GUARD + MAX_OFFSET;
+    fill_random(dst_buf, total);
+    fill_random(src_buf, total);
+    memcpy(expected, dst_buf, total);
+    memcpy(expected + GUARD + dst_off, src_buf + GUARD + src_off, n);
+    void *r = asm_memcpy(dst_buf + GUARD + dst_off, src_buf + GUARD + src_off, n);
+    return r == dst_buf + GUARD + dst_off && memcmp(dst_buf, expected, total) == 0;
+}
+
+// c alternates between 0 (the DC ZVA path) and any int, of which memset stores the low byte
+int check_set(uint8_t *dst_buf, uint8_t *expected, size_t n, size_t dst_off, int c) {
+    size_t total = n + 2 * GUARD + MAX_OFFSET;
+    fill_random(dst_buf, total);
+    memcpy(expected, dst_buf, total);
+    memset(expected + GUARD + dst_off, c, n);
+    void *r = asm_memset(dst_buf + GUARD + dst_off, c, n);
+    return r == dst_buf + GUARD + dst_off && memcmp(dst_buf, expected, total) == 0;
+}
+
+// Equal ranges, or ranges that first differ at a random byte (memcmp only promises the sign)
+int check_cmp(uint8_t *a_buf, uint8_t *b_buf, size_t n, size_t a_off, size_t b_off) {
+    uint8_t *a = a_buf + GUARD + a_off, *b = b_buf + GUARD + b_off;
+    fill_random(a, n);
+    memcpy(b, a, n);
+    if (n > 0 && rand() % 4) {
+        size_t at = rand() % 2 ? (size_t)rand() % n : n - 1 - (size_t)rand() % (n < 16 ? n : 16);
+        b[at] = (uint8_t)(a[at] + 1 + rand() % 255);
+        if (rand() % 2 && at + 1 < n) {
+            b[n - 1] ^= 0x80;   // a later difference must not decide the result
+        }
+    }
+    return sign(asm_memcmp(a, b, n)) == sign(memcmp(a, b, n));
+}
+
+void report(const char *name, int passed, int checks) {
+    total_tests += checks;
+    passed_tests += passed;
+    printf("%-24s: %d/%d passed\n", name, passed, checks);
+}
+
+void run_tests() {
+    // the largest check is a threshold plus a tail; 0 thresholds are off
+    size_t largest = MAX_N;
+    if (MEMOPS_NT_THRESHOLD && MEMOPS_NT_THRESHOLD + 200 <= MAX_BENCH && MEMOPS_NT_THRESHOLD + 200 > largest) {
+        largest = MEMOPS_NT_THRESHOLD + 200;
+    }
+    if (MEMOPS_ZVA_THRESHOLD + 200 > largest) {
+        largest = MEMOPS_ZVA_THRESHOLD + 200;
+    }
+    size_t bytes = largest + 2 * GUARD + MAX_OFFSET;
+    uint8_t *a = malloc(bytes), *b = malloc(bytes), *expected = malloc(bytes);
+    int passed[3] = { 0 }, checks = 0;
+
+    printf("\n========================================\n");
+    printf("Every n from 0 to %d against libc\n", MAX_N);
+    printf("========================================\n");
+    for (size_t n = 0; n <= MAX_N; n++) {
+        size_t off_a = n % (MAX_OFFSET + 1), off_b = (size_t)rand() % (MAX_OFFSET + 1);
+        passed[0] += check_copy(a, b, expected, n, off_a, off_b);
+        passed[1] += check_set(a, expected, n, off_a, n % 2 ? rand() : 0);
+        passed[2] += check_cmp(a, b, n, off_a, off_b);
+        checks++;
+    }
+    report("asm_memcpy", passed[0], checks);
+    report("asm_memset", passed[1], checks);
+    report("asm_memcmp", passed[2], checks);
+
+    // both sides of each threshold, so the STNP and DC ZVA paths run as well as the block loops
+    size_t edges[8];
+    int nedges = 0;
+    if (MEMOPS_NT_THRESHOLD && MEMOPS_NT_THRESHOLD + 200 <= MAX_BENCH) {
+        edges[nedges++] = MEMOPS_NT_THRESHOLD - 1;
+        edges[nedges++] = MEMOPS_NT_THRESHOLD;
+        edges[nedges++] = MEMOPS_NT_THRESHOLD + 131;
+    }
+    if (MEMOPS_ZVA_THRESHOLD) {
+        edges[nedges++] = MEMOPS_ZVA_THRESHOLD - 1;
+        edges[nedges++] = MEMOPS_ZVA_THRESHOLD;
+        edges[nedges++] = MEMOPS_ZVA_THRESHOLD + 131;
+    }
+    if (nedges > 0) {
+        printf("\nAround the thresholds (NT %d, ZVA %d bytes)\n", MEMOPS_NT_THRESHOLD, MEMOPS_ZVA_THRESHOLD);
+        memset(passed, 0, sizeof passed);
+        checks = 0;
+        for (int e = 0; e < nedges; e++) {
+            for (size_t off = 0; off <= MAX_OFFSET; off += 5) {
+                passed[0] += check_copy(a, b, expected, edges[e], off, MAX_OFFSET - off);
+                passed[1] += check_set(a, expected, edges[e], off, 0);
+                passed[2] += check_set(a, expected, edges[e], off, 0x1A5);
+                checks++;
+            }
+        }
+        report("asm_memcpy (large)", passed[0], checks);
+        report("asm_memset (large, 0)", passed[1], checks);
+        report("asm_memset (large, c)", passed[2], checks);
+    }
+    free(a);
+    free(b);
+    free(expected);
+}
+
+double seconds(struct timespec start, struct timespec end) {
+    return (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) * 1e-9;
+}
+
+// One timed pass: op 0 copies, 1 sets to 0, 2 compares equal ranges; asm or libc
+volatile int sink = 0;
+
+void call(int op, int use_asm, uint8_t *dst, const uint8_t *src, size_t n) {
+    if (op == 0) {
+        (use_asm ? asm_memcpy : libc_memcpy)(dst, src, n);
+    } else if (op == 1) {
+        (use_asm ? asm_memset : libc_memset)(dst, 0, n);
+    } else {
+        sink += (use_asm ? asm_memcmp : libc_memcmp)(dst, src, n);
+    }
+}
+
+// Best of 3 timings of enough calls to move about 64 MiB (at least 4 calls); returns bytes per second
+double rate(int op, int use_asm, uint8_t *dst, const uint8_t *src, size_t n) {
+    size_t calls = MAX_BENCH / n < 4 ? 4 : MAX_BENCH / n;
+    if (calls > (1 << 20)) {
+        calls = 1 << 20;
+    }
+    double best = 1e30;
+    for (int r = 0; r < 3; r++) {
+        struct timespec start, end;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for (size_t c = 0; c < calls; c++) {
+            call(op, use_asm, dst, src, n);
+        }
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        if (seconds(start, end) < best) {
+            best = seconds(start, end);
+        }
+    }
+    return (double)n * calls / best;
+}
+
+// Sizes drawn uniformly from 1..max at random offsets into a 64 KiB window, like a mix of real calls
+double random_rate(int op, int use_asm, uint8_t *dst, const uint8_t *src, const size_t *sizes, const size_t *offsets) {
+    size_t bytes = 0;
+    for (int i = 0; i < RANDOM_CALLS; i++) {
+        bytes += sizes[i];
+    }
+    double best = 1e30;
+    for (int r = 0; r < 20; r++) {
+        struct timespec start, end;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for (int i = 0; i < RANDOM_CALLS; i++) {
+            call(op, use_asm, dst + offsets[i], src + offsets[i], sizes[i]);
+        }
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        if (seconds(start, end) < best) {
+            best = seconds(start, end);
+        }
+    }
+    return (double)bytes / best;
+}
+
+void run_benchmark(double ghz) {
+    static const char *ops[] = { "memcpy", "memset", "memcmp" };
+    uint8_t *dst = malloc(MAX_BENCH), *src = malloc(MAX_BENCH), *same = malloc(MAX_BENCH);
+    static size_t sizes[RANDOM_CALLS], offsets[RANDOM_CALLS];
+
+    memset(dst, 1, MAX_BENCH);
+    memset(src, 1, MAX_BENCH);
+    memset(same, 1, MAX_BENCH);
+    printf("\n========================================\n");
+    printf("Throughput, best of 3 (GB/s; asm / libc)\n");
+    printf("========================================\n");
+    printf("%10s", "n");
+    for (int op = 0; op < 3; op++) {
+        printf(" %17s", ops[op]);
+    }
+    if (ghz > 0) {
+        printf(" %12s", "copy B/cycle");
+    }
+    printf("\n");
+    for (size_t n = 1; n <= MAX_BENCH; n *= 2) {
+        double copy_rate = 0;
+        printf("%10zu", n);
+        for (int op = 0; op < 3; op++) {
+            // memcmp compares src with an equal buffer, so it reads all n bytes of both
+            uint8_t *a = op == 2 ? same : dst;
+            double mine = rate(op, 1, a, src, n), libc = rate(op, 0, a, src, n);
+            printf(" %8.2f %8.2f", mine * 1e-9, libc * 1e-9);
+            if (op == 0) {
+                copy_rate = mine;
+            }
+        }
+        if (ghz > 0) {
+            printf(" %12.2f", copy_rate / (ghz * 1e9));
+        }
+        printf("\n");
+    }
+
+    printf("\nRandom sizes, %d calls per pass (GB/s; asm / libc)\n", RANDOM_CALLS);
+    static const size_t maxima[] = { 16, 128, 4096 };
+    for (int m = 0; m < 3; m++) {
+        for (int i = 0; i < RANDOM_CALLS; i++) {
+            sizes[i] = 1 + (size_t)rand() % maxima[m];
+            offsets[i] = (size_t)rand() % (64 << 10);
+        }
+        printf("    1-%-4zu", maxima[m]);
+        for (int op = 0; op < 3; op++) {
+            uint8_t *a = op == 2 ? same : dst;
+            printf(" %8.2f %8.2f", random_rate(op, 1, a, src, sizes, offsets) * 1e-9,
+                   random_rate(op, 0, a, src, sizes, offsets) * 1e-9);
+        }
+        printf("\n");
+    }
+    free(dst);
+    free(src);
+    free(same);
+}
+
+int main(int argc, char **argv) {
+    printf("memcpy/memset/memcmp Test Suite\n");
+    printf("===============================\n");
+
+    double ghz = argc > 1 ? atof(argv[1]) : 0;
+    srand((unsigned int)time(NULL));
+
+    run_tests();
+    run_benchmark(ghz);
+
+    printf("\n=== Final Test Summary ===\n");
+    printf("Total tests run: %d\n", total_tests);
+    printf("Tests passed:    %d\n", passed_tests);
+    printf("Tests failed:    %d\n", total_tests - passed_tests);
+    printf("Success rate:    %.2f%%\n", (double)passed_tests / total_tests * 100.0);
+
+    if (passed_tests == total_tests) {
+        printf("🎉 ALL TESTS PASSED! 🎉\n");
+        return 0;
+    } else {
+        printf("❌ SOME TESTS FAILED ❌\n");
+        return 1;
+    }
+}
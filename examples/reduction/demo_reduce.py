@@ -0,0 +1,396 @@
+#!/usr/bin/env python3
+"""
+Dot-product and reduction kernels: independent vector accumulators, a tree
+reduction across them and then across the lanes.
+
+    int32_t  dot_s8(const int8_t *a, const int8_t *b, size_t n)
+    int64_t  dot_s16(const int16_t *a, const int16_t *b, size_t n)
+    int32_t  sum_s8(const int8_t *a, size_t n)
+    int32_t  min_s16(const int16_t *a, size_t n)
+    ...
+
+    kernel            per 16-byte vector                           result
+    dot_s8 / dot_u8   SDOT / UDOT acc.4S, a.16B, b.16B             32-bit
+      widening        SMULL/SMULL2 .8H, SADALP acc.4S (U for u8)
+    dot_s16           SMULL/SMULL2 .4S, SADALP acc.2D              64-bit
+    dot_s32           SMLAL/SMLAL2 acc.2D                          64-bit
+    sum_s8 / sum_u8   SDOT / UDOT acc.4S, a.16B, ones              32-bit
+      widening        SADDLP .8H, SADALP acc.4S (U for u8)
+    sum_{s,u}16       SADALP / UADALP acc.4S, a.8H                 32-bit
+    sum_{s,u}32       SADALP / UADALP acc.2D, a.4S                 64-bit
+    min/max_{s,u}*    SMIN/UMIN/SMAX/UMAX acc, acc, a              element
+
+32-bit results wrap modulo 2^32 (dot_s8 is exact below 2^17 elements,
+sum_s16 below 2^16 of -32768), 64-bit ones modulo 2^64. min/max of zero
+elements return the identity (the type's maximum for min).
+
+Each pass of the main loop loads one vector per accumulator and stream
+(LD1 of up to four registers) and updates every accumulator once, so
+the accumulator chains are independent and their latency overlaps. The
+accumulator count is the smallest that reaches the machine model's best
+cycles per vector (ResMII / RecMII of the loop body; the ResMII counts
+one load-unit cycle per 16 loaded bytes, so the modeled input bandwidth
+never exceeds the model's load pipes). Leftover whole vectors go into
+the first accumulator, leftover elements through a zeroed (min/max:
+replicated) single-lane load. The accumulators are
+then combined pairwise (acc[i] op= acc[i + k/2], ...) and the last one
+across its lanes with ADDV / ADDP / xMINV / xMAXV.
+
+SDOT/UDOT are used where the model has them (model.supports("sdot"));
+elsewhere, and always for the _widen variants kept for comparison, the
+byte kernels use widening multiplies and pairwise adds.
+
+Usage:
+    python3 demo_reduce.py [model] [--accumulators K]
+"""
+
+import sys
+from dataclasses import dataclass
+
+from armasmgen.builder import ASMCode, BackgroundCode, Loop, record
+from armasmgen.machine import MODELS, NEOVERSE_N1
+from armasmgen.passes.modulo import ModuloSchedule
+from armasmgen.register import VECTOR_POOL, d_reg, w_reg, x_reg
+
+ACCUMULATORS = (1, 2, 4, 8)
+
+VIEWS = {8: "b16", 16: "h8", 32: "s4", 64: "d2"}
+CTYPES = {(8, True): "int8_t", (8, False): "uint8_t", (16, True): "int16_t", (16, False): "uint16_t",
+          (32, True): "int32_t", (32, False): "uint32_t", (64, True): "int64_t", (64, False): "uint64_t"}
+
+
+@dataclass(frozen=True)
+class Kernel:
+    op: str             # dot, sum, min or max
+    bits: int           # element size of the inputs
+    signed: bool
+    dot: bool = False   # byte kernels: SDOT/UDOT rather than widening
+
+    @property
+    def name(self) -> str:
+        suffix = "_widen" if self.bits == 8 and self.op in ("dot", "sum") and not self.dot else ""
+        return f"{self.op}_{'s' if self.signed else 'u'}{self.bits}{suffix}"
+
+    @property
+    def streams(self) -> int:
+        return 2 if self.op == "dot" else 1
+
+    @property
+    def acc_bits(self) -> int:
+        """Lane width of the accumulators"""
+        if self.op in ("min", "max"):
+            return self.bits
+        if self.op == "dot":
+            return 32 if self.bits == 8 else 64
+        return 64 if self.bits == 32 else 32
+
+    @property
+    def ctype(self) -> str:
+        return CTYPES[(self.bits, self.signed)]
+
+    @property
+    def result_ctype(self) -> str:
+        bits = 32 if self.op in ("min", "max") else self.acc_bits
+        return CTYPES[(bits, self.signed)]
+
+
+def kernels(model):
+    """Every kernel for the model; the byte dot/sum also as _widen when SDOT/UDOT are available."""
+    out = []
+    dot = model.supports("sdot")
+    for signed in (True, False):
+        out.append(Kernel("dot", 8, signed, dot))
+        if dot:
+            out.append(Kernel("dot", 8, signed, False))
+    out += [Kernel("dot", 16, True), Kernel("dot", 32, True)]
+    for bits in (8, 16, 32):
+        for signed in (True, False):
+            out.append(Kernel("sum", bits, signed, dot and bits == 8))
+            if dot and bits == 8:
+                out.append(Kernel("sum", bits, signed, False))
+    for op in ("min", "max"):
+        for bits in (8, 16, 32):
+            for signed in (True, False):
+                out.append(Kernel(op, bits, signed))
+    return out
+
+
+class Registers:
+    """Per accumulator: the input vector(s), a temporary where needed, the accumulator"""
+
+    def __init__(self, k: Kernel, count: int):
+        need = count * (k.streams + 1 + self.temps(k)) + (1 if k.op == "sum" and k.dot else 0)
+        if need > len(VECTOR_POOL):
+            raise ValueError(f"{k.name} with {count} accumulators needs {need} vector registers")
+        pool = iter(VECTOR_POOL)
+        self.a = [next(pool) for _ in range(count)]
+        self.b = [next(pool) for _ in range(count)] if k.streams == 2 else []
+        self.acc = [next(pool) for _ in range(count)]
+        self.tmp = [next(pool) for _ in range(count * self.temps(k))]
+        self.ones = next(pool) if k.op == "sum" and k.dot else None
+        self.used = VECTOR_POOL[:need]
+
+    @staticmethod
+    def temps(k: Kernel) -> int:
+        """The widening products need one register besides the inputs"""
+        return 1 if (k.op == "dot" and not k.dot and k.bits < 32) or (k.op == "sum" and k.bits == 8 and not k.dot) else 0
+
+
+def accumulate(m, k: Kernel, acc, a, b=None, tmp=None, ones=None):
+    """acc op= one 16-byte vector of a (and b)"""
+    s = k.signed
+    if k.op == "dot":
+        if k.bits == 8 and k.dot:
+            (m.VSDOT if s else m.VUDOT)(acc.s4, a.b16, b.b16)
+        elif k.bits == 8:
+            mull, adalp = (m.VSMULL, m.VSADALP) if s else (m.VUMULL, m.VUADALP)
+            mull(tmp.h8, a.b8, b.b8)
+            mull(a.h8, a.b16, b.b16)        # smull2 reads a before writing it
+            adalp(acc.s4, tmp.h8)
+            adalp(acc.s4, a.h8)
+        elif k.bits == 16:
+            m.VSMULL(tmp.s4, a.h4, b.h4)
+            m.VSMULL(a.s4, a.h8, b.h8)
+            m.VSADALP(acc.d2, tmp.s4)
+            m.VSADALP(acc.d2, a.s4)
+        else:
+            m.VSMLAL(acc.d2, a.s2, b.s2)
+            m.VSMLAL(acc.d2, a.s4, b.s4)
+    elif k.op == "sum":
+        adalp = m.VSADALP if s else m.VUADALP
+        if k.bits == 8 and k.dot:
+            (m.VSDOT if s else m.VUDOT)(acc.s4, a.b16, ones.b16)
+        elif k.bits == 8:
+            (m.VSADDLP if s else m.VUADDLP)(tmp.h8, a.b16)
+            adalp(acc.s4, tmp.h8)
+        elif k.bits == 16:
+            adalp(acc.s4, a.h8)
+        else:
+            adalp(acc.d2, a.s4)
+    else:
+        view = VIEWS[k.bits]
+        op = {("min", True): m.VSMIN, ("min", False): m.VUMIN,
+              ("max", True): m.VSMAX, ("max", False): m.VUMAX}[(k.op, s)]
+        op(getattr(acc, view), getattr(acc, view), getattr(a, view))
+
+
+def combine(m, k: Kernel, d, n):
+    """d = d op n, lane by lane"""
+    view = VIEWS[k.acc_bits]
+    if k.op in ("dot", "sum"):
+        m.VADD(getattr(d, view), getattr(d, view), getattr(n, view))
+    else:
+        accumulate(m, k, d, n)
+
+
+def load(m, regs, ptr):
+    """One 16-byte vector per register, LD1 lists of up to four"""
+    for i in range(0, len(regs), 4):
+        group = [r.b16 for r in regs[i:i + 4]]
+        m.LD1(group, ptr, 16 * len(group))
+
+
+def main_body(m, k: Kernel, r: Registers):
+    ptr_a, ptr_b = x_reg(0), x_reg(1)
+    load(m, r.a, ptr_a)
+    if r.b:
+        load(m, r.b, ptr_b)
+    for i, acc in enumerate(r.acc):
+        accumulate(m, k, acc, r.a[i], r.b[i] if r.b else None, r.tmp[i] if r.tmp else None, r.ones)
+
+
+def cycles_per_vector(k: Kernel, count: int, model) -> float:
+    """Modeled cycles per 16-byte vector of each stream with count accumulators"""
+    r = Registers(k, count)
+    res_mii, rec_mii = ModuloSchedule.bounds(record(lambda s: main_body(s, k, r)), model, noalias=True)
+    return max(res_mii, rec_mii) / count
+
+
+def best_accumulators(k: Kernel, model) -> int:
+    """The fewest accumulators at the best modeled cycles per vector"""
+    options = []
+    for count in ACCUMULATORS:
+        try:
+            options.append((cycles_per_vector(k, count, model), count))
+        except ValueError:
+            continue
+    best = min(c for c, _ in options)
+    return min(count for c, count in options if c == best)
+
+
+def identity(k: Kernel) -> int:
+    """Lane value min/max start from"""
+    if k.op == "min":
+        return (1 << (k.bits - 1)) - 1 if k.signed else (1 << k.bits) - 1
+    return 1 << (k.bits - 1) if k.signed else 0
+
+
+def create_kernel(k: Kernel, count: int):
+    """{op}_{type}(a[, b], n): the reduction with count accumulators."""
+    r = Registers(k, count)
+    lanes = 128 // k.bits
+    ptr_a, ptr_b = x_reg(0), x_reg(1)
+    n = x_reg(k.streams)
+    blocks, vectors, elements, tmp = x_reg(9), x_reg(10), x_reg(11), x_reg(12)
+    saved = sorted({reg.number for reg in r.used} & set(range(8, 16)))
+    saved = [(d_reg(i), d_reg(i + 1)) for i in sorted({s - s % 2 for s in saved})]
+    acc_view = VIEWS[k.acc_bits]
+
+    with ASMCode(label=k.name) as f:
+        for r0, r1 in saved:
+            f.STP_pre(r0, r1, "sp", -16)
+        if k.op in ("min", "max"):
+            value = identity(k)
+            f.MOVZ(tmp, value & 0xFFFF)
+            if value >> 16:
+                f.MOVK(tmp, value >> 16, 16)
+            for acc in r.acc:
+                f.VDUP(getattr(acc, acc_view), w_reg(tmp.number))
+        else:
+            for acc in r.acc:
+                f.VMOVI(acc.s4, 0)
+        if r.ones is not None:
+            f.VMOVI(r.ones.b16, 1)
+
+        shift = (lanes * count).bit_length() - 1
+        f.LSR(blocks, n, shift)
+        with Loop(blocks, label=f"{k.name}_block") as lp:
+            main_body(lp, k, r)
+
+        # Whole vectors left over: into the first accumulator
+        a0, b0 = r.a[0], r.b[0] if r.b else None
+        t0 = r.tmp[0] if r.tmp else None
+        if count > 1:
+            f.LSR(vectors, n, lanes.bit_length() - 1)
+            f.AND_imm(vectors, vectors, count - 1)
+            with Loop(vectors, label=f"{k.name}_vector") as lp:
+                lp.LD1(a0.b16, ptr_a, 16)
+                if b0 is not None:
+                    lp.LD1(b0.b16, ptr_b, 16)
+                accumulate(lp, k, r.acc[0], a0, b0, t0, r.ones)
+
+        # Elements left over: one lane each, the rest zero (min/max: the element everywhere)
+        f.AND_imm(elements, n, lanes - 1)
+        elem = lambda reg: getattr(reg, VIEWS[k.bits])[0]
+        with Loop(elements, label=f"{k.name}_element") as lp:
+            if k.op in ("min", "max"):
+                lp.LD1R(getattr(a0, VIEWS[k.bits]), ptr_a, k.bits // 8)
+            else:
+                lp.VMOVI(a0.s4, 0)
+                lp.LD1(elem(a0), ptr_a, k.bits // 8)
+                if b0 is not None:
+                    lp.VMOVI(b0.s4, 0)
+                    lp.LD1(elem(b0), ptr_b, k.bits // 8)
+            accumulate(lp, k, r.acc[0], a0, b0, t0, r.ones)
+
+        # Tree: acc[i] op= acc[i + half], halving, then across the lanes
+        live = list(r.acc)
+        while len(live) > 1:
+            half = len(live) // 2
+            for i in range(half):
+                combine(f, k, live[i], live[i + half])
+            live = live[:half]
+        acc = live[0]
+        if k.op in ("dot", "sum"):
+            if k.acc_bits == 64:
+                f.VADDP(acc.d2, acc.d2)
+                f.VUMOV(x_reg(0), acc.d2[0])
+            else:
+                f.VADDV(acc.s4, acc.s4)
+                f.VUMOV("w0", acc.s4[0])
+        else:
+            view = getattr(acc, VIEWS[k.bits])
+            across = {("min", True): f.VSMINV, ("min", False): f.VUMINV,
+                      ("max", True): f.VSMAXV, ("max", False): f.VUMAXV}[(k.op, k.signed)]
+            across(view, view)
+            if k.signed and k.bits < 32:
+                f.VSMOV("w0", view[0])
+            else:
+                f.VUMOV("w0", view[0])
+
+        for r0, r1 in reversed(saved):
+            f.LDP_post(r0, r1, "sp", 16)
+
+
+def write_header(path: str, table, model):
+    """reduce_kernels.h: prototypes and one table entry per kernel for test_reduce.c."""
+    lines = [
+        f"// Generated by demo_reduce.py for {model.name}: the kernels in reduce.s",
+        "#include <stddef.h>",
+        "#include <stdint.h>",
+        "",
+    ]
+    for k, _, _ in table:
+        args = f"const {k.ctype} *a, const {k.ctype} *b, size_t n" if k.op == "dot" else f"const {k.ctype} *a, size_t n"
+        lines.append(f"extern {k.result_ctype} {k.name}({args});")
+    lines += [
+        "",
+        "enum reduce_op { REDUCE_DOT, REDUCE_SUM, REDUCE_MIN, REDUCE_MAX };",
+        "",
+        "static const struct reduce_kernel {",
+        "    const char *name;",
+        "    enum reduce_op op;",
+        "    int bits;               // element size of the inputs",
+        "    int is_signed;",
+        "    int result_bits;        // the result wraps modulo 2^result_bits",
+        "    int accumulators;",
+        "    double model_bytes;     // input bytes per cycle under the machine model",
+        "    void (*fn)(void);",
+        "} reduce_kernels[] = {",
+    ]
+    for k, count, per_vector in table:
+        result_bits = 32 if k.op in ("min", "max") else k.acc_bits
+        lines.append(
+            f'    {{ "{k.name}", REDUCE_{k.op.upper()}, {k.bits}, {int(k.signed)}, {result_bits}, {count}, '
+            f"{16 * k.streams / per_vector:.2f}, (void (*)(void)){k.name} }},")
+    lines += [
+        "};",
+        "",
+        "#define REDUCE_NKERNELS (int)(sizeof reduce_kernels / sizeof reduce_kernels[0])",
+        "",
+    ]
+    with open(path, "w") as fh:
+        fh.write("\n".join(lines))
+
+
+def parse_args(args):
+    model, forced = NEOVERSE_N1, None
+    while args:
+        arg = args.pop(0)
+        if arg == "--accumulators" and args:
+            forced = int(args.pop(0))
+            if forced not in ACCUMULATORS:
+                raise ValueError(f"--accumulators takes one of {ACCUMULATORS}, got {forced}")
+        elif arg in MODELS:
+            model = MODELS[arg]
+        else:
+            raise ValueError(f"usage: demo_reduce.py [{'|'.join(MODELS)}] [--accumulators K]")
+    return model, forced
+
+
+def main():
+    model, forced = parse_args(sys.argv[1:])
+    print(f"=== Dot-Product and Reduction Generator ({model.name}) ===")
+    if not model.supports("sdot"):
+        print(f"- {model.name} has no SDOT/UDOT: byte dot products and sums widen")
+    table = []
+    for k in kernels(model):
+        count = forced or best_accumulators(k, model)
+        per_vector = cycles_per_vector(k, count, model)
+        table.append((k, count, per_vector))
+        print(f"✓ {k.name:<14} {count} accumulators, {per_vector:.2f} cycles per vector "
+              f"({16 * k.streams / per_vector:.1f} B/cycle)")
+
+    out = BackgroundCode()
+    with out:
+        for k, count, _ in table:
+            create_kernel(k, count)
+    out.export_to_file("reduce.s")
+    write_header("reduce_kernels.h", table, model)
+    print("✓ Assembly exported to: reduce.s")
+    print("✓ Kernel table written to: reduce_kernels.h")
+    print("Run 'make run' to check the kernels against scalar code and measure GB/s.")
+
+
+if __name__ == "__main__":
+    main()
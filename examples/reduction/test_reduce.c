@@ -0,0 +1,180 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "reduce_kernels.h"
+
+#define CHECKS 300
+#define MAX_N 1000                  // largest n the checks use
+#define MAX_OFFSET 15               // checks also start 1..MAX_OFFSET elements past an aligned address
+#define CACHE_BYTES (32 << 10)      // the in-cache benchmark reads this many bytes per stream
+#define MEMORY_BYTES (64 << 20)     // and the streaming benchmark this many
+
+static const char *op_names[] = { "dot", "sum", "min", "max" };
+
+typedef uint64_t (*binary64_fn)(const void *, const void *, size_t);
+typedef uint32_t (*binary32_fn)(const void *, const void *, size_t);
+typedef uint64_t (*unary64_fn)(const void *, size_t);
+typedef uint32_t (*unary32_fn)(const void *, size_t);
+
+// Global test counters
+int total_tests = 0;
+int passed_tests = 0;
+
+// Element i as a 64-bit integer
+int64_t get_elem(const void *p, size_t i, const struct reduce_kernel *k) {
+    if (k->is_signed) {
+        switch (k->bits) {
+        case 8:  return ((const int8_t *)p)[i];
+        case 16: return ((const int16_t *)p)[i];
+        default: return ((const int32_t *)p)[i];
+        }
+    }
+    switch (k->bits) {
+    case 8:  return ((const uint8_t *)p)[i];
+    case 16: return ((const uint16_t *)p)[i];
+    default: return ((const uint32_t *)p)[i];
+    }
+}
+
+// The result bits of k->fn(a, b, n); b is ignored by the single-stream kernels
+uint64_t call(const struct reduce_kernel *k, const void *a, const void *b, size_t n) {
+    if (k->op == REDUCE_DOT) {
+        return k->result_bits == 64 ? ((binary64_fn)k->fn)(a, b, n) : ((binary32_fn)k->fn)(a, b, n);
+    }
+    return k->result_bits == 64 ? ((unary64_fn)k->fn)(a, n) : ((unary32_fn)k->fn)(a, n);
+}
+
+// The same reduction in scalar code; sums wrap modulo 2^result_bits like the kernels,
+// min/max of nothing are the largest/smallest element value
+uint64_t reference(const struct reduce_kernel *k, const void *a, const void *b, size_t n) {
+    int64_t lo = k->is_signed ? -((int64_t)1 << (k->bits - 1)) : 0;
+    int64_t hi = k->is_signed ? ((int64_t)1 << (k->bits - 1)) - 1 : (int64_t)(((uint64_t)1 << k->bits) - 1);
+    uint64_t r = k->op == REDUCE_MIN ? (uint64_t)hi : k->op == REDUCE_MAX ? (uint64_t)lo : 0;
+    for (size_t i = 0; i < n; i++) {
+        int64_t x = get_elem(a, i, k);
+        switch (k->op) {
+        case REDUCE_DOT: r += (uint64_t)(x * get_elem(b, i, k)); break;
+        case REDUCE_SUM: r += (uint64_t)x; break;
+        case REDUCE_MIN: r = x < (int64_t)r ? (uint64_t)x : r; break;
+        case REDUCE_MAX: r = x > (int64_t)r ? (uint64_t)x : r; break;
+        }
+    }
+    return k->result_bits == 64 ? r : (uint32_t)r;
+}
+
+// Random elements, or only the extreme values (0, -1, the minimum, the maximum) that overflow narrow accumulators
+void fill(uint8_t *p, size_t bytes, const struct reduce_kernel *k, int extreme) {
+    static const uint8_t low[] = { 0x00, 0xFF, 0x00, 0xFF }, top[] = { 0x00, 0xFF, 0x80, 0x7F };
+    int eb = k->bits / 8;
+    for (size_t i = 0; i + eb <= bytes; i += eb) {
+        int e = rand() % 4;
+        for (int j = 0; j < eb; j++) {
+            p[i + j] = !extreme ? (uint8_t)rand() : j == eb - 1 ? top[e] : low[e];
+        }
+    }
+}
+
+void run_tests() {
+    static uint8_t a[(MAX_N + MAX_OFFSET) * 4 + 16], b[(MAX_N + MAX_OFFSET) * 4 + 16];
+
+    printf("\n========================================\n");
+    printf("Kernels against a scalar reference\n");
+    printf("========================================\n");
+
+    for (int i = 0; i < REDUCE_NKERNELS; i++) {
+        const struct reduce_kernel *k = &reduce_kernels[i];
+        int eb = k->bits / 8, passed = 0;
+        for (int t = 0; t < CHECKS; t++) {
+            size_t n = t < 70 ? (size_t)t : (size_t)rand() % (MAX_N + 1);
+            size_t offset = t % 3 == 0 ? (size_t)rand() % (MAX_OFFSET + 1) : 0;
+            fill(a, sizeof(a), k, t % 2);
+            fill(b, sizeof(b), k, t % 2);
+            const uint8_t *pa = a + offset * eb, *pb = b + offset * eb;
+            passed += call(k, pa, pb, n) == reference(k, pa, pb, n);
+        }
+        total_tests += CHECKS;
+        passed_tests += passed;
+        printf("%-14s %s %2d-bit %-8s: %d/%d passed\n", k->name, op_names[k->op], k->bits,
+               k->is_signed ? "signed" : "unsigned", passed, CHECKS);
+    }
+}
+
+double seconds(struct timespec start, struct timespec end) {
+    return (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) * 1e-9;
+}
+
+// Best time of several passes over `bytes` of input per stream; GB/s counts every stream
+void run_benchmark(double ghz) {
+    static const size_t sizes[] = { CACHE_BYTES, MEMORY_BYTES };
+    uint8_t *a = malloc(MEMORY_BYTES), *b = malloc(MEMORY_BYTES);
+    struct timespec start, end;
+    volatile uint64_t sink = 0;
+
+    memset(a, 1, MEMORY_BYTES);
+    memset(b, 2, MEMORY_BYTES);
+    printf("\n========================================\n");
+    printf("Throughput, best of several passes (GB/s of input read)\n");
+    printf("========================================\n");
+    printf("%-14s %4s %10s %10s", "kernel", "acc", "32 KiB", "64 MiB");
+    if (ghz > 0) {
+        printf(" %10s %10s", "B/cycle", "model");
+    }
+    printf("\n");
+
+    for (int i = 0; i < REDUCE_NKERNELS; i++) {
+        const struct reduce_kernel *k = &reduce_kernels[i];
+        int streams = k->op == REDUCE_DOT ? 2 : 1;
+        double rate[2];
+        for (int s = 0; s < 2; s++) {
+            size_t n = sizes[s] / (k->bits / 8);
+            int passes = s == 0 ? 2000 : 5;
+            double best = 1e30;
+            for (int r = 0; r < 5; r++) {
+                clock_gettime(CLOCK_MONOTONIC, &start);
+                for (int p = 0; p < passes; p++) {
+                    sink += call(k, a, b, n);
+                }
+                clock_gettime(CLOCK_MONOTONIC, &end);
+                if (seconds(start, end) < best) {
+                    best = seconds(start, end);
+                }
+            }
+            rate[s] = (double)sizes[s] * streams * passes / best;
+        }
+        printf("%-14s %4d %10.2f %10.2f", k->name, k->accumulators, rate[0] * 1e-9, rate[1] * 1e-9);
+        if (ghz > 0) {
+            printf(" %10.2f %10.2f", rate[0] / (ghz * 1e9), k->model_bytes);
+        }
+        printf("\n");
+    }
+    free(a);
+    free(b);
+}
+
+int main(int argc, char **argv) {
+    printf("Dot-Product and Reduction Test Suite\n");
+    printf("====================================\n");
+
+    double ghz = argc > 1 ? atof(argv[1]) : 0;
+    srand((unsigned int)time(NULL));
+
+    run_tests();
+    run_benchmark(ghz);
+
+    printf("\n=== Final Test Summary ===\n");
+    printf("Total tests run: %d\n", total_tests);
+    printf("Tests passed:    %d\n", passed_tests);
+    printf("Tests failed:    %d\n", total_tests - passed_tests);
+    printf("Success rate:    %.2f%%\n", (double)passed_tests / total_tests * 100.0);
+
+    if (passed_tests == total_tests) {
+        printf("🎉 ALL TESTS PASSED! 🎉\n");
+        return 0;
+    } else {
+        printf("❌ SOME TESTS FAILED ❌\n");
+        return 1;
+    }
+}
@@ -0,0 +1,241 @@
+#!/usr/bin/env python3
+"""
+Vector-length-agnostic SVE kernels: one binary, any vector length from
+128 to 2048 bits.
+
+    void     sve_vadd_f32(float *dst, const float *a, const float *b, size_t n)
+    int32_t  sve_dot_s8(const int8_t *a, const int8_t *b, size_t n)
+    void     sve_mul128_r32(uint32_t *r, const uint32_t *a, const uint32_t *b, size_t count)
+    void     sve_mul256_r32(uint32_t *r, const uint32_t *a, const uint32_t *b, size_t count)
+    size_t   sve_vector_bytes(void)
+
+Each kernel is a PredicatedLoop: WHILELT builds the predicate of the
+lanes still below n, so the last, partial vector runs through the same
+code with the other lanes inactive and there is no remainder loop.
+
+    sve_vadd_f32     LD1W a, b; FADD; ST1W
+    sve_dot_s8       LD1B a, b; SDOT into 32-bit lanes of K accumulators,
+                     one per vector of a pass (vector k under a WHILELT
+                     from index + k vectors), so the SDOT chains overlap;
+                     the accumulators are added and UADDV sums the lanes
+                     after the loop (wraps modulo 2^32, like dot_s8 in
+                     ../reduction). K is the smallest of 1, 2, 4 at the
+                     model's best cycles per vector.
+    sve_mul{128,256}_r32
+                     count independent products of 4 (8) radix-2^32 limbs,
+                     limb-major: limb i of number j is a[i·count + j], one
+                     number per 64-bit lane. LD1W zero-extends the limbs
+                     into the lanes, MUL gives the exact 64-bit product
+                     (MOVPRFX keeps the operands), and a column sums the
+                     low halves (AND with a 2^32 - 1 mask) and the high
+                     halves (LSR #32) of its products separately; ST1W
+                     stores the low 32 bits of each column sum and the
+                     rest carries into the next column. Only MUL is
+                     predicated, so no lane merges an old value and the
+                     passes over successive vectors are independent.
+
+The printed cycles are ResMII/RecMII of the loop body under the machine
+model (neoverse-v1 by default), per vector.
+
+Usage:
+    python3 demo_sve.py [model]
+"""
+
+import sys
+
+from armasmgen.builder import ASMCode, BackgroundCode, PredicatedLoop, record
+from armasmgen.machine import MODELS, NEOVERSE_V1
+from armasmgen.passes.modulo import ModuloSchedule
+from armasmgen.register import p_reg, v_reg, w_reg, x_reg, z_reg
+
+# z8-z15 would need their low 64 bits saved (d8-d15), so kernels use the others
+Z_POOL = [z_reg(i) for i in list(range(8)) + list(range(16, 32))]
+MUL_LIMBS = (4, 8)
+DOT_ACCUMULATORS = (1, 2, 4)
+
+
+def vadd_body(m):
+    pg, a, b = p_reg(0), z_reg(0).s, z_reg(1).s
+    m.LD1W(a, pg, x_reg(1), x_reg(9))
+    m.LD1W(b, pg, x_reg(2), x_reg(9))
+    m.ZFADD(a, a, b)
+    m.ST1W(a, pg, x_reg(0), x_reg(9))
+
+
+def dot_registers(k: int):
+    """Inputs a, b and accumulators for k vectors per pass"""
+    return Z_POOL[:k], Z_POOL[k:2 * k], Z_POOL[2 * k:3 * k]
+
+
+def dot_body(m, k: int):
+    """Vector i of the pass at index x9 + i vectors, under p<i> (p0: the loop's own predicate)"""
+    a, b, acc = dot_registers(k)
+    for i in range(k):
+        pg, idx = p_reg(i), x_reg(9 + i)
+        if i:
+            m.ADDVL(idx, x_reg(9), i)
+            m.WHILELT(pg.b, idx, x_reg(2))
+        m.LD1B(a[i].b, pg, x_reg(0), idx)
+        m.LD1B(b[i].b, pg, x_reg(1), idx)
+        m.ZSDOT(acc[i].s, a[i].b, b[i].b)
+
+
+def mul_body(m, limbs: int):
+    """
+    One vector of numbers: x9 is the first number, x3 the count (the limb stride).
+    Column c sums lo32 and hi32 of a[i]·b[c-i] in s and t; s starts from the carry.
+    z4 holds the mask 2^32 - 1 (set up by create_mul).
+    """
+    pg = p_reg(0)
+    r, a_ptr, b_ptr, count, idx = x_reg(0), x_reg(1), x_reg(2), x_reg(3), x_reg(10)
+    a = [z.d for z in Z_POOL[8:8 + limbs]]
+    b = [z.d for z in Z_POOL[8 + limbs:8 + 2 * limbs]]
+    s, t, prod, half, mask = (z.d for z in Z_POOL[:5])
+
+    m.MOV(idx, x_reg(9))
+    for i in range(limbs):
+        m.LD1W(a[i], pg, a_ptr, idx)
+        m.LD1W(b[i], pg, b_ptr, idx)
+        if i < limbs - 1:
+            m.ADD(idx, idx, count)
+    m.MOV(idx, x_reg(9))
+    for c in range(2 * limbs - 1):
+        terms = [(i, c - i) for i in range(limbs) if 0 <= c - i < limbs]
+        for n, (i, j) in enumerate(terms):
+            m.ZMOVPRFX(prod, a[i])
+            m.ZMUL(prod, pg, b[j])
+            if n == 0:
+                m.ZLSR(t, prod, 32)
+            else:
+                m.ZLSR(half, prod, 32)
+                m.ZADD(t, t, half)
+            if c == 0:
+                m.ZAND(s, prod, mask)
+            else:
+                m.ZAND(prod, prod, mask)
+                m.ZADD(s, s, prod)
+        m.ST1W(s, pg, r, idx)
+        m.ADD(idx, idx, count)
+        m.ZLSR(s, s, 32)
+        m.ZADD(s, s, t)
+    m.ST1W(s, pg, r, idx)
+
+
+def create_vadd(name: str = "sve_vadd_f32"):
+    with ASMCode(label=name):
+        with PredicatedLoop(x_reg(9), x_reg(3), p_reg(0).s, label=f"{name}_loop") as lp:
+            vadd_body(lp)
+
+
+def create_dot(k: int, name: str = "sve_dot_s8"):
+    _, _, acc = dot_registers(k)
+    with ASMCode(label=name) as f:
+        for z in acc:
+            f.ZDUP(z.s, 0)
+        with PredicatedLoop(x_reg(9), x_reg(2), p_reg(0).b, vectors=k, label=f"{name}_loop") as lp:
+            dot_body(lp, k)
+        while len(acc) > 1:
+            half = len(acc) // 2
+            for i in range(half):
+                f.ZADD(acc[i].s, acc[i].s, acc[i + half].s)
+            acc = acc[:half]
+        f.PTRUE(p_reg(1).s)
+        f.ZUADDV(acc[0], p_reg(1), acc[0].s)
+        f.VUMOV(w_reg(0), v_reg(acc[0].number).s4[0])
+
+
+def create_mul(limbs: int):
+    name = f"sve_mul{32 * limbs}_r32"
+    mask = z_reg(4).d
+    with ASMCode(label=name) as f:
+        f.ZDUP(mask, -1)
+        f.ZLSR(mask, mask, 32)
+        with PredicatedLoop(x_reg(9), x_reg(3), p_reg(0).d, label=f"{name}_loop") as lp:
+            mul_body(lp, limbs)
+    return name
+
+
+def create_vector_bytes(name: str = "sve_vector_bytes"):
+    with ASMCode(label=name) as f:
+        f.RDVL(x_reg(0), 1)
+
+
+def cycles(emit, model, vectors: int = 1) -> float:
+    """Modeled cycles per vector: a pass of the loop body covers `vectors`"""
+    return max(ModuloSchedule.bounds(record(emit), model, noalias=True)) / vectors
+
+
+def dot_accumulators(model) -> int:
+    """The fewest accumulators at the best modeled cycles per vector"""
+    options = [(cycles(lambda s, k=k: dot_body(s, k), model, k), k) for k in DOT_ACCUMULATORS]
+    best = min(c for c, _ in options)
+    return min(k for c, k in options if c == best)
+
+
+def write_header(path: str, table, model):
+    lines = [
+        f"// Generated by demo_sve.py for {model.name}: the kernels in sve.s",
+        "#include <stddef.h>",
+        "#include <stdint.h>",
+        "",
+        "extern void sve_vadd_f32(float *dst, const float *a, const float *b, size_t n);",
+        "extern int32_t sve_dot_s8(const int8_t *a, const int8_t *b, size_t n);",
+    ]
+    lines += [f"extern void {name}(uint32_t *r, const uint32_t *a, const uint32_t *b, size_t count);"
+              for name, limbs, _ in table if limbs]
+    lines += [
+        "extern size_t sve_vector_bytes(void);",
+        "",
+        "static const struct sve_kernel {",
+        "    const char *name;",
+        "    int limbs;              // radix-2^32 limbs per operand; 0 for vadd and dot",
+        "    double model_cycles;    // cycles per vector under the machine model",
+        "} sve_kernels[] = {",
+    ]
+    lines += [f'    {{ "{name}", {limbs}, {per_vector:.2f} }},' for name, limbs, per_vector in table]
+    lines += ["};", ""]
+    lines += ["typedef void (*sve_mul_fn)(uint32_t *, const uint32_t *, const uint32_t *, size_t);"]
+    lines += ["static const sve_mul_fn sve_mul_kernels[] = { "
+              + ", ".join(name for name, limbs, _ in table if limbs) + " };"]
+    lines += ["#define SVE_NMUL (int)(sizeof sve_mul_kernels / sizeof sve_mul_kernels[0])", ""]
+    with open(path, "w", encoding="utf-8") as f:
+        f.write("\n".join(lines))
+
+
+def main():
+    args = sys.argv[1:]
+    if len(args) > 1 or (args and args[0] not in MODELS):
+        raise ValueError(f"usage: demo_sve.py [{'|'.join(MODELS)}]")
+    model = MODELS[args[0]] if args else NEOVERSE_V1
+    print(f"=== SVE Kernel Generator ({model.name}) ===")
+    if not model.supports("whilelt"):
+        print(f"- {model.name} has no SVE; the cycles use default timings for the SVE instructions")
+
+    dot_k = dot_accumulators(model)
+    table = [("sve_vadd_f32", 0, cycles(vadd_body, model)),
+             ("sve_dot_s8", 0, cycles(lambda s: dot_body(s, dot_k), model, dot_k))]
+    table += [(f"sve_mul{32 * limbs}_r32", limbs, cycles(lambda s, k=limbs: mul_body(s, k), model))
+              for limbs in MUL_LIMBS]
+
+    out = BackgroundCode()
+    with out:
+        create_vadd()
+        create_dot(dot_k)
+        for limbs in MUL_LIMBS:
+            create_mul(limbs)
+        create_vector_bytes()
+    out.export_to_file("sve.s")
+    write_header("sve_kernels.h", table, model)
+
+    for name, limbs, per_vector in table:
+        what = f" ({limbs * limbs} products of {limbs} limbs per lane)" if limbs else ""
+        if name == "sve_dot_s8":
+            what = f" ({dot_k} accumulators)"
+        print(f"✓ {name:<16} {per_vector:6.2f} cycles per vector{what}")
+    print("✓ Assembly exported to: sve.s")
+    print("✓ Kernel table written to: sve_kernels.h")
+    print("Run 'make run' to check the kernels at every vector length the CPU (or qemu) offers.")
+
+
+if __name__ == "__main__":
+    main()
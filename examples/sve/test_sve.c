@@ -0,0 +1,244 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdlib.h>
+#include <time.h>
+#include <sys/prctl.h>
+
+#include "sve_kernels.h"
+
+// Linux sets the SVE vector length of a thread with prctl (the kernels read it with RDVL/INC/WHILELT)
+#ifndef PR_SVE_SET_VL
+#define PR_SVE_SET_VL 50
+#define PR_SVE_GET_VL 51
+#endif
+#define PR_SVE_VL_LEN_MASK 0xffff
+
+#define CHECKS 100
+#define MAX_N 1000                  // largest n (count) the checks use
+#define BENCH_BYTES (32 << 10)      // vadd/dot benchmark: bytes per input stream, in cache
+#define BENCH_COUNT 1024            // mul benchmark: products per call
+#define GUARD 0x5A5A5A5AU
+
+// Global test counters
+int total_tests = 0;
+int passed_tests = 0;
+
+uint32_t rand32(void) {
+    return (uint32_t)rand() ^ ((uint32_t)rand() << 16);
+}
+
+double seconds(struct timespec start, struct timespec end) {
+    return (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) * 1e-9;
+}
+
+// Small values keep the sums exact, so the kernel must match bit for bit
+int check_vadd(size_t n) {
+    static float a[MAX_N], b[MAX_N], r[MAX_N + 1];
+    for (size_t i = 0; i < n; i++) {
+        a[i] = (float)(rand() % 2001 - 1000) / 8;
+        b[i] = (float)(rand() % 2001 - 1000) / 4;
+    }
+    memcpy(&r[n], &(uint32_t){ GUARD }, 4);
+    sve_vadd_f32(r, a, b, n);
+    for (size_t i = 0; i < n; i++) {
+        if (r[i] != a[i] + b[i]) {
+            return 0;
+        }
+    }
+    return memcmp(&r[n], &(uint32_t){ GUARD }, 4) == 0;
+}
+
+// The sum wraps modulo 2^32 like the kernel
+int check_dot(size_t n) {
+    static int8_t a[MAX_N], b[MAX_N];
+    uint32_t expected = 0;
+    for (size_t i = 0; i < n; i++) {
+        a[i] = rand() % 8 ? (int8_t)rand() : -128;
+        b[i] = rand() % 8 ? (int8_t)rand() : -128;
+        expected += (uint32_t)(a[i] * b[i]);
+    }
+    return (uint32_t)sve_dot_s8(a, b, n) == expected;
+}
+
+// Limb i of number j is at [i·count + j]; the product has 2·limbs limbs in the same layout
+void mul_reference(int limbs, uint32_t *r, const uint32_t *a, const uint32_t *b, size_t count) {
+    for (size_t j = 0; j < count; j++) {
+        uint32_t t[16] = { 0 };
+        for (int i = 0; i < limbs; i++) {
+            uint64_t carry = 0;
+            for (int k = 0; k < limbs; k++) {
+                uint64_t p = (uint64_t)a[i * count + j] * b[k * count + j] + t[i + k] + carry;
+                t[i + k] = (uint32_t)p;
+                carry = p >> 32;
+            }
+            t[i + limbs] = (uint32_t)carry;
+        }
+        for (int i = 0; i < 2 * limbs; i++) {
+            r[i * count + j] = t[i];
+        }
+    }
+}
+
+int check_mul(int n, size_t count) {
+    static uint32_t a[8 * MAX_N], b[8 * MAX_N], r[16 * MAX_N + 1], expected[16 * MAX_N];
+    int limbs = sve_kernels[2 + n].limbs;
+    for (size_t i = 0; i < limbs * count; i++) {
+        // all-ones limbs make the largest column sums and carries
+        a[i] = rand() % 4 ? rand32() : 0xFFFFFFFFU;
+        b[i] = rand() % 4 ? rand32() : 0xFFFFFFFFU;
+    }
+    r[2 * limbs * count] = GUARD;
+    sve_mul_kernels[n](r, a, b, count);
+    mul_reference(limbs, expected, a, b, count);
+    return memcmp(r, expected, 4 * 2 * limbs * count) == 0 && r[2 * limbs * count] == GUARD;
+}
+
+void run_tests(size_t vl) {
+    printf("\nKernels against scalar code\n");
+    // a vector of 64-bit lanes (mul numbers), 32-bit lanes (vadd floats) and 8-bit lanes (dot bytes)
+    size_t edges[] = { 0, 1, vl / 8 - 1, vl / 8, vl / 8 + 1, vl / 4 - 1, vl / 4, vl / 4 + 1, vl - 1, vl, vl + 1 };
+    int nedges = (int)(sizeof edges / sizeof edges[0]);
+    int passed[2 + SVE_NMUL] = { 0 };
+    for (int t = 0; t < CHECKS; t++) {
+        // the first checks hit the partial-vector edges, the rest are random
+        size_t n = t < nedges ? edges[t] : (size_t)rand() % (MAX_N + 1);
+        passed[0] += check_vadd(n);
+        passed[1] += check_dot(n);
+        for (int k = 0; k < SVE_NMUL; k++) {
+            passed[2 + k] += check_mul(k, n);
+        }
+    }
+    for (int k = 0; k < 2 + SVE_NMUL; k++) {
+        total_tests += CHECKS;
+        passed_tests += passed[k];
+        printf("%-16s: %d/%d passed\n", sve_kernels[k].name, passed[k], CHECKS);
+    }
+}
+
+void run_benchmark(size_t vl, double ghz) {
+    const int repeats = 200;
+    const size_t n = BENCH_BYTES / 4;
+    float *fa = malloc(BENCH_BYTES), *fb = malloc(BENCH_BYTES), *fr = malloc(BENCH_BYTES);
+    int8_t *ia = malloc(BENCH_BYTES), *ib = malloc(BENCH_BYTES);
+    uint32_t *a = malloc(4 * 8 * BENCH_COUNT), *b = malloc(4 * 8 * BENCH_COUNT), *r = malloc(4 * 16 * BENCH_COUNT);
+    for (size_t i = 0; i < n; i++) {
+        fa[i] = (float)i;
+        fb[i] = 1.0f;
+    }
+    for (size_t i = 0; i < BENCH_BYTES; i++) {
+        ia[i] = (int8_t)rand();
+        ib[i] = (int8_t)rand();
+    }
+    for (size_t i = 0; i < 8 * BENCH_COUNT; i++) {
+        a[i] = rand32();
+        b[i] = rand32();
+    }
+
+    printf("\nBest of %d; %d KB per input stream (vadd/dot), %d products per call (mul)\n",
+           repeats, BENCH_BYTES >> 10, BENCH_COUNT);
+    printf("%-16s %12s", "kernel", "rate");
+    if (ghz > 0) {
+        printf(" %16s %16s", "cycles/vector", "model");
+    }
+    printf("\n");
+
+    for (int k = 0; k < 2 + SVE_NMUL; k++) {
+        const struct sve_kernel *s = &sve_kernels[k];
+        struct timespec start, end;
+        double best = 1e30;
+        volatile int32_t sink = 0;
+        for (int t = 0; t < repeats; t++) {
+            clock_gettime(CLOCK_MONOTONIC, &start);
+            if (k == 0) {
+                sve_vadd_f32(fr, fa, fb, n);
+            } else if (k == 1) {
+                sink += sve_dot_s8(ia, ib, BENCH_BYTES);
+            } else {
+                sve_mul_kernels[k - 2](r, a, b, BENCH_COUNT);
+            }
+            clock_gettime(CLOCK_MONOTONIC, &end);
+            if (seconds(start, end) < best) {
+                best = seconds(start, end);
+            }
+        }
+        // passes: BENCH_BYTES per stream over vl-byte vectors, or BENCH_COUNT numbers at vl/8 per vector
+        double vectors = s->limbs ? (double)BENCH_COUNT / (vl / 8) : (double)BENCH_BYTES / vl;
+        if (s->limbs) {
+            printf("%-16s %9.2f ns", s->name, best / BENCH_COUNT * 1e9);
+        } else {
+            printf("%-16s %7.2f GB/s", s->name, 2.0 * BENCH_BYTES / best * 1e-9);
+        }
+        if (ghz > 0) {
+            printf(" %16.2f %16.2f", best * ghz * 1e9 / vectors, s->model_cycles);
+        }
+        printf("\n");
+    }
+    free(fa);
+    free(fb);
+    free(fr);
+    free(ia);
+    free(ib);
+    free(a);
+    free(b);
+    free(r);
+}
+
+int main(int argc, char **argv) {
+    printf("SVE Kernel Test Suite\n");
+    printf("=====================\n");
+
+    // usage: test_sve [ghz [vector bits...]]; by default every length from 128 to 2048 bits
+    double ghz = argc > 1 ? atof(argv[1]) : 0;
+    int bits[16], nbits = 0;
+    for (int i = 2; i < argc && nbits < 16; i++) {
+        bits[nbits++] = atoi(argv[i]);
+    }
+    if (nbits == 0) {
+        for (int b = 128; b <= 2048; b += 128) {
+            bits[nbits++] = b;
+        }
+    }
+    srand((unsigned int)time(NULL));
+
+    int lengths = 0;
+    for (int i = 0; i < nbits; i++) {
+        // the kernel picks the largest supported length not above the request
+        int vl = prctl(PR_SVE_SET_VL, bits[i] / 8);
+        if (vl < 0) {
+            printf("prctl(PR_SVE_SET_VL) failed: no SVE, or a kernel without SVE support\n");
+            return 1;
+        }
+        if ((vl & PR_SVE_VL_LEN_MASK) != bits[i] / 8) {
+            continue;
+        }
+        size_t bytes = sve_vector_bytes();
+        printf("\n========================================\n");
+        printf("Vector length %d bits (RDVL: %zu bytes)\n", bits[i], bytes);
+        printf("========================================\n");
+        total_tests++;
+        passed_tests += bytes == (size_t)bits[i] / 8;
+        run_tests(bytes);
+        run_benchmark(bytes, ghz);
+        lengths++;
+    }
+    if (lengths == 0) {
+        printf("None of the requested vector lengths is supported\n");
+        return 1;
+    }
+
+    printf("\n=== Final Test Summary ===\n");
+    printf("Vector lengths:  %d\n", lengths);
+    printf("Total tests run: %d\n", total_tests);
+    printf("Tests passed:    %d\n", passed_tests);
+    printf("Tests failed:    %d\n", total_tests - passed_tests);
+    printf("Success rate:    %.2f%%\n", (double)passed_tests / total_tests * 100.0);
+
+    if (passed_tests == total_tests) {
+        printf("🎉 ALL TESTS PASSED! 🎉\n");
+        return 0;
+    } else {
+        printf("❌ SOME TESTS FAILED ❌\n");
+        return 1;
+    }
+}